@@ -0,0 +1,479 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "TileMap.h"
+#include "RenderThread.h"
+#include "CircuitPuzzle.h"
+#include "CircuitSystem.h"
+#include "DialogueSystem.h"
+#include "JobSystem.h"
+#include "LogicNetlist.h"
+#include "VFX.h"
+
+// Microbenchmarks dos subsistemas do jogo. Rodar a partir de src/ (usa assets/):
+//
+//   cd src && ../build/circuit_bench [--filter=texto] [--min-time=segundos] [--out=arquivo.json]
+//
+// Cada caso repete o corpo até somar --min-time de medição (padrão 0.5 s) e reporta
+// média, mediana, mínimo e desvio por iteração em JSON (stdout ou --out).
+
+struct BenchResult {
+    std::string name;
+    std::string param;
+    int iterations;
+    double meanNs;
+    double medianNs;
+    double minNs;
+    double stddevNs;
+    double itemsPerSecond;
+};
+
+class BenchRunner {
+public:
+    BenchRunner() : minTime(0.5), frequency((double)SDL_GetPerformanceFrequency()) {}
+
+    double minTime;
+    std::string filter;
+
+    // body é cronometrado; reset (opcional) roda fora da medição antes de cada iteração.
+    // items: unidades processadas por iteração, para itens/s
+    void Run(const std::string& name, const std::string& param, long long items,
+             const std::function<void()>& body, const std::function<void()>& reset = nullptr) {
+        std::string fullName = name + "/" + param;
+        if (!filter.empty() && fullName.find(filter) == std::string::npos) return;
+
+        if (reset) reset();
+        body(); // Aquecimento (caches, alocações do primeiro uso)
+
+        std::vector<double> samples;
+        double total = 0.0;
+        while (total < minTime || samples.size() < 5) {
+            if (reset) reset();
+            Uint64 start = SDL_GetPerformanceCounter();
+            body();
+            double seconds = (SDL_GetPerformanceCounter() - start) / frequency;
+            samples.push_back(seconds * 1e9);
+            total += seconds;
+        }
+
+        BenchResult r;
+        r.name = name;
+        r.param = param;
+        r.iterations = (int)samples.size();
+        double sum = 0.0;
+        for (double s : samples) sum += s;
+        r.meanNs = sum / samples.size();
+        double var = 0.0;
+        for (double s : samples) var += (s - r.meanNs) * (s - r.meanNs);
+        r.stddevNs = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+        std::sort(samples.begin(), samples.end());
+        r.medianNs = samples[samples.size() / 2];
+        r.minNs = samples.front();
+        r.itemsPerSecond = r.medianNs > 0.0 ? items * 1e9 / r.medianNs : 0.0;
+        results.push_back(r);
+
+        std::fprintf(stderr, "%-28s %-14s %8d it  median %12.0f ns  min %12.0f ns\n",
+                     name.c_str(), param.c_str(), r.iterations, r.medianNs, r.minNs);
+    }
+
+    void WriteJSON(FILE* out) const {
+        SDL_version sdl;
+        SDL_GetVersion(&sdl);
+        std::fprintf(out, "{\n  \"context\": {\"sdl\": \"%d.%d.%d\", \"min_time_s\": %g},\n  \"benchmarks\": [\n",
+                     sdl.major, sdl.minor, sdl.patch, minTime);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            std::fprintf(out, "    {\"name\": \"%s\", \"param\": \"%s\", \"iterations\": %d, \"mean_ns\": %.1f, "
+                              "\"median_ns\": %.1f, \"min_ns\": %.1f, \"stddev_ns\": %.1f, \"items_per_second\": %.1f}%s\n",
+                         r.name.c_str(), r.param.c_str(), r.iterations, r.meanNs, r.medianNs, r.minNs,
+                         r.stddevNs, r.itemsPerSecond, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+
+private:
+    double frequency;
+    std::vector<BenchResult> results;
+};
+
+// Gerador fixo: as mesmas consultas e layouts em toda execução
+static Uint32 benchRng = 12345;
+static int BenchRandom(int range) {
+    benchRng = benchRng * 1664525u + 1013904223u;
+    return (int)((benchRng >> 8) % (Uint32)range);
+}
+
+static std::string SizeParam(int w, int h) {
+    return std::to_string(w) + "x" + std::to_string(h);
+}
+
+// Mapa sintético no formato de assets/map1.csv: bordas sólidas (16), piso variado por dentro
+static bool WriteSyntheticMap(const std::string& filename, int w, int h) {
+    FILE* f = std::fopen(filename.c_str(), "w");
+    if (!f) return false;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            bool border = x == 0 || y == 0 || x == w - 1 || y == h - 1;
+            std::fprintf(f, x + 1 < w ? "%d," : "%d\n", border ? 16 : BenchRandom(4));
+        }
+    }
+    std::fclose(f);
+    return true;
+}
+
+static TileMap MakeFloorMap(int w, int h) {
+    TileMap map(w, h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) map.SetTile(x, y, BenchRandom(4), false);
+    }
+    return map;
+}
+
+static void BenchTileMap(BenchRunner& runner) {
+    runner.Run("TileMap::LoadFromFile", "map1.csv", 1, [] {
+        TileMap map;
+        map.LoadFromFile("assets/map1.csv");
+    });
+
+    const int sizes[] = {64, 256, 1024};
+    for (int size : sizes) {
+        std::string file = "bench_map_" + std::to_string(size) + ".csv";
+        if (!WriteSyntheticMap(file, size, size)) continue;
+        runner.Run("TileMap::LoadFromFile", SizeParam(size, size), (long long)size * size, [&file] {
+            TileMap map;
+            map.LoadFromFile(file);
+        });
+        std::remove(file.c_str());
+    }
+
+    // Render por software num alvo do tamanho da janela do jogo (192x160 * 3)
+    const int viewW = 576, viewH = 480, scale = 3;
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, viewW, viewH, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        std::cerr << "Warning: Software renderer unavailable: " << SDL_GetError() << "\n";
+        if (target) SDL_FreeSurface(target);
+        return;
+    }
+    SDL_Texture* tileset = nullptr;
+    SDL_Surface* tileSurface = IMG_Load("assets/tileset_circuit.png");
+    if (tileSurface) {
+        tileset = SDL_CreateTextureFromSurface(renderer, tileSurface);
+        SDL_FreeSurface(tileSurface);
+    } else {
+        tileset = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 256, 256);
+    }
+
+    // Gravação na RenderList + execução no renderer, como a thread de render faz a cada quadro
+    RenderThread executor;
+    executor.Initialize(nullptr, renderer, RenderThreadMode::OFF);
+    RenderList list;
+
+    const int renderSizes[] = {24, 256, 1024};
+    for (int size : renderSizes) {
+        TileMap map = MakeFloorMap(size, size);
+        map.SetTilesetTexture(tileset);
+        // Câmera no meio do mapa (ou na origem, se o mapa for menor que a tela)
+        int camX = std::max(0, size * 32 * scale / 2 - viewW / 2);
+        int camY = std::max(0, size * 32 * scale / 2 - viewH / 2);
+        int visibleTiles = (viewW / (32 * scale) + 1) * (viewH / (32 * scale) + 1);
+        runner.Run("TileMap::Render", SizeParam(size, size), visibleTiles, [&] {
+            list.Reset(viewW, viewH);
+            map.Render(list, camX, camY, scale);
+            executor.Execute(list);
+        });
+    }
+
+    executor.Shutdown();
+    if (tileset) SDL_DestroyTexture(tileset);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+}
+
+// Pool compartilhado pelos casos "/jobs" (uma thread por núcleo, como o jogo com --jobs=0)
+static JobSystem& BenchJobs() {
+    static JobSystem jobs;
+    static bool initialized = jobs.Initialize(0);
+    (void)initialized;
+    return jobs;
+}
+
+static void BenchPuzzleValidate(BenchRunner& runner) {
+    // Pior caso do BFS: serpentina de fios cobrindo o tabuleiro, bateria no início, resistor e LED no caminho
+    const int sizes[][2] = {{7, 5}, {64, 64}, {256, 256}, {1024, 1024}};
+    for (const auto& size : sizes) {
+        int w = size[0], h = size[1];
+        CircuitPuzzle puzzle;
+        puzzle.LoadEmptyGrid(w, h);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 1; x < w - 1; ++x) puzzle.PlaceFixedComponent(x, y, ComponentType::WIRE);
+            // Curvas nas pontas: linhas pares descem pela direita, ímpares pela esquerda
+            bool even = y % 2 == 0;
+            puzzle.PlaceFixedComponent(0, y, ComponentType::WIRE_CORNER, even ? 0 : 90);
+            puzzle.PlaceFixedComponent(w - 1, y, ComponentType::WIRE_CORNER, even ? 180 : 270);
+        }
+        puzzle.PlaceFixedComponent(0, 0, ComponentType::BATTERY);
+        puzzle.PlaceFixedComponent(w / 3, h / 2, ComponentType::RESISTOR);
+        puzzle.PlaceFixedComponent(2 * w / 3, h / 2, ComponentType::LED);
+        if (puzzle.Validate() != PuzzleResult::CORRECT) {
+            std::cerr << "Warning: Validate layout " << SizeParam(w, h) << " is not a closed circuit\n";
+        }
+        runner.Run("CircuitPuzzle::Validate", SizeParam(w, h), (long long)w * h, [&puzzle] {
+            puzzle.Validate();
+        });
+        if (w * h < 256 * 256) continue;
+        puzzle.SetJobSystem(&BenchJobs());
+        runner.Run("CircuitPuzzle::Validate", SizeParam(w, h) + "/jobs", (long long)w * h, [&puzzle] {
+            puzzle.Validate();
+        });
+    }
+}
+
+static void BenchPuzzleRender(BenchRunner& runner) {
+    // Tabuleiros cheios de fios vistos na janela do jogo em três zooms: 48 px (desenho detalhado),
+    // 12 px (blocos) e 2 px (textura LOD). Só o que cai no viewport deveria custar
+    const int screenW = 576, screenH = 480;
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, screenW, screenH, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        std::cerr << "Warning: Software renderer unavailable: " << SDL_GetError() << "\n";
+        if (target) SDL_FreeSurface(target);
+        return;
+    }
+    RenderThread executor;
+    executor.Initialize(nullptr, renderer, RenderThreadMode::OFF);
+    RenderList list;
+
+    // Zoom como o jogador faz: teclas '-' a partir do zoom inicial (48 px)
+    struct ZoomCase { const char* name; int cellSize; int zoomOutPresses; };
+    const ZoomCase zooms[] = {{"48px", 48, 0}, {"12px", 12, 4}, {"2px", 2, 7}};
+    const int sizes[] = {7, 256, 1024};
+    for (int size : sizes) {
+        int w = size, h = size == 7 ? 5 : size;
+        for (const ZoomCase& zoom : zooms) {
+            CircuitPuzzle puzzle;
+            puzzle.LoadEmptyGrid(w, h);
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) puzzle.PlaceFixedComponent(x, y, ComponentType::WIRE, (x + y) % 2 * 90);
+            }
+            puzzle.PlaceFixedComponent(0, h / 2, ComponentType::BATTERY);
+            puzzle.PlaceFixedComponent(w / 2, h / 2, ComponentType::LED);
+            puzzle.Activate();
+            for (int i = 0; i < zoom.zoomOutPresses; ++i) {
+                SDL_Event event = {};
+                event.type = SDL_KEYDOWN;
+                event.key.keysym.sym = SDLK_MINUS;
+                puzzle.HandleInput(event);
+            }
+            int visibleCells = std::min(w, (screenW - 80) / zoom.cellSize + 1) *
+                               std::min(h, (screenH - 240) / zoom.cellSize + 1);
+            runner.Run("CircuitPuzzle::Render", SizeParam(w, h) + "/" + zoom.name, visibleCells, [&] {
+                list.Reset(screenW, screenH);
+                puzzle.Render(list, screenW, screenH);
+                executor.Execute(list);
+            });
+            puzzle.Shutdown(); // Destrói a textura LOD enquanto o renderer existe
+        }
+    }
+
+    executor.Shutdown();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+}
+
+static void BenchCircuitSystem(BenchRunner& runner) {
+    // Grupos de 3 elementos: switch (net 2g) -> AND (net 2g+1, entradas {2g, 2g-1}) -> porta.
+    // A cadeia de ANDs faz o toggle do primeiro switch atravessar o circuito inteiro
+    const int counts[] = {300, 3000, 30000, 300000};
+    for (int count : counts) {
+        int groups = count / 3;
+        int side = (int)std::ceil(std::sqrt((double)count)) + 2;
+        TileMap map = MakeFloorMap(side, side);
+        CircuitSystem circuits;
+        circuits.Initialize(nullptr);
+        circuits.SetTileMap(&map);
+
+        std::vector<CircuitElement> batch;
+        batch.reserve(groups * 3);
+        int cell = 0;
+        auto place = [&](CircuitType type, int net, std::vector<int> inputs) {
+            CircuitElement el;
+            el.type = type;
+            el.id = net;
+            el.gridX = 1 + cell % (side - 2);
+            el.gridY = 1 + cell / (side - 2);
+            el.isActive = false;
+            el.inputs = std::move(inputs);
+            el.delayTicks = 0;
+            batch.push_back(std::move(el));
+            ++cell;
+        };
+        for (int g = 0; g < groups; ++g) {
+            place(CircuitType::SWITCH, 2 * g, {});
+            place(CircuitType::AND_GATE, 2 * g + 1, g == 0 ? std::vector<int>{0} : std::vector<int>{2 * g, 2 * g - 1});
+            place(CircuitType::DOOR, 2 * g + 1, {});
+        }
+        circuits.AddElements(batch);
+        circuits.Update(); // Compila o netlist
+
+        std::string param = std::to_string(groups * 3);
+        runner.Run("CircuitSystem::Update", param + "/idle", groups * 3, [&circuits] {
+            circuits.Update();
+        });
+        runner.Run("CircuitSystem::Update", param + "/toggle", groups * 3, [&circuits] {
+            circuits.ToggleSwitches(0);
+            circuits.Update();
+        });
+
+        const int queries = 4096;
+        std::vector<SDL_Point> cells(queries);
+        for (auto& p : cells) p = {BenchRandom(side), BenchRandom(side)};
+        int solid = 0;
+        runner.Run("CircuitSystem::IsSolid", param, queries, [&] {
+            for (const SDL_Point& p : cells) solid += circuits.IsSolid(p.x, p.y) ? 1 : 0;
+        });
+        if (solid < 0) std::cerr << solid; // Mantém o laço vivo para o otimizador
+        circuits.Shutdown();
+    }
+}
+
+// Não é medição: o repositório não tem testes, então as checagens de comportamento que os
+// benchmarks dependem ficam aqui. switch->DELAY(n) e switch->AND->DELAY(n) têm que acender
+// no mesmo tick (a entrada só vale depois da captura de estado, como a saída da porta)
+static bool CheckDelayTiming() {
+    bool ok = true;
+    for (int delay = 1; delay <= 4; ++delay) {
+        LogicNetlist netlist;
+        int input = netlist.AddNode();
+        int gate = netlist.AddNode();
+        int direct = netlist.AddNode();
+        int gated = netlist.AddNode();
+        netlist.Define(input, LogicNetlist::Op::INPUT, {});
+        netlist.Define(gate, LogicNetlist::Op::AND, {input, input});
+        netlist.Define(direct, LogicNetlist::Op::DELAY, {input}, delay);
+        netlist.Define(gated, LogicNetlist::Op::DELAY, {gate}, delay);
+        netlist.Compile();
+        netlist.Tick();
+
+        netlist.SetInput(input, true);
+        int directTick = -1, gatedTick = -1;
+        for (int tick = 1; tick <= delay + 2; ++tick) {
+            netlist.Tick();
+            if (directTick < 0 && netlist.Get(direct)) directTick = tick;
+            if (gatedTick < 0 && netlist.Get(gated)) gatedTick = tick;
+        }
+        if (directTick != gatedTick || directTick != delay + 1) {
+            std::cerr << "Warning: DELAY(" << delay << ") lit at tick " << directTick << " from a switch and "
+                      << gatedTick << " through AND (expected " << delay + 1 << ")\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void BenchVFX(BenchRunner& runner) {
+    // A fumaça vive de 0.8 a 1.4 s: recria o sistema antes de 40 ticks para medir só a integração
+    const int counts[] = {10000, 100000, 1000000};
+    const float dt = 1.0f / 60.0f;
+    for (int count : counts) {
+        for (bool parallel : {false, true}) {
+            VFX vfx;
+            int ticks = 0;
+            auto reset = [&] {
+                if (ticks > 0 && ticks < 40) return;
+                vfx = VFX();
+                vfx.Seed(1);
+                vfx.SetJobSystem(parallel ? &BenchJobs() : nullptr);
+                vfx.TriggerSmoke(1000, 1000, count);
+                ticks = 0;
+            };
+            runner.Run("VFX::Update", std::to_string(count) + (parallel ? "/jobs" : ""), count, [&] {
+                vfx.Update(dt);
+                ++ticks;
+            }, reset);
+        }
+    }
+
+    // Ciclo completo de 10k partículas, incluindo a remoção das que morrem
+    runner.Run("VFX::Update", "10000/lifetime", 10000, [dt] {
+        VFX vfx;
+        vfx.Seed(1);
+        vfx.TriggerSmoke(1000, 1000, 10000);
+        for (int i = 0; i < 90; ++i) vfx.Update(dt);
+    });
+}
+
+static void BenchDialogueLayout(BenchRunner& runner) {
+    if (TTF_Init() == -1) {
+        std::cerr << "Warning: SDL_ttf unavailable, skipping dialogue layout: " << TTF_GetError() << "\n";
+        return;
+    }
+    TTF_Font* font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 8); // Mesma fonte do DialogueSystem
+    if (!font) {
+        std::cerr << "Warning: Could not load dialogue font: " << TTF_GetError() << "\n";
+        TTF_Quit();
+        return;
+    }
+
+    const std::string sentence = "Ola Berta! Conecte a bateria ao LED com um resistor antes de fechar o circuito. ";
+    const int repeats[] = {1, 10, 100};
+    const int maxWidth = 576 - 40 - 115; // Caixa de diálogo com retrato
+    std::vector<std::string> lines;
+    for (int n : repeats) {
+        std::string text;
+        for (int i = 0; i < n; ++i) text += sentence;
+        runner.Run("DialogueSystem::WrapText", std::to_string(text.size()) + "ch", (long long)text.size(), [&] {
+            DialogueSystem::WrapText(font, text, maxWidth, lines);
+        });
+    }
+
+    TTF_CloseFont(font);
+    TTF_Quit();
+}
+
+int main(int argc, char* argv[]) {
+    BenchRunner runner;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) runner.filter = arg.substr(9);
+        else if (arg.rfind("--min-time=", 0) == 0) runner.minTime = std::atof(arg.c_str() + 11);
+        else if (arg.rfind("--out=", 0) == 0) outFile = arg.substr(6);
+        else std::cerr << "Warning: Unknown argument " << arg << "\n";
+    }
+
+    if (SDL_Init(0) != 0) {
+        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    // Sem saída do jogo no meio da tabela (warnings continuam no stderr)
+    std::cout.setstate(std::ios::failbit);
+
+    bool checksOk = CheckDelayTiming();
+    BenchTileMap(runner);
+    BenchPuzzleValidate(runner);
+    BenchPuzzleRender(runner);
+    BenchCircuitSystem(runner);
+    BenchVFX(runner);
+    BenchDialogueLayout(runner);
+
+    std::cout.clear();
+    FILE* out = outFile.empty() ? stdout : std::fopen(outFile.c_str(), "w");
+    if (!out) {
+        std::cerr << "Warning: Could not open " << outFile << ", writing to stdout\n";
+        out = stdout;
+    }
+    runner.WriteJSON(out);
+    if (out != stdout) std::fclose(out);
+
+    SDL_Quit();
+    return checksOk ? 0 : 1;
+}
@@ -6,17 +6,19 @@
 #include <set>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include "RenderList.h"
 
 class AchievementSystem {
 public:
     AchievementSystem();
     ~AchievementSystem();
 
-    bool Initialize(SDL_Renderer* renderer);
+    bool Initialize();
+    void SetFonts(TTF_Font* title, TTF_Font* desc) { titleFont = title; descFont = desc; } // Do AssetLoader
     void Shutdown();
 
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer, int screenW, int screenH);
+    void Render(RenderList& list, int screenW, int screenH);
 
     // Retorna true se a conquista foi destravada neste momento
     bool Unlock(const std::string& id, const std::string& title, const std::string& description);
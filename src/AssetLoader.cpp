@@ -0,0 +1,389 @@
+#include "AssetLoader.h"
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "AssetPack.h"
+#include "Trace.h"
+
+// O SDL_mixer guarda estado global dos decodificadores: uma carga de áudio por vez
+static std::mutex& MixerMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Fontes e músicas ficam como o arquivo (lido aos poucos): o tamanho dele é a estimativa do residente
+static size_t FileBytes(const char* path) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return 0;
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    return size > 0 ? (size_t)size : 0;
+}
+
+AssetLoader::AssetLoader()
+    : busyWorkers(0), quit(false), pack(nullptr), audioEnabled(true), frame(0), residentBytes(0) {}
+
+AssetLoader::~AssetLoader() {
+    Shutdown();
+}
+
+void AssetLoader::SetAudioEnabled(bool enabled) {
+    audioEnabled = enabled;
+}
+
+void AssetLoader::SetPack(const AssetPack* assetPack) {
+    pack = assetPack;
+}
+
+void AssetLoader::Start(int threads) {
+    quit = false;
+    int queuedCount = (int)queue.size(); // Antes das threads: depois disso a fila só com o mutex
+    int packedCount = 0;
+    for (Asset* asset : queue) {
+        if (pack && pack->Find(asset->desc)) packedCount++;
+    }
+    for (int i = 0; i < threads; ++i) workers.emplace_back(&AssetLoader::WorkerMain, this);
+    std::cout << "[ASSETS] Loading " << queuedCount << " assets on " << threads << " threads";
+    if (pack) std::cout << " (" << packedCount << " from the pack)";
+    std::cout << "\n";
+}
+
+AssetRef AssetLoader::Acquire(const AssetDesc& desc, const char* owner) {
+    AssetRef ref;
+    ref.kind = desc.kind;
+    ref.id = AcquireId(desc, owner);
+    return ref;
+}
+
+void AssetLoader::Release(AssetRef& ref, const char* owner) {
+    ReleaseId(ref.id, owner);
+    ref.id = -1;
+}
+
+TextureHandle AssetLoader::AcquireTexture(const char* path, const char* owner, bool colorKeyWhite) {
+    return TextureHandle{AcquireId({AssetKind::IMAGE, path, 0, colorKeyWhite}, owner)};
+}
+
+SoundHandle AssetLoader::AcquireSound(const char* path, const char* owner) {
+    return SoundHandle{AcquireId({AssetKind::SOUND, path, 0, false}, owner)};
+}
+
+MusicHandle AssetLoader::AcquireMusic(const char* path, const char* owner) {
+    return MusicHandle{AcquireId({AssetKind::MUSIC, path, 0, false}, owner)};
+}
+
+FontHandle AssetLoader::AcquireFont(const char* path, int size, const char* owner) {
+    return FontHandle{AcquireId({AssetKind::FONT, path, size, false}, owner)};
+}
+
+int AssetLoader::AcquireId(const AssetDesc& desc, const char* owner) {
+    int id = -1;
+    for (int i = 0; i < (int)assets.size() && id < 0; ++i) {
+        const AssetDesc& other = assets[i]->desc;
+        if (other.kind == desc.kind && other.fontSize == desc.fontSize &&
+            other.colorKeyWhite == desc.colorKeyWhite && assets[i]->path == desc.path) id = i;
+    }
+    if (id < 0) {
+        std::unique_ptr<Asset> asset(new Asset());
+        asset->path = desc.path;
+        asset->desc = desc;
+        asset->desc.path = asset->path.c_str();
+        assets.push_back(std::move(asset));
+        id = (int)assets.size() - 1;
+    }
+
+    Asset& asset = *assets[id];
+    asset.refCount++;
+    bool found = false;
+    for (AssetOwner& entry : asset.owners) {
+        if (std::strcmp(entry.name, owner) == 0) {
+            entry.refs++;
+            found = true;
+        }
+    }
+    if (!found) asset.owners.push_back({owner, 1});
+
+    if (asset.state == State::UNLOADED) {
+        bool audio = desc.kind == AssetKind::SOUND || desc.kind == AssetKind::MUSIC;
+        if (audio && !audioEnabled) {
+            asset.state = State::FAILED; // Sem dispositivo de áudio (headless): conta como carregado, sem objeto
+        } else {
+            asset.state = State::QUEUED;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queue.push_back(&asset);
+            }
+            queueWake.notify_one();
+        }
+    }
+    return id;
+}
+
+void AssetLoader::ReleaseId(int id, const char* owner) {
+    if (id < 0 || id >= (int)assets.size()) return;
+    Asset& asset = *assets[id];
+    for (size_t i = 0; i < asset.owners.size(); ++i) {
+        if (std::strcmp(asset.owners[i].name, owner) != 0) continue;
+        if (--asset.owners[i].refs == 0) asset.owners.erase(asset.owners.begin() + i);
+        asset.refCount--; // Em zero, o Update descarrega
+        return;
+    }
+    std::cerr << "Warning: " << owner << " released " << asset.path << " without acquiring it\n";
+}
+
+bool AssetLoader::IsLoadedId(int id) const {
+    if (id < 0 || id >= (int)assets.size()) return false;
+    State state = assets[id]->state.load(std::memory_order_acquire);
+    return state == State::READY || state == State::FAILED;
+}
+
+void AssetLoader::WorkerMain() {
+    TRACE_THREAD_NAME("AssetLoader");
+    while (true) {
+        Asset* asset = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueWake.wait(lock, [this] { return quit || !queue.empty(); });
+            if (quit) break;
+            asset = queue.front();
+            queue.pop_front();
+            busyWorkers++;
+        }
+        Decode(*asset);
+        asset->state.store(State::DECODED, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            busyWorkers--;
+            if (queue.empty() && busyWorkers == 0) queueIdle.notify_all();
+        }
+    }
+}
+
+void AssetLoader::Decode(Asset& asset) {
+    TRACE_ZONE("AssetLoader::Decode");
+    const AssetDesc& desc = asset.desc;
+    const AssetPackEntry* entry = pack ? pack->Find(desc) : nullptr;
+    if (entry && DecodePacked(asset, *entry)) return;
+    switch (desc.kind) {
+        case AssetKind::IMAGE: {
+            SDL_Surface* surface = IMG_Load(desc.path);
+            if (!surface) {
+                asset.error = IMG_GetError();
+                return;
+            }
+            if (desc.colorKeyWhite) SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 255, 255));
+            // Já no formato da textura (color key vira alfa aqui): o upload é só uma cópia
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (converted) {
+                SDL_FreeSurface(surface);
+                surface = converted;
+            }
+            asset.surface = surface;
+            asset.bytes = (size_t)surface->w * surface->h * 4;
+            break;
+        }
+        case AssetKind::SOUND: {
+            std::lock_guard<std::mutex> lock(MixerMutex());
+            asset.sound = Mix_LoadWAV(desc.path);
+            if (!asset.sound) asset.error = Mix_GetError();
+            else asset.bytes = asset.sound->alen;
+            break;
+        }
+        case AssetKind::MUSIC: {
+            std::lock_guard<std::mutex> lock(MixerMutex());
+            asset.music = Mix_LoadMUS(desc.path);
+            if (!asset.music) asset.error = Mix_GetError();
+            else asset.bytes = FileBytes(desc.path);
+            break;
+        }
+        case AssetKind::FONT: {
+            std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+            asset.font = TTF_OpenFont(desc.path, desc.fontSize);
+            if (!asset.font) asset.error = TTF_GetError();
+            else asset.bytes = FileBytes(desc.path);
+            break;
+        }
+    }
+}
+
+bool AssetLoader::DecodePacked(Asset& asset, const AssetPackEntry& entry) {
+    const AssetDesc& desc = asset.desc;
+    const Uint8* bytes = pack->GetData(entry);
+    switch (desc.kind) {
+        case AssetKind::IMAGE:
+            asset.packed = &entry; // Update grava o upload direto do mapeamento
+            break;
+        case AssetKind::SOUND: {
+            std::lock_guard<std::mutex> lock(MixerMutex());
+            int frequency = 0;
+            Uint16 format = 0;
+            int channels = 0;
+            // O dispositivo pode ter aberto em outro formato: aí o PCM do pacote não serve
+            if (!Mix_QuerySpec(&frequency, &format, &channels) || frequency != (int)entry.frequency ||
+                format != entry.format || channels != (int)entry.channels) return false;
+            asset.sound = Mix_QuickLoad_RAW((Uint8*)bytes, entry.size); // Sem cópia; o Mix_FreeChunk não libera os bytes
+            if (!asset.sound) asset.error = Mix_GetError();
+            break;
+        }
+        case AssetKind::MUSIC: {
+            std::lock_guard<std::mutex> lock(MixerMutex());
+            asset.music = Mix_LoadMUS_RW(SDL_RWFromConstMem(bytes, (int)entry.size), 1);
+            if (!asset.music) asset.error = Mix_GetError();
+            break;
+        }
+        case AssetKind::FONT: {
+            std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+            asset.font = TTF_OpenFontRW(SDL_RWFromConstMem(bytes, (int)entry.size), 1, desc.fontSize);
+            if (!asset.font) asset.error = TTF_GetError();
+            break;
+        }
+    }
+    // Pixels e PCM do pacote são páginas do mapeamento, mas contam como residentes enquanto em uso
+    asset.bytes = desc.kind == AssetKind::IMAGE ? (size_t)entry.pitch * entry.height : entry.size;
+    return true;
+}
+
+void AssetLoader::Wait() {
+    if (workers.empty()) return;
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueIdle.wait(lock, [this] { return queue.empty() && busyWorkers == 0; });
+}
+
+void AssetLoader::Update(RenderList& list) {
+    ++frame;
+    for (std::unique_ptr<Asset>& entry : assets) {
+        Asset& asset = *entry;
+        State state = asset.state.load(std::memory_order_acquire);
+        if (state == State::DECODED) {
+            if (asset.refCount == 0) {
+                Unload(asset, &list); // Soltaram antes de chegar
+            } else if (!asset.error.empty()) {
+                std::cerr << "Warning: Could not load " << asset.path << ": " << asset.error << "\n";
+                asset.state = State::FAILED;
+            } else if (asset.desc.kind == AssetKind::IMAGE) {
+                if (asset.packed) {
+                    const AssetPackEntry& packed = *asset.packed;
+                    list.CreateTexture(pack->GetData(packed), (int)packed.width, (int)packed.height, (int)packed.pitch,
+                                       &asset.texture);
+                } else {
+                    list.CreateTexture(asset.surface, &asset.texture); // A thread de render libera a superfície
+                    asset.surface = nullptr;
+                }
+                asset.uploadFrame = frame;
+                asset.state = State::UPLOADING;
+            } else {
+                asset.state = State::READY;
+                residentBytes += asset.bytes;
+            }
+        } else if (state == State::UPLOADING && frame - asset.uploadFrame >= 2) {
+            // A lista do quadro N terminou quando o Submit do N+1 retornou: no quadro N+2 o ponteiro é válido
+            if (asset.texture) {
+                asset.state = State::READY;
+                residentBytes += asset.bytes;
+            } else {
+                std::cerr << "Warning: Could not create texture for " << asset.path << "\n";
+                asset.state = State::FAILED;
+            }
+        } else if (state == State::READY && asset.refCount == 0) {
+            residentBytes -= asset.bytes;
+            Unload(asset, &list);
+        }
+    }
+}
+
+void AssetLoader::Unload(Asset& asset, RenderList* list) {
+    if (asset.surface) SDL_FreeSurface(asset.surface);
+    if (asset.texture) {
+        // A lista do quadro anterior ainda pode desenhar com ela: destruída depois, na ordem da lista
+        if (list) list->DestroyTexture(asset.texture);
+        else SDL_DestroyTexture(asset.texture);
+    }
+    if (asset.sound || asset.music) {
+        std::lock_guard<std::mutex> lock(MixerMutex());
+        if (asset.sound) Mix_FreeChunk(asset.sound);
+        if (asset.music) Mix_FreeMusic(asset.music);
+    }
+    if (asset.font) {
+        if (list) {
+            list->CloseFont(asset.font);
+        } else {
+            std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+            TTF_CloseFont(asset.font);
+        }
+    }
+    asset.surface = nullptr;
+    asset.packed = nullptr;
+    asset.texture = nullptr;
+    asset.sound = nullptr;
+    asset.music = nullptr;
+    asset.font = nullptr;
+    asset.error.clear();
+    asset.bytes = 0;
+    asset.state = State::UNLOADED;
+}
+
+void AssetLoader::LogResidency() const {
+    struct OwnerBytes {
+        const char* name;
+        size_t bytes;
+        int assets;
+    };
+    std::vector<OwnerBytes> owners;
+    int resident = 0;
+    char line[256];
+    std::cout << "[ASSETS] Resident assets:\n";
+    for (const std::unique_ptr<Asset>& entry : assets) {
+        const Asset& asset = *entry;
+        if (asset.state != State::READY) continue;
+        resident++;
+        std::string name = asset.path;
+        if (asset.desc.kind == AssetKind::FONT) name += "@" + std::to_string(asset.desc.fontSize);
+        std::string ownerList;
+        for (const AssetOwner& owner : asset.owners) {
+            ownerList += " ";
+            ownerList += owner.name;
+            if (owner.refs > 1) ownerList += " x" + std::to_string(owner.refs);
+            bool found = false;
+            for (OwnerBytes& total : owners) {
+                if (std::strcmp(total.name, owner.name) != 0) continue;
+                total.bytes += asset.bytes;
+                total.assets++;
+                found = true;
+            }
+            if (!found) owners.push_back({owner.name, asset.bytes, 1});
+        }
+        std::snprintf(line, sizeof(line), "[ASSETS]   %-40s %7zu KB  refs %d:%s\n",
+                      name.c_str(), asset.bytes / 1024, asset.refCount, ownerList.c_str());
+        std::cout << line;
+    }
+    std::cout << "[ASSETS] " << resident << " assets, " << residentBytes / 1024 << " KB resident; by owner:\n";
+    for (const OwnerBytes& total : owners) {
+        std::snprintf(line, sizeof(line), "[ASSETS]   %-20s %7zu KB in %d assets\n", total.name, total.bytes / 1024, total.assets);
+        std::cout << line;
+    }
+}
+
+void AssetLoader::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        quit = true;
+        queue.clear();
+    }
+    queueWake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+
+    for (std::unique_ptr<Asset>& entry : assets) {
+        Asset& asset = *entry;
+        if (asset.refCount > 0) {
+            std::cerr << "Warning: " << asset.path << " still acquired at shutdown by";
+            for (const AssetOwner& owner : asset.owners) std::cerr << " " << owner.name;
+            std::cerr << "\n";
+        }
+        Unload(asset, nullptr);
+    }
+    assets.clear();
+    residentBytes = 0;
+}
@@ -0,0 +1,141 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RenderList.h"
+
+class AssetPack;
+struct AssetPackEntry;
+
+enum class AssetKind { IMAGE, SOUND, MUSIC, FONT };
+
+// Identidade de um recurso: dois pedidos com os mesmos campos dividem o mesmo objeto
+struct AssetDesc {
+    AssetKind kind;
+    const char* path;
+    int fontSize;         // FONT
+    bool colorKeyWhite;   // IMAGE: o branco do fundo vira transparente
+};
+
+// Handle tipado: só o Get do tipo certo aceita (uma fonte não passa por textura)
+template <AssetKind K>
+struct AssetHandle {
+    int id = -1;
+    bool IsValid() const { return id >= 0; }
+};
+using TextureHandle = AssetHandle<AssetKind::IMAGE>;
+using SoundHandle = AssetHandle<AssetKind::SOUND>;
+using MusicHandle = AssetHandle<AssetKind::MUSIC>;
+using FontHandle = AssetHandle<AssetKind::FONT>;
+
+// Handle de qualquer tipo, para tabelas de assets; As<K>() devolve um handle inválido se o tipo não bate
+struct AssetRef {
+    AssetKind kind = AssetKind::IMAGE;
+    int id = -1;
+    template <AssetKind K> AssetHandle<K> As() const { return AssetHandle<K>{kind == K ? id : -1}; }
+};
+
+// Dono de todas as texturas, sons, músicas e fontes. Cada Acquire conta uma referência em nome de
+// um subsistema ("owner", literal); pedidos iguais viram um recurso só. A leitura do disco e a
+// decodificação (PNG -> superfície no formato da textura, WAV -> PCM do mixer) rodam nas threads
+// do loader; a thread principal entrega o resultado e grava a criação das texturas na RenderList,
+// executada pela thread de render (dona do renderer). Quando a última referência sai, o recurso é
+// descarregado no Update seguinte (texturas e fontes também pela RenderList).
+class AssetLoader {
+public:
+    AssetLoader();
+    ~AssetLoader();
+
+    void SetAudioEnabled(bool enabled);    // Sem mixer aberto, sons e músicas são pulados
+    void SetPack(const AssetPack* pack);   // Assets do pacote não são decodificados (o pacote vive mais)
+    void Start(int threads);
+    void Wait();                           // Bloqueia até a fila esvaziar (replay: mesmo quadro em toda execução)
+    void Update(RenderList& list);         // Uma vez por quadro, na thread principal
+    void Shutdown();                       // Depois do RenderThread::Shutdown e antes de fechar o mixer
+
+    AssetRef Acquire(const AssetDesc& desc, const char* owner); // Entra na fila (FIFO) se não estiver residente
+    void Release(AssetRef& ref, const char* owner);
+    TextureHandle AcquireTexture(const char* path, const char* owner, bool colorKeyWhite = false);
+    SoundHandle AcquireSound(const char* path, const char* owner);
+    MusicHandle AcquireMusic(const char* path, const char* owner);
+    FontHandle AcquireFont(const char* path, int size, const char* owner);
+    template <AssetKind K> void Release(AssetHandle<K>& handle, const char* owner) {
+        ReleaseId(handle.id, owner);
+        handle.id = -1;
+    }
+
+    bool IsLoaded(const AssetRef& ref) const { return IsLoadedId(ref.id); } // Pronto ou falhou
+    template <AssetKind K> bool IsLoaded(AssetHandle<K> handle) const { return IsLoadedId(handle.id); }
+
+    SDL_Texture* Get(TextureHandle handle) const { return IsUsable(handle.id) ? assets[handle.id]->texture : nullptr; }
+    Mix_Chunk* Get(SoundHandle handle) const { return IsUsable(handle.id) ? assets[handle.id]->sound : nullptr; }
+    Mix_Music* Get(MusicHandle handle) const { return IsUsable(handle.id) ? assets[handle.id]->music : nullptr; }
+    TTF_Font* Get(FontHandle handle) const { return IsUsable(handle.id) ? assets[handle.id]->font : nullptr; }
+
+    size_t GetResidentBytes() const { return residentBytes; }
+    void LogResidency() const; // Bytes por asset e por dono (compartilhados contam para cada dono)
+
+private:
+    enum class State : Uint8 {
+        UNLOADED,   // Sem objeto (nunca pedido ou descarregado)
+        QUEUED,     // Na fila ou numa thread de carga
+        DECODED,    // Pronto na thread de carga, ainda não entregue
+        UPLOADING,  // Criação da textura gravada numa RenderList
+        READY,
+        FAILED
+    };
+    struct AssetOwner {
+        const char* name;
+        int refs;
+    };
+    struct Asset {
+        AssetDesc desc;                  // desc.path aponta para path
+        std::string path;
+        std::atomic<State> state{State::UNLOADED};
+        int refCount = 0;
+        std::vector<AssetOwner> owners;
+        size_t bytes = 0;                // Estimativa do residente (pixels, PCM, arquivo)
+        SDL_Surface* surface = nullptr;  // Decodificado, até a entrega
+        const AssetPackEntry* packed = nullptr; // IMAGE do pacote: pixels prontos no mapeamento
+        SDL_Texture* texture = nullptr;  // Escrito pela thread de render
+        Mix_Chunk* sound = nullptr;
+        Mix_Music* music = nullptr;
+        TTF_Font* font = nullptr;
+        std::string error;
+        Uint32 uploadFrame = 0;
+    };
+
+    int AcquireId(const AssetDesc& desc, const char* owner);
+    void ReleaseId(int id, const char* owner);
+    void WorkerMain();
+    void Decode(Asset& asset);
+    bool DecodePacked(Asset& asset, const AssetPackEntry& entry); // false: formato não serve, usa o solto
+    void Unload(Asset& asset, RenderList* list); // Sem lista: destrói na hora (Shutdown)
+    bool IsLoadedId(int id) const;
+    bool IsUsable(int id) const { return id >= 0 && id < (int)assets.size() && assets[id]->state == State::READY; }
+
+    std::vector<std::unique_ptr<Asset>> assets; // Ids fixos; descarregados continuam aqui para o próximo Acquire
+    std::deque<Asset*> queue;                   // Esperando decodificação (o vetor pode crescer enquanto isso)
+    int busyWorkers;
+    std::mutex queueMutex;
+    std::condition_variable queueWake;
+    std::condition_variable queueIdle;
+    bool quit;
+    std::vector<std::thread> workers;
+    const AssetPack* pack;
+    bool audioEnabled;
+    Uint32 frame;
+    size_t residentBytes;
+};
+
+#endif // ASSET_LOADER_H
@@ -0,0 +1,284 @@
+#include "AssetPack.h"
+#include <SDL2/SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "AudioSystem.h"
+#include "Trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char ASSET_PACK_MAGIC[4] = {'C', 'E', 'P', 'K'};
+static const Uint32 ASSET_PACK_ALIGN = 16;
+
+AssetPack::AssetPack() : data(nullptr), size(0), entries(nullptr), count(0) {
+}
+
+AssetPack::~AssetPack() {
+    Close();
+}
+
+bool AssetPack::Open(const char* file) {
+    TRACE_ZONE("AssetPack::Open");
+    Close();
+    const void* view = nullptr;
+    size_t viewSize = 0;
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false; // Sem pacote: caminho normal
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(handle, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(AssetPackHeader)) {
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // A view mantém o mapeamento vivo
+        }
+        viewSize = (size_t)fileSize.QuadPart;
+    }
+    CloseHandle(handle);
+#else
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) return false; // Sem pacote: caminho normal
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(AssetPackHeader)) {
+        void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) view = mapped;
+        viewSize = (size_t)info.st_size;
+    }
+    close(fd);
+#endif
+    if (!view) {
+        std::cerr << "Warning: Could not map " << file << ", decoding loose assets\n";
+        return false;
+    }
+    data = (const Uint8*)view;
+    size = viewSize;
+
+    // Índice lido direto do mapeamento: tudo é validado antes de qualquer ponteiro sair daqui
+    const AssetPackHeader* header = (const AssetPackHeader*)data;
+    const char* problem = nullptr;
+    if (std::memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0) problem = "not an asset pack";
+    else if (header->version != ASSET_PACK_VERSION) problem = "old version, rebuild it with --build-pack";
+    else if (header->dataSize != size) problem = "truncated";
+    else if (header->count > (size - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry)) problem = "bad index";
+    if (!problem) {
+        entries = (const AssetPackEntry*)(data + sizeof(AssetPackHeader));
+        count = (int)header->count;
+        for (int i = 0; i < count && !problem; ++i) {
+            const AssetPackEntry& entry = entries[i];
+            if (entry.offset > size || entry.size > size - entry.offset) problem = "entry out of bounds";
+            else if (std::memchr(entry.path, '\0', ASSET_PACK_PATH_SIZE) == nullptr) problem = "bad entry path";
+            else if (entry.kind == (Uint32)AssetKind::IMAGE &&
+                     (Uint64)entry.pitch * entry.height > entry.size) problem = "bad image size";
+        }
+    }
+    if (problem) {
+        std::cerr << "Warning: Ignoring " << file << " (" << problem << "), decoding loose assets\n";
+        Close();
+        return false;
+    }
+    std::cout << "[ASSETS] Mapped " << file << " (" << count << " entries, " << size / 1024 << " KB)\n";
+    return true;
+}
+
+void AssetPack::Close() {
+    if (data) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap((void*)data, size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    entries = nullptr;
+    count = 0;
+}
+
+// A mesma fonte em outro tamanho e o mesmo som com outro uso dividem a entrada; a imagem, só com o
+// mesmo color key (os pixels do pacote já saem com ele aplicado)
+static bool EntryMatches(const AssetPackEntry& entry, const AssetDesc& desc) {
+    if (entry.kind != (Uint32)desc.kind || std::strcmp(entry.path, desc.path) != 0) return false;
+    return desc.kind != AssetKind::IMAGE || entry.colorKeyWhite == (desc.colorKeyWhite ? 1u : 0u);
+}
+
+const AssetPackEntry* AssetPack::Find(const AssetDesc& desc) const {
+    for (int i = 0; i < count; ++i) {
+        if (EntryMatches(entries[i], desc)) return &entries[i];
+    }
+    return nullptr;
+}
+
+// ARGB8888 com o color key já virando alfa zero, depois RGB *= alfa (um pixel por Uint32)
+static bool PackImage(const AssetDesc& desc, AssetPackEntry& entry, std::vector<Uint8>& blob) {
+    SDL_Surface* surface = IMG_Load(desc.path);
+    if (!surface) {
+        std::cerr << "Warning: Could not load " << desc.path << ": " << IMG_GetError() << "\n";
+        return false;
+    }
+    if (desc.colorKeyWhite) SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 255, 255));
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+    if (!converted) {
+        std::cerr << "Warning: Could not convert " << desc.path << ": " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    entry.width = (Uint32)converted->w;
+    entry.height = (Uint32)converted->h;
+    entry.pitch = entry.width * 4;
+    blob.resize((size_t)entry.pitch * entry.height);
+    SDL_LockSurface(converted);
+    for (int y = 0; y < converted->h; ++y) {
+        const Uint32* src = (const Uint32*)((const Uint8*)converted->pixels + y * converted->pitch);
+        Uint32* dst = (Uint32*)&blob[(size_t)y * entry.pitch];
+        for (int x = 0; x < converted->w; ++x) {
+            Uint32 pixel = src[x];
+            Uint32 a = pixel >> 24;
+            Uint32 r = ((pixel >> 16) & 0xFF) * a / 255;
+            Uint32 g = ((pixel >> 8) & 0xFF) * a / 255;
+            Uint32 b = (pixel & 0xFF) * a / 255;
+            dst[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+    return true;
+}
+
+// PCM no formato em que o mixer é aberto: o Mix_QuickLoad_RAW usa os bytes sem converter
+static bool PackSound(const AssetDesc& desc, AssetPackEntry& entry, std::vector<Uint8>& blob) {
+    SDL_AudioSpec spec;
+    Uint8* buffer = nullptr;
+    Uint32 length = 0;
+    if (!SDL_LoadWAV(desc.path, &spec, &buffer, &length)) {
+        std::cerr << "Warning: Could not load " << desc.path << ": " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_AudioCVT cvt;
+    int needed = SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                                   AUDIO_FORMAT, AUDIO_CHANNELS, AUDIO_FREQUENCY);
+    if (needed < 0) {
+        std::cerr << "Warning: Could not convert " << desc.path << ": " << SDL_GetError() << "\n";
+        SDL_FreeWAV(buffer);
+        return false;
+    }
+    blob.resize((size_t)length * (needed ? cvt.len_mult : 1));
+    std::memcpy(blob.data(), buffer, length);
+    SDL_FreeWAV(buffer);
+    if (needed) {
+        cvt.buf = blob.data();
+        cvt.len = (int)length;
+        if (SDL_ConvertAudio(&cvt) != 0) {
+            std::cerr << "Warning: Could not convert " << desc.path << ": " << SDL_GetError() << "\n";
+            return false;
+        }
+        blob.resize((size_t)cvt.len_cvt);
+    }
+    entry.frequency = AUDIO_FREQUENCY;
+    entry.format = AUDIO_FORMAT;
+    entry.channels = AUDIO_CHANNELS;
+    return true;
+}
+
+// Fontes e músicas: o arquivo original (a música continua decodificada em streaming pelo mixer;
+// em PCM seriam dezenas de MB residentes)
+static bool PackFile(const AssetDesc& desc, std::vector<Uint8>& blob) {
+    std::ifstream in(desc.path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Warning: Could not open " << desc.path << "\n";
+        return false;
+    }
+    blob.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool AssetPack::Build(const AssetDesc* descs, int descCount, const char* file) {
+    TRACE_ZONE("AssetPack::Build");
+    std::vector<AssetPackEntry> index;
+    std::vector<std::vector<Uint8>> blobs;
+    bool ok = true;
+    for (int i = 0; i < descCount; ++i) {
+        const AssetDesc& desc = descs[i];
+        bool duplicate = false;
+        for (const AssetPackEntry& entry : index) duplicate = duplicate || EntryMatches(entry, desc);
+        if (duplicate) continue;
+        if (std::strlen(desc.path) >= (size_t)ASSET_PACK_PATH_SIZE) {
+            std::cerr << "Warning: Path too long for the asset pack: " << desc.path << "\n";
+            ok = false;
+            continue;
+        }
+
+        AssetPackEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        std::strcpy(entry.path, desc.path);
+        entry.kind = (Uint32)desc.kind;
+        entry.colorKeyWhite = desc.kind == AssetKind::IMAGE && desc.colorKeyWhite ? 1 : 0;
+        std::vector<Uint8> blob;
+        bool packed = false;
+        switch (desc.kind) {
+            case AssetKind::IMAGE: packed = PackImage(desc, entry, blob); break;
+            case AssetKind::SOUND: packed = PackSound(desc, entry, blob); break;
+            case AssetKind::MUSIC:
+            case AssetKind::FONT:  packed = PackFile(desc, blob); break;
+        }
+        if (!packed) {
+            ok = false;
+            continue;
+        }
+        entry.size = (Uint32)blob.size();
+        index.push_back(entry);
+        blobs.push_back(std::move(blob));
+    }
+    if (!ok) {
+        std::cerr << "Warning: Asset pack not written (fix the errors above)\n";
+        return false;
+    }
+
+    Uint32 offset = (Uint32)(sizeof(AssetPackHeader) + index.size() * sizeof(AssetPackEntry));
+    for (size_t i = 0; i < index.size(); ++i) {
+        offset = (offset + ASSET_PACK_ALIGN - 1) & ~(ASSET_PACK_ALIGN - 1);
+        index[i].offset = offset;
+        offset += index[i].size;
+    }
+    AssetPackHeader header;
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC));
+    header.version = ASSET_PACK_VERSION;
+    header.count = (Uint32)index.size();
+    header.dataSize = offset;
+
+    FILE* out = std::fopen(file, "wb");
+    if (!out) {
+        std::cerr << "Warning: Could not write " << file << "\n";
+        return false;
+    }
+    std::fwrite(&header, sizeof(header), 1, out);
+    std::fwrite(index.data(), sizeof(AssetPackEntry), index.size(), out);
+    static const Uint8 padding[ASSET_PACK_ALIGN] = {};
+    long position = (long)(sizeof(AssetPackHeader) + index.size() * sizeof(AssetPackEntry));
+    for (size_t i = 0; i < index.size(); ++i) {
+        std::fwrite(padding, 1, index[i].offset - position, out);
+        std::fwrite(blobs[i].data(), 1, blobs[i].size(), out);
+        position = (long)(index[i].offset + index[i].size);
+        std::cout << "[ASSETS] " << index[i].path << (index[i].colorKeyWhite ? " (color key)" : "") << ": "
+                  << blobs[i].size() / 1024 << " KB\n";
+    }
+    bool written = std::ferror(out) == 0;
+    if (std::fclose(out) != 0) written = false;
+    if (!written) {
+        std::cerr << "Warning: Could not write " << file << "\n";
+        return false;
+    }
+    std::cout << "[ASSETS] Wrote " << file << " (" << index.size() << " entries, " << offset / 1024 << " KB)\n";
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL2/SDL.h>
+#include "AssetLoader.h"
+
+// Arquivo:  AssetPackHeader | AssetPackEntry[count] | dados (cada bloco alinhado em 16 bytes).
+// Inteiros little-endian, como na memória das plataformas alvo (x86/ARM): o índice é lido direto
+// do mapeamento. Mudou o layout, sobe ASSET_PACK_VERSION (pacote antigo é ignorado).
+const Uint32 ASSET_PACK_VERSION = 2;
+const int ASSET_PACK_PATH_SIZE = 64;
+
+struct AssetPackHeader {
+    char magic[4];      // "CEPK"
+    Uint32 version;
+    Uint32 count;
+    Uint32 dataSize;    // Tamanho total do arquivo (pacote truncado é rejeitado)
+};
+
+struct AssetPackEntry {
+    char path[ASSET_PACK_PATH_SIZE]; // Caminho do arquivo solto que substitui ("assets/...")
+    Uint32 kind;        // AssetKind
+    Uint32 offset;      // Do início do arquivo
+    Uint32 size;
+    Uint32 width;       // IMAGE: ARGB8888 com color key e alfa pré-multiplicado aplicados
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 frequency;   // SOUND: PCM no formato do mixer (AUDIO_FREQUENCY/FORMAT/CHANNELS)
+    Uint16 format;
+    Uint16 channels;
+    Uint32 colorKeyWhite; // IMAGE: 1 se o branco já virou transparente (outra entrada para o mesmo arquivo sem)
+};
+
+// Pacote de assets pré-decodificados, gerado offline (--build-pack) e mapeado em memória: texturas
+// prontas para o SDL_UpdateTexture, sons em PCM para o Mix_QuickLoad_RAW e fontes/músicas como o
+// arquivo original (abertas da memória). Nada é copiado; os ponteiros valem até o Close.
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+
+    bool Open(const char* file);   // false sem pacote (ou inválido): o loader decodifica os soltos
+    void Close();                  // Depois do AssetLoader::Shutdown
+    bool IsOpen() const { return data != nullptr; }
+
+    const AssetPackEntry* Find(const AssetDesc& desc) const; // Mesmo arquivo, tipo e (imagens) color key
+    const Uint8* GetData(const AssetPackEntry& entry) const { return data + entry.offset; }
+
+    // Decodifica cada arquivo uma vez por variante (imagem com e sem color key) e grava o pacote
+    static bool Build(const AssetDesc* descs, int count, const char* file);
+
+private:
+    const Uint8* data;     // Mapeamento do arquivo inteiro (os handles fecham logo depois de mapear)
+    size_t size;
+    const AssetPackEntry* entries;
+    int count;
+};
+
+#endif // ASSET_PACK_H
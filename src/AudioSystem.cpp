@@ -1,9 +1,11 @@
 #include "AudioSystem.h"
 #include <iostream>
+#include "Trace.h"
 
 AudioSystem::AudioSystem()
     : successSound(nullptr), errorSound(nullptr), explosionSound(nullptr), selectSound(nullptr),
-      menuBGM(nullptr), gameBGM(nullptr), puzzleBGM(nullptr), initialized(false) {
+      menuBGM(nullptr), gameBGM(nullptr), puzzleBGM(nullptr), currentBGM(BGMType::MENU), bgmRequested(false),
+      initialized(false) {
 }
 
 AudioSystem::~AudioSystem() {
@@ -11,61 +13,20 @@ AudioSystem::~AudioSystem() {
 }
 
 bool AudioSystem::Initialize() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    TRACE_ZONE("AudioSystem::Initialize");
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, 2048) < 0) {
         std::cerr << "Warning: Could not initialize SDL_mixer: " << Mix_GetError() << "\n";
         std::cerr << "Audio will be disabled.\n";
         return false; // Não é fatal - jogo funciona sem áudio
     }
 
     initialized = true;
-
-    // Tenta carregar sons (não é fatal se falhar)
-    successSound = Mix_LoadWAV("assets/sounds/success.wav");
-    if (!successSound) {
-        std::cerr << "Warning: Could not load success.wav: " << Mix_GetError() << "\n";
-    }
-
-    errorSound = Mix_LoadWAV("assets/sounds/error.wav");
-    if (!errorSound) {
-        std::cerr << "Warning: Could not load error.wav: " << Mix_GetError() << "\n";
-    }
-
-    explosionSound = Mix_LoadWAV("assets/sounds/explosion.wav");
-    if (!explosionSound) {
-        std::cerr << "Warning: Could not load explosion.wav: " << Mix_GetError() << "\n";
-    }
-
-    selectSound = Mix_LoadWAV("assets/sounds/success.wav"); // Fallback to success if no specific select.wav
-    if (!selectSound) {
-        std::cerr << "Warning: Could not load select sound: " << Mix_GetError() << "\n";
-    }
-
-    menuBGM = Mix_LoadMUS("assets/sounds/menu_music.mp3");
-    if (!menuBGM) {
-        std::cerr << "Warning: Could not load menu_music.mp3: " << Mix_GetError() << "\n";
-    }
-
-    gameBGM = Mix_LoadMUS("assets/sounds/game_music.mp3");
-    if (!gameBGM) {
-        std::cerr << "Warning: Could not load game_music.mp3: " << Mix_GetError() << "\n";
-    }
-
-    puzzleBGM = Mix_LoadMUS("assets/sounds/puzzle_music.mp3");
-    if (!puzzleBGM) {
-        std::cerr << "Warning: Could not load puzzle_music.mp3: " << Mix_GetError() << "\n";
-    }
-
     return true;
 }
 
 void AudioSystem::Shutdown() {
-    if (menuBGM) { Mix_FreeMusic(menuBGM); menuBGM = nullptr; }
-    if (gameBGM) { Mix_FreeMusic(gameBGM); gameBGM = nullptr; }
-    if (puzzleBGM) { Mix_FreeMusic(puzzleBGM); puzzleBGM = nullptr; }
-    if (successSound) { Mix_FreeChunk(successSound); successSound = nullptr; }
-    if (errorSound) { Mix_FreeChunk(errorSound); errorSound = nullptr; }
-    if (explosionSound) { Mix_FreeChunk(explosionSound); explosionSound = nullptr; }
-    if (selectSound) { Mix_FreeChunk(selectSound); selectSound = nullptr; }
+    SetSounds(nullptr, nullptr, nullptr, nullptr);
+    menuBGM = gameBGM = puzzleBGM = nullptr;
 
     if (initialized) {
         Mix_CloseAudio();
@@ -74,6 +35,7 @@ void AudioSystem::Shutdown() {
 }
 
 void AudioSystem::PlaySuccess() {
+    TRACE_ZONE("AudioSystem::PlaySuccess");
     if (successSound) {
         Mix_PlayChannel(-1, successSound, 0);
     } else {
@@ -82,6 +44,7 @@ void AudioSystem::PlaySuccess() {
 }
 
 void AudioSystem::PlayError() {
+    TRACE_ZONE("AudioSystem::PlayError");
     if (errorSound) {
         Mix_PlayChannel(-1, errorSound, 0);
     } else {
@@ -90,6 +53,7 @@ void AudioSystem::PlayError() {
 }
 
 void AudioSystem::PlayExplosion() {
+    TRACE_ZONE("AudioSystem::PlayExplosion");
     if (explosionSound) {
         Mix_PlayChannel(-1, explosionSound, 0);
     } else {
@@ -98,6 +62,7 @@ void AudioSystem::PlayExplosion() {
 }
 
 void AudioSystem::PlaySelect() {
+    TRACE_ZONE("AudioSystem::PlaySelect");
     if (selectSound) {
         Mix_PlayChannel(-1, selectSound, 0);
     } else {
@@ -111,7 +76,26 @@ void AudioSystem::SetVolume(int volume) {
     Mix_Volume(-1, volume);
 }
 
+void AudioSystem::SetSounds(Mix_Chunk* success, Mix_Chunk* error, Mix_Chunk* explosion, Mix_Chunk* select) {
+    successSound = success;
+    errorSound = error;
+    explosionSound = explosion;
+    selectSound = select;
+}
+
+void AudioSystem::SetMusic(BGMType type, Mix_Music* music) {
+    switch (type) {
+        case BGMType::MENU: menuBGM = music; break;
+        case BGMType::GAME: gameBGM = music; break;
+        case BGMType::PUZZLE: puzzleBGM = music; break;
+    }
+    if (music && bgmRequested && currentBGM == type && !Mix_PlayingMusic()) PlayBGM(type);
+}
+
 void AudioSystem::PlayBGM(BGMType type) {
+    TRACE_ZONE("AudioSystem::PlayBGM");
+    currentBGM = type;
+    bgmRequested = true;
     Mix_Music* target = nullptr;
     switch (type) {
         case BGMType::MENU: target = menuBGM; break;
@@ -130,5 +114,6 @@ void AudioSystem::PlayBGM(BGMType type) {
 }
 
 void AudioSystem::StopBGM() {
+    TRACE_ZONE("AudioSystem::StopBGM");
     Mix_HaltMusic();
 }
@@ -4,16 +4,24 @@
 #include <SDL2/SDL_mixer.h>
 #include <string>
 
+// Formato pedido ao dispositivo; o pacote de assets guarda os sons já convertidos para ele
+const int AUDIO_FREQUENCY = 44100;
+const Uint16 AUDIO_FORMAT = MIX_DEFAULT_FORMAT;
+const int AUDIO_CHANNELS = 2;
+
 class AudioSystem {
 public:
     AudioSystem();
     ~AudioSystem();
 
-    bool Initialize();
+    bool Initialize(); // Só abre o dispositivo; sons e músicas chegam depois, do AssetLoader (que os libera)
     void Shutdown();
+    bool IsInitialized() const { return initialized; }
 
     // Música de Fundo
     enum class BGMType { MENU, GAME, PUZZLE };
+    void SetSounds(Mix_Chunk* success, Mix_Chunk* error, Mix_Chunk* explosion, Mix_Chunk* select);
+    void SetMusic(BGMType type, Mix_Music* music); // Começa a tocar se era a pedida e ainda não tinha chegado
     void PlayBGM(BGMType type);
     void StopBGM();
 
@@ -34,6 +42,8 @@ private:
     Mix_Music* menuBGM;
     Mix_Music* gameBGM;
     Mix_Music* puzzleBGM;
+    BGMType currentBGM;
+    bool bgmRequested;
     bool initialized;
 };
 
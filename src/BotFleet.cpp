@@ -0,0 +1,284 @@
+#include "BotFleet.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+static std::string BotFile(int index, const char* extension) {
+    return "bot_" + std::to_string(index) + extension;
+}
+
+// Leitura mínima dos relatórios do BotPlayer: "chave": número, a partir de from
+static double FindNumber(const std::string& json, const char* key, size_t from = 0) {
+    std::string pattern = std::string("\"") + key + "\": ";
+    size_t pos = json.find(pattern, from);
+    if (pos == std::string::npos) return 0.0;
+    return std::strtod(json.c_str() + pos + pattern.size(), nullptr);
+}
+
+BotFleet::BotFleet() {
+}
+
+int BotFleet::Run(const char* argv0) {
+#ifdef _WIN32
+    char path[MAX_PATH];
+    DWORD length = GetModuleFileNameA(nullptr, path, MAX_PATH);
+    executable = length > 0 && length < MAX_PATH ? std::string(path, length) : std::string(argv0);
+#else
+    executable = argv0;
+#endif
+    int jobs = config.jobs > 0 ? config.jobs : SDL_GetCPUCount();
+    jobs = std::max(1, std::min(jobs, config.bots));
+#ifdef _WIN32
+    jobs = std::min(jobs, (int)MAXIMUM_WAIT_OBJECTS);
+#endif
+    std::cout << "[BOTS] Running " << config.bots << " bots on level " << config.level << ", " << jobs
+              << " at a time (" << config.frames << " frames max each)\n";
+
+    processes.assign(config.bots, BotProcess{0, -1, false});
+    running.clear();
+    Uint64 start = SDL_GetPerformanceCounter();
+    int next = 0;
+    while (next < config.bots || !running.empty()) {
+        while (next < config.bots && (int)running.size() < jobs) {
+            if (Spawn(next)) running.push_back(next);
+            else processes[next].finished = true;
+            ++next;
+        }
+        if (running.empty()) continue;
+        int done = WaitAny();
+        if (done < 0) break;
+        running.erase(std::find(running.begin(), running.end(), done));
+        std::cout << "[BOTS] Bot " << done << " finished (exit " << processes[done].exitCode << ")\n";
+    }
+    double wallMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    return Aggregate(wallMs);
+}
+
+bool BotFleet::Spawn(int index) {
+    std::vector<std::string> args = {
+        executable, "--headless", "--bot",
+        "--bot-id=" + std::to_string(index),
+        "--bot-level=" + std::to_string(config.level),
+        "--bot-report=" + BotFile(index, ".json"),
+        "--seed=" + std::to_string(config.seed + (Uint32)index),
+        "--frames=" + std::to_string(config.frames),
+        "--jobs=1" // Os bots já rodam em paralelo: workers dentro de cada um só disputariam núcleos
+    };
+    std::string log = BotFile(index, ".log");
+    std::remove(BotFile(index, ".json").c_str()); // Relatório velho não pode passar por novo
+
+#ifdef _WIN32
+    std::string commandLine;
+    for (const std::string& arg : args) commandLine += (commandLine.empty() ? "\"" : " \"") + arg + "\"";
+
+    SECURITY_ATTRIBUTES inherit = {sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE logFile = CreateFileA(log.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &inherit, CREATE_ALWAYS,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+    STARTUPINFOA startup = {};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = logFile;
+    startup.hStdError = logFile;
+    PROCESS_INFORMATION info = {};
+    BOOL ok = CreateProcessA(executable.c_str(), &commandLine[0], nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                             nullptr, nullptr, &startup, &info);
+    if (logFile != INVALID_HANDLE_VALUE) CloseHandle(logFile);
+    if (!ok) {
+        std::cerr << "Warning: Could not start bot " << index << " (error " << GetLastError() << ")\n";
+        return false;
+    }
+    CloseHandle(info.hThread);
+    processes[index].process = (intptr_t)info.hProcess;
+#else
+    std::vector<char*> argv;
+    for (std::string& arg : args) argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+    pid_t pid = 0;
+    int error = posix_spawnp(&pid, executable.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0) {
+        std::cerr << "Warning: Could not start bot " << index << " (error " << error << ")\n";
+        return false;
+    }
+    processes[index].process = (intptr_t)pid;
+#endif
+    return true;
+}
+
+int BotFleet::WaitAny() {
+#ifdef _WIN32
+    std::vector<HANDLE> handles;
+    for (int index : running) handles.push_back((HANDLE)processes[index].process);
+    DWORD result = WaitForMultipleObjects((DWORD)handles.size(), handles.data(), FALSE, INFINITE);
+    if (result >= WAIT_OBJECT_0 + handles.size()) return -1;
+    int index = running[result - WAIT_OBJECT_0];
+    DWORD code = 0;
+    GetExitCodeProcess(handles[result - WAIT_OBJECT_0], &code);
+    CloseHandle(handles[result - WAIT_OBJECT_0]);
+    processes[index].exitCode = (int)code;
+    processes[index].finished = true;
+    return index;
+#else
+    for (;;) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) return -1;
+        for (int index : running) {
+            if ((pid_t)processes[index].process != pid) continue;
+            // Morto por sinal (crash) conta como -sinal
+            processes[index].exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+            processes[index].finished = true;
+            return index;
+        }
+    }
+#endif
+}
+
+int BotFleet::Aggregate(double wallMs) {
+    struct LevelSummary {
+        int runs = 0;
+        int completed = 0;
+        std::vector<double> seconds;
+        double wallMsSum = 0.0;
+        double frameMeanSum = 0.0;
+        double worstP95 = 0.0;
+        double worstFrame = 0.0;
+        std::map<std::pair<int, int>, int> stuck;
+    };
+    std::map<int, LevelSummary> levels;
+    std::vector<std::string> reports(config.bots);
+    int failed = 0;
+
+    for (int i = 0; i < config.bots; ++i) {
+        std::ifstream in(BotFile(i, ".json"));
+        if (!in.is_open()) {
+            std::cerr << "Warning: Bot " << i << " left no report (exit " << processes[i].exitCode
+                      << ", see " << BotFile(i, ".log") << ")\n";
+            ++failed;
+            continue;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string& json = reports[i];
+        json = buffer.str();
+        while (!json.empty() && (json.back() == '\n' || json.back() == '\r')) json.pop_back();
+
+        LevelSummary& level = levels[(int)FindNumber(json, "level")];
+        level.runs++;
+        bool completed = json.find("\"completed\": true") != std::string::npos;
+        if (completed) {
+            level.completed++;
+            level.seconds.push_back(FindNumber(json, "completion_seconds"));
+            level.wallMsSum += FindNumber(json, "completion_wall_ms");
+        } else {
+            ++failed;
+        }
+        size_t frameStats = json.find("\"frame_ms\"");
+        if (frameStats != std::string::npos) {
+            level.frameMeanSum += FindNumber(json, "mean", frameStats);
+            level.worstP95 = std::max(level.worstP95, FindNumber(json, "p95", frameStats));
+            level.worstFrame = std::max(level.worstFrame, FindNumber(json, "max", frameStats));
+        }
+
+        // "stuck": [[x, y, vezes], ...]
+        size_t pos = json.find("\"stuck\": [");
+        if (pos != std::string::npos) {
+            const char* p = json.c_str() + pos + 10;
+            while (*p == '[' || *p == ',' || *p == ' ') {
+                if (*p != '[') { ++p; continue; }
+                char* end = nullptr;
+                int x = (int)std::strtol(p + 1, &end, 10);
+                int y = (int)std::strtol(end + 1, &end, 10);
+                int count = (int)std::strtol(end + 1, &end, 10);
+                level.stuck[{x, y}] += count;
+                p = end + 1;
+            }
+        }
+    }
+
+    FILE* out = std::fopen(config.reportFile.c_str(), "w");
+    if (!out) std::cerr << "Warning: Could not write " << config.reportFile << "\n";
+    if (out) {
+        std::fprintf(out, "{\n  \"bots\": %d, \"frames\": %d, \"seed\": %u, \"wall_ms\": %.1f,\n  \"levels\": [\n",
+                     config.bots, config.frames, config.seed, wallMs);
+    }
+
+    char line[256];
+    size_t levelIndex = 0;
+    for (auto& entry : levels) {
+        LevelSummary& level = entry.second;
+        std::vector<double>& seconds = level.seconds;
+        std::sort(seconds.begin(), seconds.end());
+        double mean = 0.0;
+        for (double s : seconds) mean += s;
+        if (!seconds.empty()) mean /= seconds.size();
+        double p50 = seconds.empty() ? 0.0 : seconds[seconds.size() / 2];
+        double minSeconds = seconds.empty() ? 0.0 : seconds.front();
+        double maxSeconds = seconds.empty() ? 0.0 : seconds.back();
+        double wallMean = level.completed ? level.wallMsSum / level.completed : 0.0;
+        double frameMean = level.runs ? level.frameMeanSum / level.runs : 0.0;
+
+        std::snprintf(line, sizeof(line), "[BOTS] Level %d: %d/%d completed, %.1f s mean (p50 %.1f, min %.1f, max %.1f), "
+                                          "%.0f ms wall, frame mean %.2f worst p95 %.2f max %.2f ms\n",
+                      entry.first, level.completed, level.runs, mean, p50, minSeconds, maxSeconds, wallMean,
+                      frameMean, level.worstP95, level.worstFrame);
+        std::cout << line;
+
+        // Pontos onde mais bots ficaram presos primeiro
+        std::vector<std::pair<int, std::pair<int, int>>> stuck;
+        for (auto& spot : level.stuck) stuck.push_back({spot.second, spot.first});
+        std::sort(stuck.begin(), stuck.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (size_t i = 0; i < stuck.size() && i < 5; ++i) {
+            std::cout << "[BOTS]   stuck at (" << stuck[i].second.first << ", " << stuck[i].second.second
+                      << ") x" << stuck[i].first << "\n";
+        }
+
+        if (!out) continue;
+        std::fprintf(out, "    {\"level\": %d, \"runs\": %d, \"completed\": %d, "
+                          "\"completion_seconds\": {\"mean\": %.3f, \"p50\": %.3f, \"min\": %.3f, \"max\": %.3f}, "
+                          "\"completion_wall_ms_mean\": %.1f, "
+                          "\"frame_ms\": {\"mean\": %.3f, \"worst_p95\": %.3f, \"max\": %.3f}, \"stuck\": [",
+                     entry.first, level.runs, level.completed, mean, p50, minSeconds, maxSeconds, wallMean,
+                     frameMean, level.worstP95, level.worstFrame);
+        for (size_t i = 0; i < stuck.size(); ++i) {
+            std::fprintf(out, "%s[%d, %d, %d]", i ? ", " : "", stuck[i].second.first, stuck[i].second.second, stuck[i].first);
+        }
+        std::fprintf(out, "]}%s\n", ++levelIndex < levels.size() ? "," : "");
+    }
+
+    std::snprintf(line, sizeof(line), "[BOTS] %d bots in %.1f s wall (%.2f bots/s)\n", config.bots, wallMs / 1000.0,
+                  wallMs > 0.0 ? config.bots * 1000.0 / wallMs : 0.0);
+    std::cout << line;
+
+    if (out) {
+        // Relatórios individuais na íntegra (null para bots que não deixaram relatório)
+        std::fprintf(out, "  ],\n  \"runs\": [\n");
+        for (int i = 0; i < config.bots; ++i) {
+            std::fprintf(out, "    %s%s\n", reports[i].empty() ? "null" : reports[i].c_str(), i + 1 < config.bots ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+        std::fclose(out);
+        std::cout << "[BOTS] Report written to " << config.reportFile << "\n";
+    }
+    return failed;
+}
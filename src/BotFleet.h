@@ -0,0 +1,45 @@
+#ifndef BOT_FLEET_H
+#define BOT_FLEET_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct BotFleetConfig {
+    int bots = 8;
+    int jobs = 0;              // Processos ao mesmo tempo (0 = núcleos da CPU)
+    int level = 1;
+    int frames = 36000;        // Limite por bot: 10 min de simulação headless
+    Uint32 seed = 1;           // Bot i joga com a semente seed + i
+    std::string reportFile = "bot_report.json";
+};
+
+// Roda muitos BotPlayers em paralelo, cada um num processo headless do próprio executável
+// (o SDL só aceita vídeo e eventos na thread principal de cada processo). A saída de cada bot
+// vai para bot_<i>.log e o relatório para bot_<i>.json; no fim soma tudo por fase em reportFile.
+class BotFleet {
+public:
+    BotFleet();
+
+    void Configure(const BotFleetConfig& cfg) { config = cfg; }
+    int Run(const char* argv0);     // Retorna quantos bots não concluíram a fase
+
+private:
+    struct BotProcess {
+        intptr_t process;           // pid (POSIX) ou HANDLE (Windows)
+        int exitCode;
+        bool finished;
+    };
+
+    bool Spawn(int index);
+    int WaitAny();                  // Índice do bot que terminou
+    int Aggregate(double wallMs);
+
+    BotFleetConfig config;
+    std::string executable;
+    std::vector<BotProcess> processes;
+    std::vector<int> running;
+};
+
+#endif // BOT_FLEET_H
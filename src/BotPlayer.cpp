@@ -0,0 +1,438 @@
+#include "BotPlayer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Game.h"
+#include "TileMap.h"
+#include "CircuitSystem.h"
+#include "InputRecorder.h"
+
+static const int BOT_STUCK_TICKS = 90;           // ~6 tentativas de passo sem sair da célula
+static const int BOT_MAX_PUZZLE_ATTEMPTS = 3;
+static const char* STATE_NAMES[] = {"main_menu", "level_selection", "exploration", "puzzle", "dialogue", "victory"};
+static const char* RESULT_NAMES[] = {"none", "correct", "no_resistor", "open_circuit", "inverted"};
+
+BotPlayer::BotPlayer()
+    : enabled(false), seed(1), rngState(1), pendingRead(0), heldKeys(0), quitRequested(false),
+      ticks(0), frames(0), lastActionTick(0), readDelay(20), keyDelay(6), lastState(GameState::MAIN_MENU),
+      startCounter(0), jobs(nullptr), lastX(-1), lastY(-1), cellTicks(0), wanderTicks(0), wanderKeys(0),
+      planX(0), planY(0), planDir(1), planStep(0), validated(false), puzzleAttempts(0),
+      lastResult(PuzzleResult::NONE), completed(false), gaveUp(false),
+      completionTicks(0), completionFrames(0), completionWallMs(0.0) {
+    for (int& t : stateTicks) t = 0;
+}
+
+void BotPlayer::Enable(const BotConfig& cfg) {
+    enabled = true;
+    config = cfg;
+}
+
+void BotPlayer::Start(Uint32 randomSeed) {
+    seed = randomSeed;
+    rngState = randomSeed ? randomSeed : 1;
+    // Cada semente é um "jogador" diferente: lê mais rápido ou mais devagar, hesita mais nas teclas
+    readDelay = 10 + Random(30);
+    keyDelay = 4 + Random(8);
+
+    pendingKeys.clear();
+    pendingRead = 0;
+    heldKeys = 0;
+    quitRequested = false;
+    ticks = 0;
+    frames = 0;
+    lastActionTick = 0;
+    lastState = GameState::MAIN_MENU;
+    path.clear();
+    lastX = lastY = -1;
+    cellTicks = 0;
+    wanderTicks = 0;
+    stuckSpots.clear();
+    plan.clear();
+    puzzleAttempts = 0;
+    lastResult = PuzzleResult::NONE;
+    completed = false;
+    gaveUp = false;
+    for (int& t : stateTicks) t = 0;
+    frameMs.clear();
+    startCounter = SDL_GetPerformanceCounter();
+    std::cout << "[BOT " << config.id << "] Playing level " << config.level << " (seed " << seed
+              << ", read " << readDelay << " ticks, keys " << keyDelay << " ticks)\n";
+}
+
+void BotPlayer::PressKey(SDL_Keycode key) {
+    pendingKeys.push_back(key);
+}
+
+bool BotPlayer::Ready(int delayTicks) {
+    if (ticks - lastActionTick < delayTicks) return false;
+    lastActionTick = ticks;
+    return true;
+}
+
+int BotPlayer::Random(int range) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return range > 0 ? (int)(rngState % (Uint32)range) : 0;
+}
+
+void BotPlayer::Think(const BotView& view) {
+    if (!enabled) return;
+    pendingKeys.clear();
+    pendingRead = 0;
+    heldKeys = 0;
+
+    if (view.state != lastState) {
+        // Tela nova: espera o atraso de leitura antes da primeira tecla
+        lastActionTick = ticks;
+        if (view.state == GameState::PUZZLE) {
+            plan.clear();
+            validated = false;
+        }
+        if (view.state == GameState::EXPLORATION) {
+            path.clear();
+            cellTicks = 0;
+        }
+        lastState = view.state;
+    }
+    if (gaveUp) return;
+
+    switch (view.state) {
+        case GameState::MAIN_MENU:
+            if (Ready(keyDelay)) PressKey(view.mainMenuSelection == 0 ? SDLK_RETURN : SDLK_UP);
+            break;
+        case GameState::LEVEL_SELECTION:
+            if (!Ready(keyDelay)) break;
+            if (view.levelSelection < config.level) PressKey(SDLK_RIGHT);
+            else if (view.levelSelection > config.level) PressKey(SDLK_LEFT);
+            else PressKey(SDLK_RETURN);
+            break;
+        case GameState::DIALOGUE:
+            // Completa o texto ou passa para a próxima fala
+            if (Ready(readDelay)) PressKey(SDLK_SPACE);
+            break;
+        case GameState::EXPLORATION:
+            Think_Exploration(view);
+            break;
+        case GameState::PUZZLE:
+            Think_Puzzle(view);
+            break;
+        case GameState::VICTORY:
+            if (!completed) {
+                completed = true;
+                completionTicks = ticks;
+                completionFrames = frames;
+                completionWallMs = (SDL_GetPerformanceCounter() - startCounter) * 1000.0 / SDL_GetPerformanceFrequency();
+                std::cout << "[BOT " << config.id << "] Level " << config.level << " complete after "
+                          << completionTicks << " ticks\n";
+            }
+            if (Ready(keyDelay)) PressKey(SDLK_RETURN); // Fecha o jogo
+            break;
+    }
+}
+
+void BotPlayer::Think_Exploration(const BotView& view) {
+    if (!view.hasGoal || !view.tileMap) return; // Camada de objetos ainda carregando
+    int x = view.playerX;
+    int y = view.playerY;
+    if (x != lastX || y != lastY) {
+        lastX = x;
+        lastY = y;
+        cellTicks = 0;
+    }
+
+    // Na bancada (zona em cruz em volta do marcador): interage
+    if (std::abs(x - view.goalX) + std::abs(y - view.goalY) <= 1) {
+        path.clear();
+        if (Ready(keyDelay)) PressKey(SDLK_e);
+        return;
+    }
+
+    if (wanderTicks > 0) {
+        heldKeys = wanderKeys;
+        return;
+    }
+
+    if (cellTicks >= BOT_STUCK_TICKS) {
+        Unstick(x, y);
+        return;
+    }
+
+    int width = view.tileMap->GetWidth();
+    // Próxima célula no fim do vetor; fora do caminho (empurrado, renasceu) planeja de novo
+    if (!path.empty() && path.back() == y * width + x) path.pop_back();
+    bool onPath = !path.empty();
+    if (onPath) {
+        int next = path.back();
+        onPath = std::abs(next % width - x) + std::abs(next / width - y) == 1;
+    }
+    if (!onPath) {
+        path.clear();
+        // Primeiro evita o piso eletrificado; se não houver outro jeito, atravessa. Com workers as
+        // duas buscas rodam juntas (fork-join) e a que evita o piso continua tendo preferência
+        bool safeFound = false;
+        bool anyFound = false;
+        if (jobs) {
+            JobCounter counter;
+            jobs->Run(counter, [&] { anyFound = PlanPath(view, false, anySearch); });
+            safeFound = PlanPath(view, true, safeSearch);
+            jobs->Wait(counter);
+        } else {
+            safeFound = PlanPath(view, true, safeSearch);
+            anyFound = !safeFound && PlanPath(view, false, anySearch);
+        }
+        if (!safeFound && !anyFound) {
+            Unstick(x, y); // Sem caminho (porta fechada?): conta como preso
+            return;
+        }
+        path.swap(safeFound ? safeSearch.path : anySearch.path);
+    }
+
+    int next = path.back();
+    int nx = next % width;
+    int ny = next / width;
+    if (nx > x) heldKeys = INPUT_KEY_RIGHT;
+    else if (nx < x) heldKeys = INPUT_KEY_LEFT;
+    else if (ny > y) heldKeys = INPUT_KEY_DOWN;
+    else heldKeys = INPUT_KEY_UP;
+}
+
+void BotPlayer::Unstick(int x, int y) {
+    // Não sai do lugar: anota o ponto, anda um pouco ao acaso e refaz o caminho
+    MarkStuck(x, y);
+    static const Uint8 directions[4] = {INPUT_KEY_UP, INPUT_KEY_DOWN, INPUT_KEY_LEFT, INPUT_KEY_RIGHT};
+    wanderKeys = directions[Random(4)];
+    wanderTicks = 30 + Random(30);
+    cellTicks = 0;
+    path.clear();
+    heldKeys = wanderKeys;
+}
+
+bool BotPlayer::PlanPath(const BotView& view, bool avoidHazards, PathSearch& search) const {
+    const TileMap& map = *view.tileMap;
+    int width = map.GetWidth();
+    int height = map.GetHeight();
+    auto walkable = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        const Tile& tile = map.GetTile(x, y);
+        if (tile.IsSolid()) return false;
+        if (view.circuitSystem && view.circuitSystem->IsSolid(x, y)) return false;
+        return !avoidHazards || (!tile.IsHazard() && !tile.IsHazardEmitter());
+    };
+
+    // BFS em 4 direções até qualquer célula da zona da bancada
+    int start = view.playerY * width + view.playerX;
+    std::vector<int>& parent = search.parent;
+    std::vector<int>& queue = search.queue;
+    search.path.clear();
+    parent.assign(width * height, -1);
+    queue.clear();
+    queue.push_back(start);
+    parent[start] = start;
+    int found = -1;
+    static const int dx[4] = {0, 0, -1, 1};
+    static const int dy[4] = {-1, 1, 0, 0};
+    for (size_t head = 0; head < queue.size() && found < 0; ++head) {
+        int cur = queue[head];
+        int cx = cur % width;
+        int cy = cur / width;
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + dx[d];
+            int ny = cy + dy[d];
+            if (!walkable(nx, ny)) continue;
+            int next = ny * width + nx;
+            if (parent[next] >= 0) continue;
+            parent[next] = cur;
+            if (std::abs(nx - view.goalX) + std::abs(ny - view.goalY) <= 1) {
+                found = next;
+                break;
+            }
+            queue.push_back(next);
+        }
+    }
+    if (found < 0) return false;
+
+    for (int cell = found; cell != start; cell = parent[cell]) search.path.push_back(cell);
+    return true;
+}
+
+void BotPlayer::MarkStuck(int x, int y) {
+    std::cout << "[BOT " << config.id << "] Stuck at (" << x << ", " << y << ")\n";
+    for (StuckSpot& spot : stuckSpots) {
+        if (spot.x == x && spot.y == y) {
+            spot.count++;
+            return;
+        }
+    }
+    stuckSpots.push_back({x, y, 1});
+}
+
+bool BotPlayer::BuildPuzzlePlan(const CircuitPuzzle& puzzle) {
+    plan.clear();
+    planStep = 0;
+    int width = puzzle.GetGridWidth();
+    int height = puzzle.GetGridHeight();
+    int sourceX = -1, sourceY = -1;
+    for (int y = 0; y < height && sourceX < 0; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (GetTraits(puzzle.GetCellType(x, y)).model == ElectricalModel::SOURCE) {
+                sourceX = x;
+                sourceY = y;
+                break;
+            }
+        }
+    }
+    if (sourceX < 0) return false;
+
+    // Fio (se houver), resistor e LED em linha a partir da fonte: o mínimo que o validador aceita
+    const ElectricalModel order[3] = {ElectricalModel::CONDUCTOR, ElectricalModel::LIMITER, ElectricalModel::LOAD};
+    for (ElectricalModel model : order) {
+        for (int i = 0; i < puzzle.GetInventorySize(); ++i) {
+            if (GetTraits(puzzle.GetInventoryType(i)).model == model && puzzle.GetInventoryCount(i) > 0) {
+                plan.push_back(puzzle.GetInventoryType(i));
+                break;
+            }
+        }
+    }
+    if (plan.size() < 2 || GetTraits(plan.back()).model != ElectricalModel::LOAD) return false;
+
+    planDir = sourceX + (int)plan.size() < width ? 1 : -1;
+    if (sourceX + planDir * (int)plan.size() < 0) return false;
+    planX = sourceX + planDir;
+    planY = sourceY;
+    return true;
+}
+
+void BotPlayer::Think_Puzzle(const BotView& view) {
+    const CircuitPuzzle& puzzle = *view.puzzle;
+    if (!Ready(keyDelay)) return;
+
+    if (!validated && plan.empty() && !BuildPuzzlePlan(puzzle)) {
+        std::cerr << "Warning: Bot " << config.id << " has no plan for this puzzle\n";
+        gaveUp = true;
+        quitRequested = true;
+        return;
+    }
+
+    if (planStep < (int)plan.size()) {
+        int tx = planX + planDir * planStep;
+        int ty = planY;
+        int cx = puzzle.GetCursorX();
+        int cy = puzzle.GetCursorY();
+        ComponentType want = plan[planStep];
+        if (cx < tx) PressKey(SDLK_RIGHT);
+        else if (cx > tx) PressKey(SDLK_LEFT);
+        else if (cy < ty) PressKey(SDLK_DOWN);
+        else if (cy > ty) PressKey(SDLK_UP);
+        else if (puzzle.GetCellType(tx, ty) == want) planStep++;
+        else if (puzzle.GetCellType(tx, ty) != ComponentType::EMPTY) PressKey(SDLK_BACKSPACE);
+        else if (puzzle.GetInventoryType(puzzle.GetSelectedInventory()) != want) PressKey(SDLK_TAB);
+        else PressKey(SDLK_SPACE);
+        return;
+    }
+
+    if (!validated) {
+        PressKey(SDLK_v);
+        validated = true;
+        puzzleAttempts++;
+        return;
+    }
+
+    // Validou e continua no puzzle: o circuito não passou
+    lastResult = puzzle.GetLastResult();
+    std::cout << "[BOT " << config.id << "] Puzzle attempt " << puzzleAttempts << " failed ("
+              << RESULT_NAMES[(int)lastResult] << ")\n";
+    if (puzzleAttempts >= BOT_MAX_PUZZLE_ATTEMPTS) {
+        gaveUp = true;
+        quitRequested = true;
+        return;
+    }
+    PressKey(SDLK_ESCAPE); // Sai e volta pela bancada: o tabuleiro recomeça do zero
+}
+
+bool BotPlayer::NextEvent(SDL_Event& event) {
+    if (quitRequested) {
+        quitRequested = false;
+        std::memset(&event, 0, sizeof(event));
+        event.type = SDL_QUIT;
+        return true;
+    }
+    if (pendingRead >= pendingKeys.size()) return false;
+    std::memset(&event, 0, sizeof(event));
+    event.type = SDL_KEYDOWN;
+    event.key.type = SDL_KEYDOWN;
+    event.key.state = SDL_PRESSED;
+    event.key.keysym.sym = pendingKeys[pendingRead++];
+    event.key.keysym.scancode = SDL_GetScancodeFromKey(event.key.keysym.sym);
+    return true;
+}
+
+void BotPlayer::RecordFrame(double ms, int steps) {
+    if (!enabled) return;
+    frameMs.push_back((float)ms);
+    ++frames;
+    ticks += steps;
+    stateTicks[(int)lastState] += steps;
+    if (wanderTicks > 0) wanderTicks -= steps;
+    else if (lastState == GameState::EXPLORATION && heldKeys) cellTicks += steps;
+}
+
+static float PercentileOf(std::vector<float> values, float p) {
+    if (values.empty()) return 0.0f;
+    size_t k = std::min(values.size() - 1, (size_t)(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+void BotPlayer::Report() const {
+    if (!enabled) return;
+    double sum = 0.0;
+    float worst = 0.0f;
+    for (float ms : frameMs) {
+        sum += ms;
+        worst = std::max(worst, ms);
+    }
+    double mean = frameMs.empty() ? 0.0 : sum / frameMs.size();
+    float p50 = PercentileOf(frameMs, 0.5f);
+    float p95 = PercentileOf(frameMs, 0.95f);
+    float p99 = PercentileOf(frameMs, 0.99f);
+    double seconds = completionTicks * SIM_DT;
+
+    char line[224];
+    if (completed) {
+        std::snprintf(line, sizeof(line), "[BOT %d] Level %d completed in %.1f s (%d ticks, %.0f ms wall), %d stuck spots, "
+                                          "frame mean %.2f p95 %.2f max %.2f ms\n",
+                      config.id, config.level, seconds, completionTicks, completionWallMs, (int)stuckSpots.size(), mean, p95, worst);
+    } else {
+        std::snprintf(line, sizeof(line), "[BOT %d] Level %d NOT completed (ended in %s after %d ticks), %d stuck spots, "
+                                          "frame mean %.2f p95 %.2f max %.2f ms\n",
+                      config.id, config.level, STATE_NAMES[(int)lastState], ticks, (int)stuckSpots.size(), mean, p95, worst);
+    }
+    std::cout << line;
+    if (config.reportFile.empty()) return;
+
+    FILE* out = std::fopen(config.reportFile.c_str(), "w");
+    if (!out) {
+        std::cerr << "Warning: Could not write " << config.reportFile << "\n";
+        return;
+    }
+    std::fprintf(out, "{\"bot\": %d, \"seed\": %u, \"level\": %d, \"completed\": %s, \"end_state\": \"%s\", "
+                      "\"frames\": %d, \"ticks\": %d, \"completion_frames\": %d, \"completion_ticks\": %d, \"completion_seconds\": %.3f, "
+                      "\"completion_wall_ms\": %.1f, \"puzzle_attempts\": %d, \"last_puzzle_result\": \"%s\",\n",
+                 config.id, seed, config.level, completed ? "true" : "false", STATE_NAMES[(int)lastState],
+                 frames, ticks, completionFrames, completionTicks, seconds, completionWallMs, puzzleAttempts, RESULT_NAMES[(int)lastResult]);
+    std::fprintf(out, " \"state_seconds\": {");
+    for (int i = 0; i <= (int)GameState::VICTORY; ++i) {
+        std::fprintf(out, "%s\"%s\": %.2f", i ? ", " : "", STATE_NAMES[i], stateTicks[i] * SIM_DT);
+    }
+    // Pontos presos como [x, y, vezes], para o BotFleet somar entre execuções
+    std::fprintf(out, "},\n \"stuck\": [");
+    for (size_t i = 0; i < stuckSpots.size(); ++i) {
+        std::fprintf(out, "%s[%d, %d, %d]", i ? ", " : "", stuckSpots[i].x, stuckSpots[i].y, stuckSpots[i].count);
+    }
+    std::fprintf(out, "],\n \"frame_ms\": {\"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}}\n",
+                 mean, p50, p95, p99, worst);
+    std::fclose(out);
+}
@@ -0,0 +1,129 @@
+#ifndef BOT_PLAYER_H
+#define BOT_PLAYER_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "GameState.h"
+#include "CircuitPuzzle.h"
+#include "JobSystem.h"
+
+class TileMap;
+class CircuitSystem;
+
+struct BotConfig {
+    int id = 0;
+    int level = 1;                                // Fase escolhida na seleção
+    std::string reportFile;                       // JSON do relatório (--bot-report); vazio: só o log
+};
+
+// O que o bot enxerga do jogo a cada quadro (só leitura, montado pelo Game)
+struct BotView {
+    GameState state;
+    int mainMenuSelection;
+    int levelSelection;
+    int playerX;
+    int playerY;
+    bool hasGoal;          // Camada de objetos aplicada e bancada do puzzle ainda aberta
+    int goalX;             // Marcador da bancada
+    int goalY;
+    const TileMap* tileMap;
+    const CircuitSystem* circuitSystem;
+    const CircuitPuzzle* puzzle;
+};
+
+// Jogador automático: joga a fase de ponta a ponta pela mesma camada de entrada do replay
+// (eventos de tecla + setas amostradas por tick). Menu -> seleção -> diálogos -> anda até a
+// bancada (BFS no grid) -> monta o circuito -> VICTORY. Mede o tempo até concluir, os pontos
+// onde ficou preso e a distribuição do tempo de quadro, e grava tudo num JSON no fim.
+class BotPlayer {
+public:
+    BotPlayer();
+
+    void Enable(const BotConfig& cfg);
+    void SetJobSystem(JobSystem* jobSystem) { jobs = jobSystem; } // Buscas de caminho em paralelo
+    void Disable() { enabled = false; }
+    bool IsEnabled() const { return enabled; }
+    void Start(Uint32 seed);           // Zera o estado; a semente varia ritmo de leitura e desvios
+
+    void Think(const BotView& view);   // Uma vez por quadro, antes do HandleInput
+    bool NextEvent(SDL_Event& event);  // Teclas decididas neste quadro
+    Uint8 MovementKeys() const { return heldKeys; }
+
+    void RecordFrame(double frameMs, int steps); // Tempo de CPU do quadro e ticks simulados
+    void Report() const;                         // Log (+ JSON em config.reportFile, se houver)
+
+private:
+    struct StuckSpot {
+        int x;
+        int y;
+        int count;
+    };
+    // Buffers de uma busca (BFS reaproveitado); uma por variante para rodarem ao mesmo tempo
+    struct PathSearch {
+        std::vector<int> parent;
+        std::vector<int> queue;
+        std::vector<int> path;
+    };
+
+    void PressKey(SDL_Keycode key);
+    bool Ready(int delayTicks);        // Espera entre teclas, como um jogador lendo a tela
+    void Think_Exploration(const BotView& view);
+    void Think_Puzzle(const BotView& view);
+    bool PlanPath(const BotView& view, bool avoidHazards, PathSearch& search) const;
+    bool BuildPuzzlePlan(const CircuitPuzzle& puzzle);
+    void Unstick(int x, int y);
+    void MarkStuck(int x, int y);
+    int Random(int range);
+
+    bool enabled;
+    BotConfig config;
+    Uint32 seed;
+    Uint32 rngState;
+    std::vector<SDL_Keycode> pendingKeys;
+    size_t pendingRead;
+    Uint8 heldKeys;
+    bool quitRequested;
+
+    // Relógio (ticks de simulação) e ritmo
+    int ticks;
+    int frames;
+    int lastActionTick;
+    int readDelay;                     // Ticks entre falas do diálogo
+    int keyDelay;                      // Ticks entre teclas no puzzle e nos menus
+    GameState lastState;
+    Uint64 startCounter;
+
+    // Navegação: caminho até a bancada (células, a próxima no fim do vetor)
+    std::vector<int> path;
+    PathSearch safeSearch;             // Evitando o piso eletrificado
+    PathSearch anySearch;              // Atravessando, se preciso
+    JobSystem* jobs;
+    int lastX;
+    int lastY;
+    int cellTicks;                     // Ticks parado na mesma célula querendo andar
+    int wanderTicks;                   // Desvio aleatório depois de ficar preso
+    Uint8 wanderKeys;
+    std::vector<StuckSpot> stuckSpots;
+
+    // Puzzle: peças a colocar à direita da fonte, na ordem
+    std::vector<ComponentType> plan;
+    int planX;
+    int planY;
+    int planDir;                       // +1 à direita da fonte, -1 à esquerda
+    int planStep;
+    bool validated;
+    int puzzleAttempts;
+    PuzzleResult lastResult;
+
+    // Resultado
+    bool completed;
+    bool gaveUp;
+    int completionTicks;
+    int completionFrames;
+    double completionWallMs;
+    int stateTicks[(int)GameState::VICTORY + 1];
+    std::vector<float> frameMs;
+};
+
+#endif // BOT_PLAYER_H
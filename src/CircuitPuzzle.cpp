@@ -1,12 +1,172 @@
 #include "CircuitPuzzle.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include "Trace.h"
+
+// Tamanho da célula (px) em cada nível de zoom
+const int CircuitPuzzle::ZOOM_CELL_SIZES[CircuitPuzzle::ZOOM_LEVELS] = {2, 4, 8, 12, 16, 24, 32, 48, 64};
+
+// Altura da tela fora do tabuleiro: título em cima; inventário e instruções embaixo
+static const int PUZZLE_CHROME_HEIGHT = 240;
+
+// Abaixo deste tamanho de célula os componentes viram blocos coloridos (sem detalhes)
+static const int DETAIL_CELL_SIZE = 24;
+
+// Texels alterados acumulados entre dois DrawLOD; acima disso reenvia a textura inteira
+static const size_t LOD_MAX_PENDING_TEXELS = 4096;
+
+// Grade da folha assets/components.png (índices spriteId do catálogo, linha a linha)
+static const int COMPONENT_SHEET_COLUMNS = 6;
+static const int COMPONENT_SHEET_ROWS = 6;
+
+// Células por bloco nas varreduras do Validate (grids até 128x128 ficam num bloco só)
+static const int VALIDATE_CELL_GRAIN = 16384;
+
+// Parâmetros comuns às funções de desenho do catálogo
+struct ComponentDrawArgs {
+    int x, y, size;       // Área do componente dentro da célula
+    int cx, cy, half;
+    Uint8 ports;          // Portas já na rotação da célula
+    SDL_Color color;      // Cor do catálogo
+    TTF_Font* font;       // Rótulo do catálogo (fonte nula ou texto vazio: sem rótulo)
+    const char* label;
+    SDL_Color labelColor;
+};
+
+typedef void (*ComponentDrawFn)(RenderList& list, const ComponentDrawArgs& a);
+
+static void DrawNothing(RenderList&, const ComponentDrawArgs&) {}
+
+static void DrawWire(RenderList& list, const ComponentDrawArgs& a) {
+    // Um segmento do centro até cada porta
+    list.SetDrawColor(a.color.r, a.color.g, a.color.b, 255);
+    if (a.ports & PORT_N) {
+        list.DrawLine(a.cx, a.y, a.cx, a.cy);
+        list.DrawLine(a.cx - 1, a.y, a.cx - 1, a.cy);
+    }
+    if (a.ports & PORT_S) {
+        list.DrawLine(a.cx, a.cy, a.cx, a.y + a.size);
+        list.DrawLine(a.cx - 1, a.cy, a.cx - 1, a.y + a.size);
+    }
+    if (a.ports & PORT_W) {
+        list.DrawLine(a.x, a.cy, a.cx, a.cy);
+        list.DrawLine(a.x, a.cy - 1, a.cx, a.cy - 1);
+    }
+    if (a.ports & PORT_E) {
+        list.DrawLine(a.cx, a.cy, a.x + a.size, a.cy);
+        list.DrawLine(a.cx, a.cy - 1, a.x + a.size, a.cy - 1);
+    }
+}
+
+static void DrawResistor(RenderList& list, const ComponentDrawArgs& a) {
+    // Corpo do resistor - retângulo com listras
+    list.SetDrawColor(a.color.r, a.color.g, a.color.b, 255);
+    SDL_Rect body = {a.x + 6, a.y + 10, a.size - 12, a.size - 20};
+    list.FillRect(body);
+    // Listras coloridas
+    list.SetDrawColor(150, 50, 50, 255);
+    for (int i = 0; i < 3; i++) {
+        int sx = a.x + 10 + i * 8;
+        list.DrawLine(sx, a.y + 10, sx, a.y + a.size - 10);
+        list.DrawLine(sx + 1, a.y + 10, sx + 1, a.y + a.size - 10);
+    }
+    // Fios do resistor
+    list.SetDrawColor(0, 255, 100, 255);
+    list.DrawLine(a.x, a.cy, a.x + 6, a.cy);
+    list.DrawLine(a.x + a.size - 6, a.cy, a.x + a.size, a.cy);
+}
+
+static void DrawLED(RenderList& list, const ComponentDrawArgs& a) {
+    // Triângulo do LED
+    list.SetDrawColor(a.color.r, a.color.g, a.color.b, 255);
+    for (int i = 0; i < a.half; i++) {
+        int top = a.cy - i;
+        int bot = a.cy + i;
+        list.DrawLine(a.cx - a.half + i, top, a.cx - a.half + i, bot);
+    }
+    // Linha do cátodo
+    list.SetDrawColor(200, 200, 200, 255);
+    list.DrawLine(a.cx + a.half - 4, a.cy - a.half, a.cx + a.half - 4, a.cy + a.half);
+    // Fios
+    list.SetDrawColor(0, 255, 100, 255);
+    list.DrawLine(a.x, a.cy, a.cx - a.half, a.cy);
+    list.DrawLine(a.cx + a.half - 4, a.cy, a.x + a.size, a.cy);
+    // Indicador de polaridade (+/-)
+    if (a.font && a.label[0] != '\0') {
+        SDL_Rect d = {a.x + 2, a.y + 2, 8, 8};
+        list.TextInRect(a.font, a.label, a.labelColor, d);
+    }
+}
+
+static void DrawBattery(RenderList& list, const ComponentDrawArgs& a) {
+    // Bateria com + e -
+    list.SetDrawColor(a.color.r, a.color.g, a.color.b, 255);
+    SDL_Rect body = {a.x + 8, a.y + 6, a.size - 16, a.size - 12};
+    list.FillRect(body);
+    // Polo positivo
+    list.SetDrawColor(255, 200, 0, 255);
+    SDL_Rect plus = {a.x + a.size - 10, a.y + 10, 6, a.size - 20};
+    list.FillRect(plus);
+    // Polo negativo
+    list.SetDrawColor(100, 100, 100, 255);
+    SDL_Rect minus = {a.x + 4, a.y + 14, 6, a.size - 28};
+    list.FillRect(minus);
+    // Texto
+    if (a.font && a.label[0] != '\0') {
+        SDL_Rect d = {a.cx - 10, a.cy - 4, 20, 8};
+        list.TextInRect(a.font, a.label, a.labelColor, d);
+    }
+}
+
+static void DrawSwitch(RenderList& list, const ComponentDrawArgs& a) {
+    list.SetDrawColor(a.color.r, a.color.g, a.color.b, 255);
+    SDL_Rect body = {a.x + 4, a.y + 12, a.size - 8, a.size - 24};
+    list.FillRect(body);
+}
+
+// Tabela de desenho expandida do catálogo (indexada por ComponentType)
+#define CATALOG_DRAW_ENTRY(type, model, ports, polarized, inInventory, stock, sprite, color, invName, label, labelColor, draw) draw,
+static const ComponentDrawFn COMPONENT_DRAW[COMPONENT_COUNT] = {
+    COMPONENT_CATALOG(CATALOG_DRAW_ENTRY)
+};
+#undef CATALOG_DRAW_ENTRY
+
+// Próxima forma com a mesma peça do estoque, na ordem do catálogo (a própria, se for a única)
+static ComponentType NextShape(ComponentType type) {
+    ComponentType stock = GetTraits(type).stock;
+    for (int k = 1; k < COMPONENT_COUNT; ++k) {
+        int candidate = ((int)type + k) % COMPONENT_COUNT;
+        if (COMPONENT_TRAITS[candidate].stock == stock) return (ComponentType)candidate;
+    }
+    return type;
+}
+
+// Forma e rotação de uma peça do estoque cujas portas são exatamente 'ports'
+static bool FindShape(ComponentType stock, Uint8 ports, ComponentType& type, int& rotation) {
+    for (int t = 0; t < COMPONENT_COUNT; ++t) {
+        if (COMPONENT_TRAITS[t].stock != stock) continue;
+        for (int r = 0; r < 4; ++r) {
+            if (COMPONENT_TRAITS[t].ports[r] != ports) continue;
+            type = (ComponentType)t;
+            rotation = r * 90;
+            return true;
+        }
+    }
+    return false;
+}
 
 CircuitPuzzle::CircuitPuzzle()
-    : cursorX(0), cursorY(0), selectedInventory(0),
+    : gridWidth(DEFAULT_GRID_WIDTH), gridHeight(DEFAULT_GRID_HEIGHT),
+      grid(DEFAULT_GRID_WIDTH * DEFAULT_GRID_HEIGHT),
+      cursorX(0), cursorY(0), selectedInventory(0),
       active(false), complete(false), lastResult(PuzzleResult::NONE),
       currentPuzzleId(0), resultTimer(0), cursorBlinkTimer(0),
       cursorVisible(true), burnTimer(0),
+      zoomLevel(DEFAULT_ZOOM), viewX(0), viewY(0), viewportW(0), viewportH(0),
+      lodFactor(1), lodWidth(0), lodHeight(0), lodDirty(true), lodUploaded(false), jobs(nullptr),
+      routing(false), routeStartX(0), routeStartY(0), routeFound(false), routeWiresNeeded(0),
       componentTexture(nullptr), font(nullptr) {
 }
 
@@ -14,7 +174,8 @@ CircuitPuzzle::~CircuitPuzzle() {
     Shutdown();
 }
 
-bool CircuitPuzzle::Initialize(SDL_Renderer* renderer) {
+bool CircuitPuzzle::Initialize() {
+    TRACE_ZONE("CircuitPuzzle::Initialize");
     if (TTF_WasInit() == 0) {
         if (TTF_Init() == -1) {
             std::cerr << "Failed to initialize SDL_ttf: " << TTF_GetError() << "\n";
@@ -22,12 +183,6 @@ bool CircuitPuzzle::Initialize(SDL_Renderer* renderer) {
         }
     }
 
-    font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 8);
-    if (!font) {
-        std::cerr << "Warning: Could not load font: " << TTF_GetError() << "\n";
-        // Continua sem fonte - renderizará sem texto
-    }
-
     return true;
 }
 
@@ -40,56 +195,112 @@ void CircuitPuzzle::LoadPuzzle(int puzzleId) {
     cursorX = 0;
     cursorY = 0;
     selectedInventory = 0;
+    zoomLevel = DEFAULT_ZOOM;
+    viewX = 0;
+    viewY = 0;
 
-    // Limpa grid
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            grid[y][x] = PuzzleCell();
-        }
-    }
+    ResetGrid(DEFAULT_GRID_WIDTH, DEFAULT_GRID_HEIGHT);
     inventory.clear();
 
     // Configura puzzles diferentes baseado no ID
     if (puzzleId == 1) {
         // Puzzle 1: LED simples - precisa de bateria + resistor + LED + fios
         // Bateria fixa na posição (0, 2)
-        grid[2][0].type = ComponentType::BATTERY;
-        grid[2][0].isFixed = true;
+        CellAt(0, 2).type = ComponentType::BATTERY;
+        CellAt(0, 2).isFixed = true;
 
         // Peças disponíveis para o jogador
         inventory.push_back({ComponentType::WIRE, 4});
         inventory.push_back({ComponentType::RESISTOR, 1});
         inventory.push_back({ComponentType::LED, 1});
     }
+
+    CancelRoute();
+    RebuildRouterMask();
+}
+
+void CircuitPuzzle::LoadEmptyGrid(int width, int height) {
+    LoadPuzzle(0);
+    ResetGrid(width, height);
+    CancelRoute();
+    RebuildRouterMask();
+}
+
+void CircuitPuzzle::PlaceFixedComponent(int x, int y, ComponentType type, int rotation) {
+    if (x < 0 || x >= gridWidth || y < 0 || y >= gridHeight) return;
+    PuzzleCell& cell = CellAt(x, y);
+    cell.type = type;
+    cell.rotation = rotation;
+    cell.isFixed = true;
+    MarkCellChanged(x, y);
+}
+
+void CircuitPuzzle::ResetGrid(int width, int height) {
+    gridWidth = width;
+    gridHeight = height;
+    grid.assign(width * height, PuzzleCell());
+    lodDirty = true;
 }
 
 void CircuitPuzzle::Shutdown() {
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
+    // Chamado depois que a thread de render parou: a textura LOD volta a ser da thread principal
+    if (lodTexture.texture) {
+        SDL_DestroyTexture(lodTexture.texture);
+        lodTexture = StreamTexture();
     }
+    font = nullptr;
 }
 
 void CircuitPuzzle::HandleInput(SDL_Event& event) {
     if (!active) return;
 
-    if (event.type == SDL_KEYDOWN && event.key.repeat == 0) {
+    if (event.type != SDL_KEYDOWN) return;
+
+    // Setas aceitam auto-repeat para percorrer tabuleiros grandes; o cursor arrasta a visão
+    switch (event.key.keysym.sym) {
+        case SDLK_UP:
+            if (cursorY > 0) cursorY--;
+            ScrollToCursor();
+            if (routing) UpdateRoute();
+            return;
+        case SDLK_DOWN:
+            if (cursorY < gridHeight - 1) cursorY++;
+            ScrollToCursor();
+            if (routing) UpdateRoute();
+            return;
+        case SDLK_LEFT:
+            if (cursorX > 0) cursorX--;
+            ScrollToCursor();
+            if (routing) UpdateRoute();
+            return;
+        case SDLK_RIGHT:
+            if (cursorX < gridWidth - 1) cursorX++;
+            ScrollToCursor();
+            if (routing) UpdateRoute();
+            return;
+        default:
+            break;
+    }
+
+    if (event.key.repeat == 0) {
         switch (event.key.keysym.sym) {
-            case SDLK_UP:
-                if (cursorY > 0) cursorY--;
+            case SDLK_EQUALS:
+            case SDLK_PLUS:
+            case SDLK_KP_PLUS:
+                SetZoom(zoomLevel + 1);
                 break;
-            case SDLK_DOWN:
-                if (cursorY < GRID_HEIGHT - 1) cursorY++;
+            case SDLK_MINUS:
+            case SDLK_KP_MINUS:
+                SetZoom(zoomLevel - 1);
                 break;
-            case SDLK_LEFT:
-                if (cursorX > 0) cursorX--;
-                break;
-            case SDLK_RIGHT:
-                if (cursorX < GRID_WIDTH - 1) cursorX++;
+            case SDLK_f:
+                if (routing) CancelRoute();
+                else BeginRoute();
                 break;
             case SDLK_SPACE:
             case SDLK_RETURN:
-                PlaceComponent();
+                if (routing) CommitRoute();
+                else PlaceComponent();
                 break;
             case SDLK_r:
                 RotateComponent();
@@ -111,10 +322,10 @@ void CircuitPuzzle::HandleInput(SDL_Event& event) {
                 if (lastResult == PuzzleResult::NO_RESISTOR) {
                     burnTimer = 2.0f;
                     // Marca LEDs como queimando
-                    for (int y = 0; y < GRID_HEIGHT; ++y) {
-                        for (int x = 0; x < GRID_WIDTH; ++x) {
-                            if (grid[y][x].type == ComponentType::LED) {
-                                grid[y][x].isBurning = true;
+                    for (int y = 0; y < gridHeight; ++y) {
+                        for (int x = 0; x < gridWidth; ++x) {
+                            if (GetTraits(CellAt(x, y).type).model == ElectricalModel::LOAD) {
+                                CellAt(x, y).isBurning = true;
                             }
                         }
                     }
@@ -124,7 +335,9 @@ void CircuitPuzzle::HandleInput(SDL_Event& event) {
                 }
                 break;
             case SDLK_ESCAPE:
-                Deactivate();
+                // ESC primeiro sai do modo rota; sem rota, sai do puzzle
+                if (routing) CancelRoute();
+                else Deactivate();
                 break;
         }
     }
@@ -148,9 +361,9 @@ void CircuitPuzzle::Update(float deltaTime) {
             // Reseta visuais de queima
             if (burnTimer > 0) {
                 burnTimer = 0;
-                for (int y = 0; y < GRID_HEIGHT; ++y) {
-                    for (int x = 0; x < GRID_WIDTH; ++x) {
-                        grid[y][x].isBurning = false;
+                for (int y = 0; y < gridHeight; ++y) {
+                    for (int x = 0; x < gridWidth; ++x) {
+                        CellAt(x, y).isBurning = false;
                     }
                 }
             }
@@ -163,265 +376,353 @@ void CircuitPuzzle::Update(float deltaTime) {
     }
 }
 
-void CircuitPuzzle::Render(SDL_Renderer* renderer, int screenW, int screenH) {
+void CircuitPuzzle::Render(RenderList& list, int screenW, int screenH) {
     if (!active) return;
 
     // Fundo semi-transparente escuro
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 10, 10, 30, 220);
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    list.SetDrawColor(10, 10, 30, 220);
     SDL_Rect fullscreen = {0, 0, screenW, screenH};
-    SDL_RenderFillRect(renderer, &fullscreen);
+    list.FillRect(fullscreen);
+
+    // Área visível: o tabuleiro inteiro se couber, senão a janela máxima (rolada pelo cursor)
+    int cellSize = GetCellSize();
+    int maxViewportW = screenW - 80;
+    int maxViewportH = std::max(DEFAULT_GRID_HEIGHT * ZOOM_CELL_SIZES[DEFAULT_ZOOM], screenH - PUZZLE_CHROME_HEIGHT);
+    viewportW = std::min(gridWidth * cellSize, maxViewportW);
+    viewportH = std::min(gridHeight * cellSize, maxViewportH);
+    ClampView();
 
-    int cellSize = 48;
-    int gridPixelW = GRID_WIDTH * cellSize;
-    int gridPixelH = GRID_HEIGHT * cellSize;
-    int offsetX = (screenW - gridPixelW) / 2;
-    int offsetY = (screenH - gridPixelH) / 2 - 40;
+    int frameY = (screenH - maxViewportH) / 2 - 40;
+    int offsetX = (screenW - viewportW) / 2;
+    int offsetY = frameY + (maxViewportH - viewportH) / 2;
 
     // Título "MONTAGEM DE CIRCUITO"
-    if (font) {
-        SDL_Color white = {255, 255, 255, 255};
-        SDL_Surface* surf = TTF_RenderText_Solid(font, "MONTAGEM DE CIRCUITO", white);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            int tw = surf->w * 2;
-            int th = surf->h * 2;
-            SDL_Rect dst = {(screenW - tw) / 2, offsetY - 40, tw, th};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
-    }
+    SDL_Color white = {255, 255, 255, 255};
+    list.Text(font, "MONTAGEM DE CIRCUITO", white, screenW / 2, frameY - 40, TEXT_CENTER | TEXT_TOP, 2);
 
     // Fundo do grid
-    SDL_SetRenderDrawColor(renderer, 20, 25, 50, 255);
-    SDL_Rect gridBg = {offsetX - 4, offsetY - 4, gridPixelW + 8, gridPixelH + 8};
-    SDL_RenderFillRect(renderer, &gridBg);
+    list.SetDrawColor(20, 25, 50, 255);
+    SDL_Rect gridBg = {offsetX - 4, offsetY - 4, viewportW + 8, viewportH + 8};
+    list.FillRect(gridBg);
 
     // Borda neon do grid
-    SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-    SDL_RenderDrawRect(renderer, &gridBg);
-    SDL_Rect gridBg2 = {offsetX - 3, offsetY - 3, gridPixelW + 6, gridPixelH + 6};
-    SDL_RenderDrawRect(renderer, &gridBg2);
+    list.SetDrawColor(0, 200, 255, 255);
+    list.DrawRect(gridBg);
+    SDL_Rect gridBg2 = {offsetX - 3, offsetY - 3, viewportW + 6, viewportH + 6};
+    list.DrawRect(gridBg2);
+
+    // Origem do tabuleiro na tela; tudo fora do viewport é recortado
+    int originX = offsetX - viewX;
+    int originY = offsetY - viewY;
+    SDL_Rect viewport = {offsetX, offsetY, viewportW, viewportH};
+    list.SetClipRect(&viewport);
+    if (cellSize < LOD_CELL_SIZE) {
+        DrawLOD(list, originX, originY, cellSize);
+    } else {
+        DrawGrid(list, originX, originY, cellSize);
+    }
+    DrawRoute(list, originX, originY, cellSize);
+    DrawCursor(list, originX, originY, cellSize);
+    list.SetClipRect(nullptr);
 
-    DrawGrid(renderer, offsetX, offsetY, cellSize);
-    DrawCursor(renderer, offsetX, offsetY, cellSize);
-    DrawInventory(renderer, offsetX, offsetY + gridPixelH + 20);
-    DrawResultFeedback(renderer, screenW, screenH);
+    DrawInventory(list, (screenW - DEFAULT_GRID_WIDTH * ZOOM_CELL_SIZES[DEFAULT_ZOOM]) / 2,
+                  frameY + maxViewportH + 20);
+    DrawResultFeedback(list, screenW, screenH);
 
     // Instruções na parte inferior - Duas linhas
-    if (font) {
-        SDL_Color gray = {150, 150, 150, 255};
-        const char* inst1 = "[SETAS] Mover  [SPACE] Colocar  [R] Rotacionar";
-        const char* inst2 = "[TAB] Trocar  [V] Validar  [ESC] Sair";
-        
-        // Linha 1
-        SDL_Surface* surf1 = TTF_RenderText_Solid(font, inst1, gray);
-        if (surf1) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf1);
-            SDL_Rect dst = {(screenW - surf1->w) / 2, screenH - 45, surf1->w, surf1->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf1);
-        }
-        
-        // Linha 2
-        SDL_Surface* surf2 = TTF_RenderText_Solid(font, inst2, gray);
-        if (surf2) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf2);
-            SDL_Rect dst = {(screenW - surf2->w) / 2, screenH - 25, surf2->w, surf2->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf2);
-        }
-    }
+    SDL_Color gray = {150, 150, 150, 255};
+    const char* inst1 = "[SETAS] Mover  [SPACE] Colocar  [R] Rotacionar  [F] Rota";
+    const char* inst2 = "[TAB] Trocar  [V] Validar  [+/-] Zoom  [ESC] Sair";
+    list.Text(font, inst1, gray, screenW / 2, screenH - 45, TEXT_CENTER | TEXT_TOP);
+    list.Text(font, inst2, gray, screenW / 2, screenH - 25, TEXT_CENTER | TEXT_TOP);
 }
 
-void CircuitPuzzle::DrawGrid(SDL_Renderer* renderer, int offsetX, int offsetY, int cellSize) {
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            int px = offsetX + x * cellSize;
-            int py = offsetY + y * cellSize;
+int CircuitPuzzle::GetCellSize() const {
+    return ZOOM_CELL_SIZES[zoomLevel];
+}
 
-            // Fundo da célula
-            SDL_SetRenderDrawColor(renderer, 15, 18, 35, 255);
-            SDL_Rect cell = {px + 1, py + 1, cellSize - 2, cellSize - 2};
-            SDL_RenderFillRect(renderer, &cell);
+void CircuitPuzzle::SetZoom(int level) {
+    if (level < 0) level = 0;
+    if (level >= ZOOM_LEVELS) level = ZOOM_LEVELS - 1;
+    if (level == zoomLevel) return;
+
+    // Mantém o centro da célula do cursor no mesmo ponto da tela
+    int oldCell = GetCellSize();
+    int screenX = cursorX * oldCell + oldCell / 2 - viewX;
+    int screenY = cursorY * oldCell + oldCell / 2 - viewY;
+    zoomLevel = level;
+    int newCell = GetCellSize();
+    viewX = cursorX * newCell + newCell / 2 - screenX;
+    viewY = cursorY * newCell + newCell / 2 - screenY;
+    ClampView();
+}
 
-            // Borda da célula
-            SDL_SetRenderDrawColor(renderer, 40, 50, 80, 255);
-            SDL_RenderDrawRect(renderer, &cell);
+void CircuitPuzzle::ScrollToCursor() {
+    // Rola o mínimo necessário para manter o cursor (mais uma célula de margem) visível
+    int cellSize = GetCellSize();
+    int margin = (viewportW >= 3 * cellSize) ? cellSize : 0;
+    int left = cursorX * cellSize - margin;
+    int right = (cursorX + 1) * cellSize + margin;
+    int top = cursorY * cellSize - margin;
+    int bottom = (cursorY + 1) * cellSize + margin;
+
+    if (left < viewX) viewX = left;
+    else if (right > viewX + viewportW) viewX = right - viewportW;
+    if (top < viewY) viewY = top;
+    else if (bottom > viewY + viewportH) viewY = bottom - viewportH;
+    ClampView();
+}
+
+void CircuitPuzzle::ClampView() {
+    int maxX = gridWidth * GetCellSize() - viewportW;
+    int maxY = gridHeight * GetCellSize() - viewportH;
+    if (viewX > maxX) viewX = maxX;
+    if (viewY > maxY) viewY = maxY;
+    if (viewX < 0) viewX = 0;
+    if (viewY < 0) viewY = 0;
+}
+
+void CircuitPuzzle::DrawGrid(RenderList& list, int offsetX, int offsetY, int cellSize) {
+    // Apenas as células que intersectam o viewport
+    int firstX = viewX / cellSize;
+    int firstY = viewY / cellSize;
+    int lastX = std::min(gridWidth - 1, (viewX + viewportW - 1) / cellSize);
+    int lastY = std::min(gridHeight - 1, (viewY + viewportH - 1) / cellSize);
+
+    // Fundo e borda das células em lote (2 chamadas em vez de 2 por célula)
+    cellRects.clear();
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            cellRects.push_back({offsetX + x * cellSize + 1, offsetY + y * cellSize + 1,
+                                 cellSize - 2, cellSize - 2});
+        }
+    }
+    if (cellRects.empty()) return;
+    list.SetDrawColor(15, 18, 35, 255);
+    list.FillRects(cellRects.data(), (int)cellRects.size());
+    list.SetDrawColor(40, 50, 80, 255);
+    list.DrawRects(cellRects.data(), (int)cellRects.size());
+
+    // Renderiza componentes; em zoom baixo, apenas um bloco colorido
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            const PuzzleCell& pc = CellAt(x, y);
+            if (pc.type == ComponentType::EMPTY) continue;
 
-            // Renderiza componente se houver
-            const PuzzleCell& pc = grid[y][x];
-            if (pc.type != ComponentType::EMPTY) {
-                DrawComponent(renderer, pc.type, pc.rotation,
+            int px = offsetX + x * cellSize;
+            int py = offsetY + y * cellSize;
+            if (cellSize >= DETAIL_CELL_SIZE) {
+                DrawComponent(list, pc.type, pc.rotation,
                              px + 4, py + 4, cellSize - 8,
                              pc.isHighlighted, pc.isBurning);
+            } else {
+                SDL_Color c = pc.isBurning ? SDL_Color{255, 50, 0, 255} : GetTraits(pc.type).color;
+                list.SetDrawColor(c.r, c.g, c.b, 255);
+                SDL_Rect block = {px + 2, py + 2, cellSize - 4, cellSize - 4};
+                list.FillRect(block);
             }
         }
     }
 }
 
-void CircuitPuzzle::DrawComponent(SDL_Renderer* renderer, ComponentType type, int rotation,
-                                   int x, int y, int size, bool highlighted, bool burning) {
-    int cx = x + size / 2;
-    int cy = y + size / 2;
-    int half = size / 2 - 2;
-
-    if (burning) {
-        // Efeito de queima - vermelho pulsante
-        float pulse = std::sin(burnTimer * 10.0f) * 0.5f + 0.5f;
-        Uint8 r = (Uint8)(200 + pulse * 55);
-        SDL_SetRenderDrawColor(renderer, r, 50, 0, 255);
-        SDL_Rect burnRect = {x, y, size, size};
-        SDL_RenderFillRect(renderer, &burnRect);
-    }
-
-    switch (type) {
-        case ComponentType::WIRE: {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 100, 255);
-            // Fio horizontal ou vertical dependendo da rotação
-            if (rotation == 0 || rotation == 180) {
-                SDL_RenderDrawLine(renderer, x, cy, x + size, cy);
-                SDL_RenderDrawLine(renderer, x, cy - 1, x + size, cy - 1);
-            } else {
-                SDL_RenderDrawLine(renderer, cx, y, cx, y + size);
-                SDL_RenderDrawLine(renderer, cx - 1, y, cx - 1, y + size);
-            }
-            break;
+void CircuitPuzzle::MarkCellChanged(int x, int y) {
+    router.SetBlocked(x, y, CellAt(x, y).type != ComponentType::EMPTY);
+
+    // Pixels ainda não calculados ou já marcados para reconstrução: nada a fazer agora
+    if (lodPixels.empty() || lodDirty) return;
+    UpdateLODTexel(x / lodFactor, y / lodFactor);
+}
+
+void CircuitPuzzle::UpdateLODTexel(int lx, int ly) {
+    // O texel assume o componente "mais importante" do bloco (maior valor do enum)
+    int best = (int)ComponentType::EMPTY;
+    int endX = std::min(gridWidth, (lx + 1) * lodFactor);
+    int endY = std::min(gridHeight, (ly + 1) * lodFactor);
+    for (int y = ly * lodFactor; y < endY; ++y) {
+        for (int x = lx * lodFactor; x < endX; ++x) {
+            best = std::max(best, (int)CellAt(x, y).type);
         }
-        case ComponentType::RESISTOR: {
-            // Corpo do resistor - retângulo com listras
-            SDL_SetRenderDrawColor(renderer, 200, 150, 50, 255);
-            SDL_Rect body = {x + 6, y + 10, size - 12, size - 20};
-            SDL_RenderFillRect(renderer, &body);
-            // Listras coloridas
-            SDL_SetRenderDrawColor(renderer, 150, 50, 50, 255);
-            for (int i = 0; i < 3; i++) {
-                int sx = x + 10 + i * 8;
-                SDL_RenderDrawLine(renderer, sx, y + 10, sx, y + size - 10);
-                SDL_RenderDrawLine(renderer, sx + 1, y + 10, sx + 1, y + size - 10);
-            }
-            // Fios do resistor
-            SDL_SetRenderDrawColor(renderer, 0, 255, 100, 255);
-            SDL_RenderDrawLine(renderer, x, cy, x + 6, cy);
-            SDL_RenderDrawLine(renderer, x + size - 6, cy, x + size, cy);
-            break;
+    }
+
+    SDL_Color c = COMPONENT_TRAITS[best].color;
+    Uint8* texel = &lodPixels[(ly * lodWidth + lx) * 4];
+    texel[0] = c.r;
+    texel[1] = c.g;
+    texel[2] = c.b;
+    texel[3] = 255;
+
+    // Depois do envio inteiro, só os texels alterados sobem no próximo DrawLOD
+    if (lodUploaded && !lodDirty) {
+        if (lodPendingTexels.size() >= LOD_MAX_PENDING_TEXELS) {
+            lodUploaded = false;
+            lodPendingTexels.clear();
+        } else {
+            lodPendingTexels.push_back({lx, ly});
         }
-        case ComponentType::LED: {
-            // Triângulo do LED
-            SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
-            for (int i = 0; i < half; i++) {
-                int top = cy - i;
-                int bot = cy + i;
-                SDL_RenderDrawLine(renderer, cx - half + i, top, cx - half + i, bot);
-            }
-            // Linha do cátodo
-            SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-            SDL_RenderDrawLine(renderer, cx + half - 4, cy - half, cx + half - 4, cy + half);
-            // Fios
-            SDL_SetRenderDrawColor(renderer, 0, 255, 100, 255);
-            SDL_RenderDrawLine(renderer, x, cy, cx - half, cy);
-            SDL_RenderDrawLine(renderer, cx + half - 4, cy, x + size, cy);
-            // Indicador de polaridade (+/-)
-            if (font) {
-                SDL_Color red = {255, 100, 100, 255};
-                SDL_Surface* s = TTF_RenderText_Solid(font, "+", red);
-                if (s) {
-                    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                    SDL_Rect d = {x + 2, y + 2, 8, 8};
-                    SDL_RenderCopy(renderer, t, nullptr, &d);
-                    SDL_DestroyTexture(t);
-                    SDL_FreeSurface(s);
-                }
-            }
-            break;
+    }
+}
+
+void CircuitPuzzle::RebuildLODTexture() {
+    // Fator de redução potência de 2 para caber no limite de textura
+    int factor = 1;
+    while ((gridWidth + factor - 1) / factor > LOD_MAX_TEXTURE_SIZE ||
+           (gridHeight + factor - 1) / factor > LOD_MAX_TEXTURE_SIZE) {
+        factor *= 2;
+    }
+    int w = (gridWidth + factor - 1) / factor;
+    int h = (gridHeight + factor - 1) / factor;
+
+    lodFactor = factor;
+    lodWidth = w;
+    lodHeight = h;
+    lodPixels.assign(w * h * 4, 0);
+    lodUploaded = false;
+    lodPendingTexels.clear();
+
+    for (int ly = 0; ly < h; ++ly) {
+        for (int lx = 0; lx < w; ++lx) {
+            UpdateLODTexel(lx, ly);
         }
-        case ComponentType::BATTERY: {
-            // Bateria com + e -
-            SDL_SetRenderDrawColor(renderer, 50, 200, 255, 255);
-            SDL_Rect body = {x + 8, y + 6, size - 16, size - 12};
-            SDL_RenderFillRect(renderer, &body);
-            // Polo positivo
-            SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
-            SDL_Rect plus = {x + size - 10, y + 10, 6, size - 20};
-            SDL_RenderFillRect(renderer, &plus);
-            // Polo negativo
-            SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-            SDL_Rect minus = {x + 4, y + 14, 6, size - 28};
-            SDL_RenderFillRect(renderer, &minus);
-            // Texto
-            if (font) {
-                SDL_Color yellow = {255, 255, 0, 255};
-                SDL_Surface* s = TTF_RenderText_Solid(font, "BAT", yellow);
-                if (s) {
-                    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                    SDL_Rect d = {cx - 10, cy - 4, 20, 8};
-                    SDL_RenderCopy(renderer, t, nullptr, &d);
-                    SDL_DestroyTexture(t);
-                    SDL_FreeSurface(s);
-                }
-            }
-            break;
+    }
+    lodDirty = false;
+}
+
+void CircuitPuzzle::DrawLOD(RenderList& list, int offsetX, int offsetY, int cellSize) {
+    if (lodDirty || lodPixels.empty()) RebuildLODTexture();
+
+    // A thread de render cria/redimensiona a textura no primeiro envio
+    if (!lodUploaded) {
+        list.UploadTexture(lodTexture, lodWidth, lodHeight, nullptr, lodPixels.data(), lodWidth * 4);
+        lodUploaded = true;
+    } else {
+        for (const SDL_Point& t : lodPendingTexels) {
+            SDL_Rect r = {t.x, t.y, 1, 1};
+            list.UploadTexture(lodTexture, lodWidth, lodHeight, &r, &lodPixels[(t.y * lodWidth + t.x) * 4], lodWidth * 4);
         }
-        case ComponentType::SWITCH_COMP: {
-            SDL_SetRenderDrawColor(renderer, 200, 200, 0, 255);
-            SDL_Rect body = {x + 4, y + 12, size - 8, size - 24};
-            SDL_RenderFillRect(renderer, &body);
-            break;
+    }
+    lodPendingTexels.clear();
+
+    // A textura inteira é escalada para o tamanho do tabuleiro; o clip rect corta o excedente
+    int texelSize = lodFactor * cellSize;
+    SDL_Rect dst = {offsetX, offsetY, lodWidth * texelSize, lodHeight * texelSize};
+    list.CopyStream(lodTexture, nullptr, &dst);
+}
+
+void CircuitPuzzle::DrawComponent(RenderList& list, ComponentType type, int rotation,
+                                   int x, int y, int size, bool highlighted, bool burning) {
+    const ComponentTraits& traits = GetTraits(type);
+
+    // Efeito de queima - vermelho pulsante
+    float pulse = std::sin(burnTimer * 10.0f) * 0.5f + 0.5f;
+    Uint8 burnRed = (Uint8)(200 + pulse * 55);
+    SDL_Rect cellRect = {x, y, size, size};
+    bool sprite = componentTexture && traits.spriteId >= 0;
+    if (burning && !sprite) {
+        list.SetDrawColor(burnRed, 50, 0, 255);
+        list.FillRect(cellRect);
+    }
+
+    if (sprite) {
+        // Sprite da folha de componentes, girado conforme a célula
+        int sheetW = 0, sheetH = 0;
+        SDL_QueryTexture(componentTexture, nullptr, nullptr, &sheetW, &sheetH);
+        int spriteW = sheetW / COMPONENT_SHEET_COLUMNS;
+        int spriteH = sheetH / COMPONENT_SHEET_ROWS;
+        SDL_Rect src = {(traits.spriteId % COMPONENT_SHEET_COLUMNS) * spriteW,
+                        (traits.spriteId / COMPONENT_SHEET_COLUMNS) * spriteH, spriteW, spriteH};
+        list.CopyEx(componentTexture, &src, &cellRect, rotation);
+        // A folha é opaca: queima e rótulo vão por cima do sprite
+        if (burning) {
+            list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+            list.SetDrawColor(burnRed, 50, 0, 150);
+            list.FillRect(cellRect);
         }
-        default:
-            break;
+        if (font && traits.label[0] != '\0') {
+            SDL_Rect labelRect = {x + 2, y + 2, 8 * (int)std::strlen(traits.label), 8};
+            list.TextInRect(font, traits.label, traits.labelColor, labelRect);
+        }
+    } else {
+        ComponentDrawArgs args;
+        args.x = x;
+        args.y = y;
+        args.size = size;
+        args.cx = x + size / 2;
+        args.cy = y + size / 2;
+        args.half = size / 2 - 2;
+        args.ports = GetPorts(type, rotation);
+        args.color = traits.color;
+        args.font = font;
+        args.label = traits.label;
+        args.labelColor = traits.labelColor;
+        COMPONENT_DRAW[(int)type](list, args);
     }
 
     // Borda de highlight
     if (highlighted) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 180);
+        list.SetDrawColor(255, 255, 0, 180);
         SDL_Rect hl = {x - 2, y - 2, size + 4, size + 4};
-        SDL_RenderDrawRect(renderer, &hl);
+        list.DrawRect(hl);
     }
 }
 
-void CircuitPuzzle::DrawCursor(SDL_Renderer* renderer, int offsetX, int offsetY, int cellSize) {
+void CircuitPuzzle::DrawRoute(RenderList& list, int offsetX, int offsetY, int cellSize) {
+    if (!routing) return;
+
+    // Origem da rota
+    list.SetDrawColor(255, 0, 255, 255);
+    SDL_Rect startRect = {offsetX + routeStartX * cellSize, offsetY + routeStartY * cellSize, cellSize, cellSize};
+    list.DrawRect(startRect);
+
+    if (!routeFound) return;
+
+    // Prévia: ciano se há fios suficientes no inventário, vermelho se não
+    int wiresLeft = 0;
+    for (const auto& item : inventory) {
+        if (item.type == ComponentType::WIRE) wiresLeft = item.count;
+    }
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    if (routeWiresNeeded <= wiresLeft) list.SetDrawColor(0, 255, 255, 110);
+    else list.SetDrawColor(255, 40, 40, 110);
+
+    int inset = cellSize >= 8 ? cellSize / 4 : 0;
+    for (int cell : routePath) {
+        int x = cell % gridWidth;
+        int y = cell / gridWidth;
+        if ((x + 1) * cellSize <= viewX || x * cellSize >= viewX + viewportW) continue;
+        if ((y + 1) * cellSize <= viewY || y * cellSize >= viewY + viewportH) continue;
+        int px = offsetX + x * cellSize;
+        int py = offsetY + y * cellSize;
+        SDL_Rect r = {px + inset, py + inset, cellSize - 2 * inset, cellSize - 2 * inset};
+        list.FillRect(r);
+    }
+}
+
+void CircuitPuzzle::DrawCursor(RenderList& list, int offsetX, int offsetY, int cellSize) {
     if (!cursorVisible) return;
 
     int px = offsetX + cursorX * cellSize;
     int py = offsetY + cursorY * cellSize;
 
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+    list.SetDrawColor(255, 255, 0, 255);
     SDL_Rect cursor = {px, py, cellSize, cellSize};
-    SDL_RenderDrawRect(renderer, &cursor);
+    list.DrawRect(cursor);
     SDL_Rect cursor2 = {px + 1, py + 1, cellSize - 2, cellSize - 2};
-    SDL_RenderDrawRect(renderer, &cursor2);
+    list.DrawRect(cursor2);
 }
 
-void CircuitPuzzle::DrawInventory(SDL_Renderer* renderer, int offsetX, int offsetY) {
+void CircuitPuzzle::DrawInventory(RenderList& list, int offsetX, int offsetY) {
     if (!font) return;
 
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color cyan = {0, 255, 255, 255};
 
-    SDL_Surface* label = TTF_RenderText_Solid(font, "PECAS:", white);
-    if (label) {
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, label);
-        SDL_Rect dst = {offsetX, offsetY, label->w, label->h};
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_DestroyTexture(tex);
-        SDL_FreeSurface(label);
-    }
+    list.Text(font, "PECAS:", white, offsetX, offsetY);
 
     int ix = offsetX;
     int iy = offsetY + 16;
     for (int i = 0; i < (int)inventory.size(); ++i) {
-        const char* name = "";
-        switch (inventory[i].type) {
-            case ComponentType::WIRE: name = "FIO"; break;
-            case ComponentType::RESISTOR: name = "RESISTOR"; break;
-            case ComponentType::LED: name = "LED"; break;
-            case ComponentType::SWITCH_COMP: name = "CHAVE"; break;
-            default: name = "???"; break;
-        }
+        const char* name = GetTraits(inventory[i].type).inventoryName;
 
         char buf[64];
         snprintf(buf, sizeof(buf), "%s%s x%d",
@@ -429,18 +730,11 @@ void CircuitPuzzle::DrawInventory(SDL_Renderer* renderer, int offsetX, int offse
                  name, inventory[i].count);
 
         SDL_Color col = (i == selectedInventory) ? cyan : white;
-        SDL_Surface* surf = TTF_RenderText_Solid(font, buf, col);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_Rect dst = {ix, iy + i * 14, surf->w, surf->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
+        list.Text(font, buf, col, ix, iy + i * 14);
     }
 }
 
-void CircuitPuzzle::DrawResultFeedback(SDL_Renderer* renderer, int screenW, int screenH) {
+void CircuitPuzzle::DrawResultFeedback(RenderList& list, int screenW, int screenH) {
     if (resultTimer <= 0) return;
 
     const char* msg = "";
@@ -470,145 +764,229 @@ void CircuitPuzzle::DrawResultFeedback(SDL_Renderer* renderer, int screenW, int
     if (!font) return;
 
     // Fundo da mensagem
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    list.SetDrawColor(0, 0, 0, 180);
     SDL_Rect msgBg = {screenW / 2 - 200, screenH / 2 - 30, 400, 60};
-    SDL_RenderFillRect(renderer, &msgBg);
+    list.FillRect(msgBg);
 
     // Borda colorida
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
-    SDL_RenderDrawRect(renderer, &msgBg);
+    list.SetDrawColor(color.r, color.g, color.b, 255);
+    list.DrawRect(msgBg);
+
+    list.Text(font, msg, color, screenW / 2, screenH / 2, TEXT_CENTER | TEXT_MIDDLE, 2);
+}
+
+void CircuitPuzzle::RebuildRouterMask() {
+    router.Resize(gridWidth, gridHeight);
+    for (int y = 0; y < gridHeight; ++y) {
+        for (int x = 0; x < gridWidth; ++x) {
+            if (CellAt(x, y).type != ComponentType::EMPTY) router.SetBlocked(x, y, true);
+        }
+    }
+}
 
-    SDL_Surface* surf = TTF_RenderText_Solid(font, msg, color);
-    if (surf) {
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-        int tw = surf->w * 2;
-        int th = surf->h * 2;
-        SDL_Rect dst = {screenW / 2 - tw / 2, screenH / 2 - th / 2, tw, th};
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_DestroyTexture(tex);
-        SDL_FreeSurface(surf);
+void CircuitPuzzle::BeginRoute() {
+    // A rota sempre parte de um terminal (célula com componente)
+    if (CellAt(cursorX, cursorY).type == ComponentType::EMPTY) return;
+    routing = true;
+    routeStartX = cursorX;
+    routeStartY = cursorY;
+    UpdateRoute();
+}
+
+void CircuitPuzzle::CancelRoute() {
+    routing = false;
+    routeFound = false;
+    routeWiresNeeded = 0;
+    routePath.clear();
+}
+
+void CircuitPuzzle::UpdateRoute() {
+    // A rota liga dois terminais: com o cursor numa célula vazia não há destino
+    routeFound = CellAt(cursorX, cursorY).type != ComponentType::EMPTY &&
+                 router.FindPath(routeStartX, routeStartY, cursorX, cursorY, routePath);
+    if (!routeFound) routePath.clear();
+    routeWiresNeeded = 0;
+    for (int cell : routePath) {
+        if (grid[cell].type == ComponentType::EMPTY) routeWiresNeeded++;
     }
 }
 
+void CircuitPuzzle::CommitRoute() {
+    if (!routeFound) return;
+
+    InventoryItem* wires = nullptr;
+    for (auto& item : inventory) {
+        if (item.type == ComponentType::WIRE) wires = &item;
+    }
+    if (!wires || wires->count < routeWiresNeeded) {
+        std::cout << "[PUZZLE] Fios insuficientes para a rota (" << routeWiresNeeded << " necessarios)\n";
+        return;
+    }
+
+    // Cada fio liga a célula anterior da rota à seguinte: reto ou curva, na rotação certa.
+    // A última célula é o terminal de destino, então toda célula vazia tem uma seguinte
+    auto portToward = [this](int from, int to) {
+        int dx = to % gridWidth - from % gridWidth;
+        int dy = to / gridWidth - from / gridWidth;
+        return (Uint8)(dx > 0 ? PORT_E : dx < 0 ? PORT_W : dy > 0 ? PORT_S : PORT_N);
+    };
+    int prev = routeStartY * gridWidth + routeStartX;
+    for (size_t i = 0; i < routePath.size(); ++i) {
+        int cell = routePath[i];
+        PuzzleCell& pc = grid[cell];
+        if (pc.type == ComponentType::EMPTY && i + 1 < routePath.size()) {
+            Uint8 ports = portToward(cell, prev) | portToward(cell, routePath[i + 1]);
+            if (FindShape(ComponentType::WIRE, ports, pc.type, pc.rotation)) {
+                wires->count--;
+                MarkCellChanged(cell % gridWidth, cell / gridWidth);
+            }
+        }
+        prev = cell;
+    }
+    CancelRoute();
+}
+
 void CircuitPuzzle::PlaceComponent() {
-    PuzzleCell& cell = grid[cursorY][cursorX];
+    PuzzleCell& cell = CellAt(cursorX, cursorY);
     if (cell.isFixed || cell.type != ComponentType::EMPTY) return;
     if (inventory.empty() || selectedInventory >= (int)inventory.size()) return;
 
     InventoryItem& item = inventory[selectedInventory];
-    if (item.count <= 0) return;
+    if (item.count <= 0 || !GetTraits(item.type).inInventory) return;
 
     cell.type = item.type;
     cell.rotation = 0;
     item.count--;
+    MarkCellChanged(cursorX, cursorY);
 }
 
 void CircuitPuzzle::RotateComponent() {
-    PuzzleCell& cell = grid[cursorY][cursorX];
+    PuzzleCell& cell = CellAt(cursorX, cursorY);
     if (cell.isFixed || cell.type == ComponentType::EMPTY) return;
 
-    cell.rotation = (cell.rotation + 90) % 360;
+    // Passada a última rotação distinta, troca para a próxima forma da mesma peça (reto -> curva)
+    int next = (cell.rotation + 90) % 360;
+    ComponentType shape = NextShape(cell.type);
+    bool repeats = next == 0 || (!GetTraits(cell.type).polarized && GetPorts(cell.type, next) == GetPorts(cell.type, 0));
+    if (shape != cell.type && repeats) {
+        cell.type = shape;
+        next = 0;
+        MarkCellChanged(cursorX, cursorY);
+    }
+    cell.rotation = next;
 }
 
 void CircuitPuzzle::RemoveComponent() {
-    PuzzleCell& cell = grid[cursorY][cursorX];
-    if (cell.isFixed || cell.type == ComponentType::EMPTY) return;
+    PuzzleCell& cell = CellAt(cursorX, cursorY);
+    if (cell.isFixed || !GetTraits(cell.type).inInventory) return;
 
-    // Devolve ao inventário
+    // Devolve ao inventário (curvas voltam como fio)
     for (auto& item : inventory) {
-        if (item.type == cell.type) {
+        if (item.type == GetTraits(cell.type).stock) {
             item.count++;
             break;
         }
     }
     cell.type = ComponentType::EMPTY;
     cell.rotation = 0;
+    MarkCellChanged(cursorX, cursorY);
 }
 
 PuzzleResult CircuitPuzzle::Validate() {
-    // Tenta rastrear o circuito da bateria até completar o loop
-    bool hasResistor = false;
-    bool ledCorrectPolarity = true;
-
-    bool foundBattery = false;
-    bool foundLED = false;
+    TRACE_ZONE("CircuitPuzzle::Validate");
+    // Tenta rastrear o circuito da bateria até completar o loop.
+    // Tudo via tabelas do catálogo: nenhum switch por tipo no laço
+    int modelCount[(int)ElectricalModel::COUNT] = {};
+    bool ledInverted = false;
     bool circuitComplete = false;
 
-    // Encontra a bateria
-    int batX = -1, batY = -1;
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            if (grid[y][x].type == ComponentType::BATTERY) {
-                batX = x;
-                batY = y;
-                foundBattery = true;
-            }
-            if (grid[y][x].type == ComponentType::RESISTOR) hasResistor = true;
-            if (grid[y][x].type == ComponentType::LED) foundLED = true;
+    // Encontra a bateria (fonte) e conta os papéis elétricos, bloco a bloco
+    int sourceCell = -1;
+    int cellCount = gridWidth * gridHeight;
+    int blockCount = (cellCount + VALIDATE_CELL_GRAIN - 1) / VALIDATE_CELL_GRAIN;
+    validateBlocks.assign(blockCount, ValidateBlock());
+    auto countRange = [this](int begin, int end) {
+        ValidateBlock& block = validateBlocks[begin / VALIDATE_CELL_GRAIN];
+        block.sourceCell = -1;
+        for (int i = begin; i < end; ++i) {
+            const PuzzleCell& cell = grid[i];
+            const ComponentTraits& traits = GetTraits(cell.type);
+            block.modelCount[(int)traits.model]++;
+            if (traits.model == ElectricalModel::SOURCE) block.sourceCell = i;
+            // Polaridade invertida (simplificado: componente polarizado girado 180 graus)
+            block.ledInverted |= traits.polarized && cell.rotation == 180;
         }
+    };
+    if (jobs) jobs->ParallelFor(cellCount, VALIDATE_CELL_GRAIN, countRange);
+    else countRange(0, cellCount);
+
+    // Em ordem de bloco: a última fonte do grid vence, como na varredura linear
+    for (const ValidateBlock& block : validateBlocks) {
+        for (int m = 0; m < (int)ElectricalModel::COUNT; ++m) modelCount[m] += block.modelCount[m];
+        if (block.sourceCell >= 0) sourceCell = block.sourceCell;
+        ledInverted |= block.ledInverted;
     }
 
-    if (!foundBattery) return PuzzleResult::OPEN_CIRCUIT;
+    if (sourceCell < 0) return PuzzleResult::OPEN_CIRCUIT;
 
     // Tenta seguir o caminho da bateria
     // Simplificação: verifica se existe uma cadeia conectada de componentes
     // que inclui bateria + LED + fios, formando um loop
-    bool visited[5][7] = {};
+    validateVisited.assign(cellCount, 0);
+    validateQueue.clear();
     int pathLength = 0;
 
     // BFS simples para rastrear conectividade
-    struct Pos { int x, y; };
-    std::vector<Pos> queue;
-    queue.push_back({batX, batY});
-    visited[batY][batX] = true;
-
-    while (!queue.empty()) {
-        Pos cur = queue.front();
-        queue.erase(queue.begin());
+    validateQueue.push_back(sourceCell);
+    validateVisited[sourceCell] = 1;
+
+    for (size_t head = 0; head < validateQueue.size(); ++head) {
+        int cur = validateQueue[head];
+        int cx = cur % gridWidth;
+        int cy = cur / gridWidth;
         pathLength++;
 
-        // Verifica vizinhos
-        int dx[] = {0, 0, -1, 1};
-        int dy[] = {-1, 1, 0, 0};
+        // Vizinhos ligados: porta da célula atual virada para ele e a porta oposta do lado de lá
+        static const int dx[] = {0, 0, -1, 1};
+        static const int dy[] = {-1, 1, 0, 0};
+        static const Uint8 toward[] = {PORT_N, PORT_S, PORT_W, PORT_E};
+        static const Uint8 facing[] = {PORT_S, PORT_N, PORT_E, PORT_W};
+        Uint8 ports = GetPorts(grid[cur].type, grid[cur].rotation);
         for (int d = 0; d < 4; ++d) {
-            int nx = cur.x + dx[d];
-            int ny = cur.y + dy[d];
-            if (nx < 0 || nx >= GRID_WIDTH || ny < 0 || ny >= GRID_HEIGHT) continue;
-            if (visited[ny][nx]) continue;
-            if (grid[ny][nx].type == ComponentType::EMPTY) continue;
-
-            visited[ny][nx] = true;
-            queue.push_back({nx, ny});
+            if (!(ports & toward[d])) continue;
+            int nx = cx + dx[d];
+            int ny = cy + dy[d];
+            if (nx < 0 || nx >= gridWidth || ny < 0 || ny >= gridHeight) continue;
+            int next = ny * gridWidth + nx;
+            if (validateVisited[next]) continue;
+            if (!(GetPorts(grid[next].type, grid[next].rotation) & facing[d])) continue;
+
+            validateVisited[next] = 1;
+            validateQueue.push_back(next);
         }
     }
 
     // Verifica se todos os componentes estão conectados
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            if (grid[y][x].type != ComponentType::EMPTY && !visited[y][x]) {
-                return PuzzleResult::OPEN_CIRCUIT;
-            }
+    auto connectedRange = [this](int begin, int end) {
+        ValidateBlock& block = validateBlocks[begin / VALIDATE_CELL_GRAIN];
+        for (int i = begin; i < end && !block.disconnected; ++i) {
+            block.disconnected = GetTraits(grid[i].type).conducts && !validateVisited[i];
         }
+    };
+    if (jobs) jobs->ParallelFor(cellCount, VALIDATE_CELL_GRAIN, connectedRange);
+    else connectedRange(0, cellCount);
+    for (const ValidateBlock& block : validateBlocks) {
+        if (block.disconnected) return PuzzleResult::OPEN_CIRCUIT;
     }
 
-    if (!foundLED) return PuzzleResult::OPEN_CIRCUIT;
+    if (modelCount[(int)ElectricalModel::LOAD] == 0) return PuzzleResult::OPEN_CIRCUIT;
 
     // Verifica se tem resistor
-    if (!hasResistor) return PuzzleResult::NO_RESISTOR;
+    if (modelCount[(int)ElectricalModel::LIMITER] == 0) return PuzzleResult::NO_RESISTOR;
 
     // Verifica polaridade do LED (simplificado: LED deve ter polo + virado para bateria)
-    // Verificação simples baseada na rotação
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            if (grid[y][x].type == ComponentType::LED) {
-                // Se LED está invertido (rotação 180)
-                if (grid[y][x].rotation == 180) {
-                    return PuzzleResult::INVERTED;
-                }
-            }
-        }
-    }
+    if (ledInverted) return PuzzleResult::INVERTED;
 
     // Se tem bateria, LED, resistor e está tudo conectado => correto!
     if (pathLength >= 3) {
@@ -5,16 +5,10 @@
 #include <SDL2/SDL_ttf.h>
 #include <vector>
 #include <string>
-
-// Tipos de componentes que o jogador pode colocar no grid
-enum class ComponentType {
-    EMPTY,
-    WIRE,         // Fio condutor
-    RESISTOR,     // Resistor
-    LED,          // LED (tem polaridade)
-    BATTERY,      // Fonte de energia (já posicionada)
-    SWITCH_COMP   // Chave liga/desliga
-};
+#include "WireRouter.h"
+#include "ComponentCatalog.h"
+#include "JobSystem.h"
+#include "RenderList.h"
 
 // Resultado da validação do circuito
 enum class PuzzleResult {
@@ -42,13 +36,19 @@ public:
     CircuitPuzzle();
     ~CircuitPuzzle();
 
-    bool Initialize(SDL_Renderer* renderer);
+    bool Initialize();
+    void SetFont(TTF_Font* textFont) { font = textFont; } // Do AssetLoader; sem fonte desenha sem texto
+    void SetComponentTexture(SDL_Texture* sheet) { componentTexture = sheet; } // Do AssetLoader; sem folha desenha à mão
+    void SetJobSystem(JobSystem* jobSystem) { jobs = jobSystem; } // Varreduras do Validate em blocos
     void LoadPuzzle(int puzzleId);
+    // Tabuleiro vazio de qualquer tamanho, montado peça a peça (fases geradas e benchmarks)
+    void LoadEmptyGrid(int width, int height);
+    void PlaceFixedComponent(int x, int y, ComponentType type, int rotation = 0);
     void Shutdown();
 
     void HandleInput(SDL_Event& event);
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer, int screenW, int screenH);
+    void Render(RenderList& list, int screenW, int screenH);
 
     PuzzleResult Validate();
     bool IsComplete() const;
@@ -59,11 +59,24 @@ public:
 
     PuzzleResult GetLastResult() const;
 
+    // Leitura do tabuleiro, cursor e inventário (bots de teste jogam olhando só isto)
+    int GetGridWidth() const { return gridWidth; }
+    int GetGridHeight() const { return gridHeight; }
+    ComponentType GetCellType(int x, int y) const { return CellAt(x, y).type; }
+    int GetCursorX() const { return cursorX; }
+    int GetCursorY() const { return cursorY; }
+    int GetSelectedInventory() const { return selectedInventory; }
+    int GetInventorySize() const { return (int)inventory.size(); }
+    ComponentType GetInventoryType(int index) const { return inventory[index].type; }
+    int GetInventoryCount(int index) const { return inventory[index].count; }
+
 private:
-    // Grid do puzzle
-    static const int GRID_WIDTH = 7;
-    static const int GRID_HEIGHT = 5;
-    PuzzleCell grid[5][7];
+    // Grid do puzzle (dimensões definidas por LoadPuzzle, armazenado linha a linha)
+    static const int DEFAULT_GRID_WIDTH = 7;
+    static const int DEFAULT_GRID_HEIGHT = 5;
+    int gridWidth;
+    int gridHeight;
+    std::vector<PuzzleCell> grid;
 
     // Cursor do jogador
     int cursorX;
@@ -89,17 +102,81 @@ private:
     bool cursorVisible;
     float burnTimer;
 
+    // Visão do tabuleiro (zoom + rolagem). viewX/viewY em pixels do tabuleiro no zoom atual
+    static const int ZOOM_LEVELS = 9;
+    static const int ZOOM_CELL_SIZES[ZOOM_LEVELS];
+    static const int DEFAULT_ZOOM = 7;          // 48 px, o tamanho original da célula
+    static const int LOD_CELL_SIZE = 8;         // Abaixo disso desenha a textura LOD
+    static const int LOD_MAX_TEXTURE_SIZE = 2048;
+    int zoomLevel;
+    int viewX;
+    int viewY;
+    int viewportW;   // Área visível do último Render
+    int viewportH;
+
+    // Textura LOD: 1 texel por bloco de lodFactor x lodFactor células. Os pixels ficam aqui;
+    // a textura é da thread de render e recebe o buffer inteiro ou só os texels alterados
+    StreamTexture lodTexture;
+    std::vector<Uint8> lodPixels;
+    int lodFactor;
+    int lodWidth;
+    int lodHeight;
+    bool lodDirty;                   // Pixels precisam ser recalculados (tamanho do grid mudou)
+    bool lodUploaded;                // Buffer inteiro já enviado desde o último recálculo
+    std::vector<SDL_Point> lodPendingTexels;
+    std::vector<SDL_Rect> cellRects; // Buffer reutilizado para desenhar as células visíveis em lote
+
+    // Buffers reutilizados pelo Validate (BFS a partir da fonte)
+    std::vector<Uint8> validateVisited;
+    std::vector<int> validateQueue;
+
+    // Resultado parcial de cada bloco das varreduras do Validate, combinado em ordem de bloco
+    struct ValidateBlock {
+        int modelCount[(int)ElectricalModel::COUNT];
+        int sourceCell;
+        bool ledInverted;
+        bool disconnected;   // Condutor fora do BFS
+    };
+    std::vector<ValidateBlock> validateBlocks;
+    JobSystem* jobs;
+
+    // Modo de rota automática (A*): origem fixada com [F], destino segue o cursor
+    WireRouter router;
+    bool routing;
+    int routeStartX;
+    int routeStartY;
+    bool routeFound;
+    int routeWiresNeeded;
+    std::vector<int> routePath;
+
     // Texturas/Renderização
-    SDL_Texture* componentTexture;
+    SDL_Texture* componentTexture;   // assets/components.png (traits.spriteId); nullptr = desenho à mão
     TTF_Font* font;
 
     // Métodos internos
-    void DrawGrid(SDL_Renderer* renderer, int offsetX, int offsetY, int cellSize);
-    void DrawComponent(SDL_Renderer* renderer, ComponentType type, int rotation,
+    PuzzleCell& CellAt(int x, int y) { return grid[y * gridWidth + x]; }
+    const PuzzleCell& CellAt(int x, int y) const { return grid[y * gridWidth + x]; }
+    void ResetGrid(int width, int height);
+    int GetCellSize() const;
+    void SetZoom(int level);
+    void ScrollToCursor();
+    void ClampView();
+    void MarkCellChanged(int x, int y);
+    void RebuildLODTexture();
+    void UpdateLODTexel(int lx, int ly);
+    void DrawLOD(RenderList& list, int offsetX, int offsetY, int cellSize);
+    void DrawRoute(RenderList& list, int offsetX, int offsetY, int cellSize);
+    void RebuildRouterMask();
+    void BeginRoute();
+    void CancelRoute();
+    void UpdateRoute();
+    void CommitRoute();
+    void DrawGrid(RenderList& list, int offsetX, int offsetY, int cellSize);
+    void DrawComponent(RenderList& list, ComponentType type, int rotation,
                        int x, int y, int size, bool highlighted, bool burning);
-    void DrawCursor(SDL_Renderer* renderer, int offsetX, int offsetY, int cellSize);
-    void DrawInventory(SDL_Renderer* renderer, int offsetX, int offsetY);
-    void DrawResultFeedback(SDL_Renderer* renderer, int screenW, int screenH);
+    void DrawCursor(RenderList& list, int offsetX, int offsetY, int cellSize);
+    void DrawInventory(RenderList& list, int offsetX, int offsetY);
+    void DrawResultFeedback(RenderList& list, int screenW, int screenH);
     void PlaceComponent();
     void RotateComponent();
     void RemoveComponent();
@@ -1,8 +1,15 @@
 #include "CircuitSystem.h"
+#include "TileMap.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include "StateHash.h"
 
-CircuitSystem::CircuitSystem() : objectTexture(nullptr) {}
+// Própria célula e as 4 vizinhas (alcance de interação e de alimentação pelas trilhas)
+static const int NEIGHBOR_OFFSETS[5][2] = {{0, 0}, {0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+CircuitSystem::CircuitSystem()
+    : netlistDirty(false), syncAll(false), playerCellX(-1), playerCellY(-1), indexWidth(0), indexHeight(0), objectTexture(nullptr) {}
 
 CircuitSystem::~CircuitSystem() {
     Shutdown();
@@ -12,34 +19,321 @@ void CircuitSystem::Initialize(SDL_Texture* objTexture) {
     objectTexture = objTexture;
 }
 
-void CircuitSystem::AddElement(CircuitType type, int id, int x, int y) {
+void CircuitSystem::SetTileMap(const TileMap* map) {
+    if (map) powerGrid.Build(*map);
+}
+
+int CircuitSystem::AddElement(CircuitType type, int id, int x, int y) {
+    return AddLogicElement(type, id, std::vector<int>(), x, y);
+}
+
+int CircuitSystem::AddLogicElement(CircuitType type, int outputNet, const std::vector<int>& inputNets, int x, int y, int delayTicks) {
+    if (x < 0 || y < 0) {
+        std::cerr << "Warning: CircuitSystem element outside the map (" << x << ", " << y << ")\n";
+        return -1;
+    }
+
     CircuitElement el;
     el.type = type;
-    el.id = id;
+    el.id = outputNet;
     el.gridX = x;
     el.gridY = y;
     el.isActive = false; // Começa desligado / fechado
+    el.inputs = inputNets;
+    el.delayTicks = delayTicks;
     elements.push_back(el);
+    nextInCell.push_back(-1);
+    netlistDirty = true;
+
+    int index = (int)elements.size() - 1;
+    LinkElement(index);
+    if (type == CircuitType::PRESSURE_PLATE && x == playerCellX && y == playerCellY) {
+        SetElementActive(index, true); // Placa sob o jogador já nasce pressionada (e energiza as trilhas)
+    }
+    return index;
+}
+
+void CircuitSystem::AddElements(const std::vector<CircuitElement>& batch) {
+    int first = (int)elements.size();
+    elements.reserve(elements.size() + batch.size());
+    nextInCell.reserve(elements.size() + batch.size());
+
+    int maxX = indexWidth - 1, maxY = indexHeight - 1;
+    for (const CircuitElement& el : batch) {
+        if (el.gridX < 0 || el.gridY < 0) {
+            std::cerr << "Warning: CircuitSystem element outside the map (" << el.gridX << ", " << el.gridY << ")\n";
+            continue;
+        }
+        elements.push_back(el);
+        elements.back().isActive = false;
+        nextInCell.push_back(-1);
+        maxX = std::max(maxX, el.gridX);
+        maxY = std::max(maxY, el.gridY);
+    }
+
+    // Cresce o índice no máximo uma vez (GrowIndex já indexa todos); senão encadeia só os novos
+    if (maxX >= indexWidth || maxY >= indexHeight) {
+        GrowIndex(maxX + 1, maxY + 1);
+    } else {
+        for (int i = first; i < (int)elements.size(); ++i) LinkElement(i);
+    }
+    for (int i = first; i < (int)elements.size(); ++i) {
+        const CircuitElement& el = elements[i];
+        if (el.type == CircuitType::PRESSURE_PLATE && el.gridX == playerCellX && el.gridY == playerCellY) {
+            SetElementActive(i, true);
+        }
+    }
+    netlistDirty = true;
+}
+
+void CircuitSystem::RemoveElement(int index) {
+    if (index < 0 || index >= (int)elements.size()) return;
+    SetElementActive(index, false); // Deixa de alimentar as trilhas
+
+    // Remove trocando com o último: só o elemento movido muda de índice
+    UnlinkElement(index);
+    int last = (int)elements.size() - 1;
+    if (index != last) {
+        UnlinkElement(last);
+        elements[index] = elements[last];
+        elements.pop_back();
+        nextInCell.pop_back();
+        LinkElement(index);
+    } else {
+        elements.pop_back();
+        nextInCell.pop_back();
+    }
+    netlistDirty = true;
+}
+
+void CircuitSystem::MoveElement(int index, int x, int y) {
+    if (index < 0 || index >= (int)elements.size() || x < 0 || y < 0) return;
+    bool active = elements[index].isActive;
+    SetElementActive(index, false);
+    UnlinkElement(index);
+    elements[index].gridX = x;
+    elements[index].gridY = y;
+    LinkElement(index);
+    SetElementActive(index, active);
+}
+
+int CircuitSystem::FirstAt(int x, int y) const {
+    if (x < 0 || x >= indexWidth || y < 0 || y >= indexHeight) return -1;
+    return cellFirst[y * indexWidth + x];
+}
+
+void CircuitSystem::LinkElement(int index) {
+    const CircuitElement& el = elements[index];
+    if (el.gridX >= indexWidth || el.gridY >= indexHeight) {
+        GrowIndex(el.gridX + 1, el.gridY + 1);
+        return; // GrowIndex reindexa todos os elementos, inclusive este
+    }
+    int cell = el.gridY * indexWidth + el.gridX;
+    nextInCell[index] = cellFirst[cell];
+    cellFirst[cell] = index;
+}
+
+void CircuitSystem::UnlinkElement(int index) {
+    const CircuitElement& el = elements[index];
+    int* link = &cellFirst[el.gridY * indexWidth + el.gridX];
+    while (*link >= 0) {
+        if (*link == index) {
+            *link = nextInCell[index];
+            nextInCell[index] = -1;
+            return;
+        }
+        link = &nextInCell[*link];
+    }
+}
+
+void CircuitSystem::GrowIndex(int minWidth, int minHeight) {
+    // Cresce em dobro para amortizar; reconstrói a tabela com todos os elementos
+    int newWidth = indexWidth, newHeight = indexHeight;
+    while (newWidth < minWidth) newWidth = newWidth ? newWidth * 2 : 32;
+    while (newHeight < minHeight) newHeight = newHeight ? newHeight * 2 : 32;
+
+    indexWidth = newWidth;
+    indexHeight = newHeight;
+    cellFirst.assign(indexWidth * indexHeight, -1);
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        const CircuitElement& el = elements[i];
+        int cell = el.gridY * indexWidth + el.gridX;
+        nextInCell[i] = cellFirst[cell];
+        cellFirst[cell] = i;
+    }
+}
+
+void CircuitSystem::CompileNetlist() {
+    // Cada elemento que dirige uma net ganha um nó; nets com vários drivers viram um OR (como antes,
+    // vários switches com a mesma id abrem a mesma porta)
+    netlist.Clear();
+    elementNode.assign(elements.size(), -1);
+    std::unordered_map<int, std::vector<int>> drivers;
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        if (elements[i].type == CircuitType::DOOR) continue;
+        elementNode[i] = netlist.AddNode();
+        drivers[elements[i].id].push_back(elementNode[i]);
+    }
+
+    std::unordered_map<int, int> netNode;
+    for (const auto& entry : drivers) {
+        if (entry.second.size() == 1) {
+            netNode[entry.first] = entry.second[0];
+        } else {
+            int node = netlist.AddNode();
+            netlist.Define(node, LogicNetlist::Op::OR, entry.second);
+            netNode[entry.first] = node;
+        }
+    }
+    auto NetNode = [&](int net) {
+        auto it = netNode.find(net);
+        if (it != netNode.end()) return it->second;
+        int node = netlist.AddNode(); // Net sem driver fica sempre em 0
+        netlist.Define(node, LogicNetlist::Op::CONST0, std::vector<int>());
+        netNode[net] = node;
+        return node;
+    };
+
+    std::vector<int> inputs;
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        const CircuitElement& el = elements[i];
+        inputs.clear();
+        for (int net : el.inputs) inputs.push_back(NetNode(net));
+
+        switch (el.type) {
+            case CircuitType::DOOR:      elementNode[i] = NetNode(el.id); break;
+            case CircuitType::AND_GATE:  netlist.Define(elementNode[i], LogicNetlist::Op::AND, inputs); break;
+            case CircuitType::OR_GATE:   netlist.Define(elementNode[i], LogicNetlist::Op::OR, inputs); break;
+            case CircuitType::NOT_GATE:  netlist.Define(elementNode[i], LogicNetlist::Op::NOT, inputs); break;
+            case CircuitType::DELAY:     netlist.Define(elementNode[i], LogicNetlist::Op::DELAY, inputs, el.delayTicks); break;
+            case CircuitType::LATCH:     netlist.Define(elementNode[i], LogicNetlist::Op::LATCH, inputs); break;
+            default: break; // SWITCH e PRESSURE_PLATE são entradas
+        }
+    }
+
+    netlist.Compile();
+    switchesById.clear();
+    wordElementStart.assign(netlist.GetWordCount() + 1, 0);
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        CircuitType type = elements[i].type;
+        if (type == CircuitType::SWITCH || type == CircuitType::PRESSURE_PLATE) {
+            netlist.SetInput(elementNode[i], elements[i].isActive);
+            if (type == CircuitType::SWITCH) switchesById[elements[i].id].push_back(i);
+        } else {
+            ++wordElementStart[netlist.GetWord(elementNode[i]) + 1];
+        }
+    }
+    // Fan-out em CSR: o Update só visita os elementos das palavras que o Tick mudou
+    for (size_t w = 1; w < wordElementStart.size(); ++w) wordElementStart[w] += wordElementStart[w - 1];
+    wordElements.resize(wordElementStart.back());
+    std::vector<int> fill(wordElementStart.begin(), wordElementStart.end() - 1);
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        CircuitType type = elements[i].type;
+        if (type != CircuitType::SWITCH && type != CircuitType::PRESSURE_PLATE) {
+            wordElements[fill[netlist.GetWord(elementNode[i])]++] = i;
+        }
+    }
+    netlistDirty = false;
+    syncAll = true;
+}
+
+void CircuitSystem::SetInputElement(int index, bool active) {
+    SetElementActive(index, active);
+    if (!netlistDirty) netlist.SetInput(elementNode[index], active);
+}
+
+void CircuitSystem::SetElementActive(int index, bool active) {
+    CircuitElement& el = elements[index];
+    if (el.isActive == active) return;
+    el.isActive = active;
+    if (el.type != CircuitType::DOOR) powerGrid.SetSource(el.gridX, el.gridY, active);
+}
+
+void CircuitSystem::RefreshDoors() {
+    for (int i = 0; i < (int)elements.size(); ++i) {
+        if (elements[i].type == CircuitType::DOOR) RefreshDoor(i);
+    }
+}
+
+void CircuitSystem::RefreshDoor(int index) {
+    // Abre pela net lógica ou por uma trilha energizada encostada na porta
+    CircuitElement& el = elements[index];
+    el.isActive = netlist.Get(elementNode[index]) || powerGrid.IsFed(el.gridX, el.gridY);
+}
+
+void CircuitSystem::RefreshDoorsNear(int x, int y) {
+    for (const auto& o : NEIGHBOR_OFFSETS) {
+        for (int i = FirstAt(x + o[0], y + o[1]); i >= 0; i = nextInCell[i]) {
+            if (elements[i].type == CircuitType::DOOR) RefreshDoor(i);
+        }
+    }
+}
+
+void CircuitSystem::SetPlatesAt(int x, int y, bool pressed) {
+    for (int i = FirstAt(x, y); i >= 0; i = nextInCell[i]) {
+        if (elements[i].type == CircuitType::PRESSURE_PLATE) SetInputElement(i, pressed);
+    }
+}
+
+void CircuitSystem::SetPlayerCell(int x, int y) {
+    if (x == playerCellX && y == playerCellY) return;
+    SetPlatesAt(playerCellX, playerCellY, false);
+    SetPlatesAt(x, y, true);
+    playerCellX = x;
+    playerCellY = y;
 }
 
 void CircuitSystem::Update() {
-    // Sincroniza portas e energia baseando nos switches
-    for (auto& door : elements) {
-        if (door.type == CircuitType::DOOR) {
-            bool shouldBeOpen = false;
-            // Varre procurando se algum switch com a mesma ID está ON
-            for (const auto& sw : elements) {
-                if (sw.type == CircuitType::SWITCH && sw.id == door.id && sw.isActive) {
-                    shouldBeOpen = true;
-                    break;
-                }
+    if (netlistDirty) CompileNetlist();
+
+    // Um tick por frame; sem entradas novas nem estado pendente o netlist retorna na hora
+    bool logicChanged = netlist.Tick();
+    bool allPower = false;
+    bool powerChanged = false;
+    if (syncAll) {
+        // Recém-compilado: os valores de antes da compilação não dizem o que mudou
+        for (int i = 0; i < (int)elements.size(); ++i) {
+            CircuitType type = elements[i].type;
+            if (type != CircuitType::SWITCH && type != CircuitType::PRESSURE_PLATE && type != CircuitType::DOOR) {
+                SetElementActive(i, netlist.Get(elementNode[i]));
+            }
+        }
+        syncAll = false;
+        powerGrid.ConsumeChanges(powerChanges, allPower);
+        RefreshDoors();
+        return;
+    }
+
+    const std::vector<int>& changedWords = netlist.GetChangedWords();
+    if (logicChanged) {
+        for (int word : changedWords) {
+            for (int k = wordElementStart[word]; k < wordElementStart[word + 1]; ++k) {
+                int i = wordElements[k];
+                if (elements[i].type != CircuitType::DOOR) SetElementActive(i, netlist.Get(elementNode[i]));
             }
-            door.isActive = shouldBeOpen; // Abre porta se o switch ligado achado bate a id
         }
     }
+    // Saídas lógicas alimentam trilhas, então a energia é consultada depois delas
+    powerChanged = powerGrid.ConsumeChanges(powerChanges, allPower);
+    if (allPower) {
+        RefreshDoors();
+        return;
+    }
+    if (logicChanged) {
+        for (int word : changedWords) {
+            for (int k = wordElementStart[word]; k < wordElementStart[word + 1]; ++k) {
+                if (elements[wordElements[k]].type == CircuitType::DOOR) RefreshDoor(wordElements[k]);
+            }
+        }
+    }
+    if (powerChanged) {
+        for (const SDL_Point& tile : powerChanges) RefreshDoorsNear(tile.x, tile.y);
+    }
 }
 
-void CircuitSystem::Render(SDL_Renderer* renderer, int camX, int camY, int scale) {
+void CircuitSystem::Render(RenderList& list, int camX, int camY, int scale) {
+    powerGrid.Render(list, camX, camY, scale, list.GetWidth(), list.GetHeight());
+
     if (!objectTexture) return;
 
     for (const auto& el : elements) {
@@ -47,11 +341,17 @@ void CircuitSystem::Render(SDL_Renderer* renderer, int camX, int camY, int scale
         int drawY = el.gridY * 32 * scale - camY;
 
         int spriteId = 0;
+        bool tint = false;
         if (el.type == CircuitType::SWITCH) {
             spriteId = el.isActive ? 11 : 10; // ON vs OFF do switch na nossa spritesheet de itens
         } else if (el.type == CircuitType::DOOR) {
             spriteId = el.isActive ? 25 : 24; // ABERTA vs FECHADA 
             if (el.isActive) continue; // Decidindo não renderizar parede sólida ou renderizar chão quebrado quando a porta abre
+        } else {
+            // Placas e módulos lógicos: um sprite por tipo, esverdeado quando a saída está em 1
+            spriteId = (el.type == CircuitType::PRESSURE_PLATE) ? 5 : (el.type == CircuitType::DELAY) ? 21
+                     : (el.type == CircuitType::LATCH) ? 22 : 20;
+            tint = el.isActive;
         }
 
         int srcX = (spriteId % 8) * 32;
@@ -60,37 +360,68 @@ void CircuitSystem::Render(SDL_Renderer* renderer, int camX, int camY, int scale
         SDL_Rect srcRect = { srcX, srcY, 32, 32 };
         SDL_Rect destRect = { drawX, drawY, 32 * scale, 32 * scale };
 
-        SDL_RenderCopy(renderer, objectTexture, &srcRect, &destRect);
+        if (tint) list.SetTextureColorMod(objectTexture, 120, 255, 120);
+        list.Copy(objectTexture, &srcRect, &destRect);
+        if (tint) list.SetTextureColorMod(objectTexture, 255, 255, 255);
     }
 }
 
 void CircuitSystem::Interact(int playerX, int playerY) {
     // Ao apertar Espaço, procura switches num raio de 1 bloco
-    for (auto& el : elements) {
-        if (el.type == CircuitType::SWITCH) {
-            int dx = std::abs(el.gridX - playerX);
-            int dy = std::abs(el.gridY - playerY);
-            if (dx + dy <= 1) { // 1 tile de distância exata vertical ou horizontal
-                el.isActive = !el.isActive;
+    // (1 tile de distância exata vertical ou horizontal: a própria célula e as 4 vizinhas)
+    for (const auto& o : NEIGHBOR_OFFSETS) {
+        for (int i = FirstAt(playerX + o[0], playerY + o[1]); i >= 0; i = nextInCell[i]) {
+            if (elements[i].type == CircuitType::SWITCH) {
+                SetInputElement(i, !elements[i].isActive);
             }
         }
     }
 }
 
+void CircuitSystem::ToggleSwitches(int id) {
+    if (netlistDirty) CompileNetlist(); // O índice por id é refeito junto com o netlist
+    auto it = switchesById.find(id);
+    if (it == switchesById.end()) return;
+    for (int i : it->second) SetInputElement(i, !elements[i].isActive);
+}
+
 bool CircuitSystem::IsSolid(int x, int y) const {
-    for (const auto& el : elements) {
-        if (el.gridX == x && el.gridY == y) {
-            if (el.type == CircuitType::DOOR && !el.isActive) {
-                return true; // Porta fechada bloqueia
-            }
-            if (el.type == CircuitType::SWITCH) {
-                return true; // Máquinas com switch bloqueiam (não pisamos nelas)
-            }
+    for (int i = FirstAt(x, y); i >= 0; i = nextInCell[i]) {
+        const CircuitElement& el = elements[i];
+        if (el.type == CircuitType::DOOR && !el.isActive) {
+            return true; // Porta fechada bloqueia
+        }
+        if (el.type != CircuitType::DOOR && el.type != CircuitType::PRESSURE_PLATE) {
+            return true; // Máquinas (switch, portas lógicas) bloqueiam (não pisamos nelas)
         }
     }
     return false;
 }
 
+Uint64 CircuitSystem::HashState(Uint64 hash) const {
+    for (const CircuitElement& el : elements) {
+        hash = HashValue(hash, el.id);
+        hash = HashValue(hash, el.gridX);
+        hash = HashValue(hash, el.gridY);
+        hash = HashValue(hash, el.isActive);
+    }
+    return HashValue(hash, elements.size());
+}
+
 void CircuitSystem::Shutdown() {
     elements.clear();
+    elementNode.clear();
+    wordElementStart.clear();
+    wordElements.clear();
+    switchesById.clear();
+    netlist.Clear();
+    netlistDirty = false;
+    syncAll = false;
+    powerGrid.Clear();
+    playerCellX = -1;
+    playerCellY = -1;
+    nextInCell.clear();
+    cellFirst.clear();
+    indexWidth = 0;
+    indexHeight = 0;
 }
@@ -3,18 +3,32 @@
 
 #include <SDL2/SDL.h>
 #include <vector>
+#include <unordered_map>
+#include "LogicNetlist.h"
+#include "PowerGrid.h"
+#include "RenderList.h"
+
+class TileMap;
 
 enum class CircuitType {
     SWITCH,
-    DOOR
+    DOOR,
+    PRESSURE_PLATE, // Ligada enquanto o jogador está em cima
+    AND_GATE,
+    OR_GATE,
+    NOT_GATE,
+    DELAY,          // Repete a entrada depois de delayTicks ticks
+    LATCH           // Entradas: set, reset
 };
 
 struct CircuitElement {
-    int id; // Link do switch para a porta (ex: Switch 1 liga Door 1)
+    int id; // Net: switches, placas e portas lógicas escrevem nela; a porta (DOOR) lê dela
     CircuitType type;
     int gridX;
     int gridY;
     bool isActive; // true = ON ou Aberta
+    std::vector<int> inputs; // Nets de entrada das portas lógicas / delay / latch
+    int delayTicks;
 };
 
 class CircuitSystem {
@@ -23,16 +37,59 @@ public:
     ~CircuitSystem();
 
     void Initialize(SDL_Texture* objTexture);
-    void AddElement(CircuitType type, int id, int x, int y);
+    void SetObjectTexture(SDL_Texture* objTexture) { objectTexture = objTexture; } // Chega depois, do AssetLoader
+    void SetTileMap(const TileMap* map); // Trilhas condutivas do mapa levam energia até as portas
+    void SetJobSystem(JobSystem* jobSystem) { netlist.SetJobSystem(jobSystem); } // Níveis largos do netlist
+    // Retorna o índice do elemento (válido até a próxima remoção), ou -1 se a posição for inválida
+    int AddElement(CircuitType type, int id, int x, int y);
+    // Elementos lógicos: escrevem em outputNet a partir de inputNets (o netlist é recompilado no próximo Update)
+    int AddLogicElement(CircuitType type, int outputNet, const std::vector<int>& inputNets, int x, int y, int delayTicks = 0);
+    // Inserção em lote (carregamento de fase): reserva uma vez e indexa tudo numa passada
+    void AddElements(const std::vector<CircuitElement>& batch);
+    void RemoveElement(int index);
+    void MoveElement(int index, int x, int y);
     void Update();
-    void Render(SDL_Renderer* renderer, int camX, int camY, int scale);
+    void Render(RenderList& list, int camX, int camY, int scale);
     void Shutdown();
 
     void Interact(int playerX, int playerY);
+    void ToggleSwitches(int id); // Alterna todos os switches de um id (usado por zonas de gatilho)
+    void SetPlayerCell(int x, int y); // Aciona/solta placas de pressão
     bool IsSolid(int x, int y) const;
+    Uint64 HashState(Uint64 hash) const;
 
 private:
+    void CompileNetlist();
+    void SetInputElement(int index, bool active);
+    void SetElementActive(int index, bool active);
+    void RefreshDoors();
+    void RefreshDoor(int index);
+    void RefreshDoorsNear(int x, int y); // Portas alimentadas pelo tile (x, y)
+    void SetPlatesAt(int x, int y, bool pressed);
+
+    // Índice espacial denso: célula -> primeiro elemento, e elemento -> próximo na mesma célula
+    int FirstAt(int x, int y) const;
+    void LinkElement(int index);
+    void UnlinkElement(int index);
+    void GrowIndex(int minWidth, int minHeight);
+
     std::vector<CircuitElement> elements;
+    LogicNetlist netlist;
+    PowerGrid powerGrid;   // Elementos ativos (exceto portas) são fontes de energia nas trilhas vizinhas
+    std::vector<int> elementNode; // Nó do netlist: saída do elemento, ou a net lida pela porta
+    // Palavra do netlist -> elementos (portas lógicas e portas) cujo nó está nela
+    std::vector<int> wordElementStart;
+    std::vector<int> wordElements;
+    std::unordered_map<int, std::vector<int>> switchesById;
+    std::vector<SDL_Point> powerChanges;
+    bool netlistDirty;
+    bool syncAll; // Depois de compilar, o primeiro Update confere todos os elementos
+    int playerCellX;
+    int playerCellY;
+    std::vector<int> nextInCell;
+    std::vector<int> cellFirst;
+    int indexWidth;
+    int indexHeight;
     SDL_Texture* objectTexture;
 };
 
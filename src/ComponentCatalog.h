@@ -0,0 +1,102 @@
+#ifndef COMPONENT_CATALOG_H
+#define COMPONENT_CATALOG_H
+
+#include <SDL2/SDL.h>
+
+// Portas de conexão de uma célula (sentido horário a partir do norte)
+enum PortMask : Uint8 {
+    PORT_NONE = 0,
+    PORT_N = 1,
+    PORT_E = 2,
+    PORT_S = 4,
+    PORT_W = 8
+};
+
+// Papel do componente no circuito (usado pelo validador)
+enum class ElectricalModel : Uint8 {
+    NONE,       // Célula vazia, não conduz
+    CONDUCTOR,  // Fio
+    SOURCE,     // Fonte de energia
+    LIMITER,    // Limita a corrente (resistor)
+    LOAD,       // Carga sensível (LED)
+    SWITCH,     // Chave
+    COUNT
+};
+
+constexpr SDL_Color CatalogColor(Uint8 r, Uint8 g, Uint8 b) { return SDL_Color{r, g, b, 255}; }
+
+// Catálogo de componentes do puzzle: UMA linha por componente.
+// A ordem define o valor do enum (e a prioridade na textura LOD: maior vence).
+//
+// X(tipo, modelo elétrico, portas na rotação 0, polarizado, vai pro inventário, peça do estoque,
+//   sprite em components.png, cor resumo, nome no inventário, rótulo, cor do rótulo, função de desenho)
+// Formas com a mesma peça do estoque (fio reto e curva) gastam e devolvem a mesma contagem,
+// e o R passa de uma forma para a seguinte depois da última rotação distinta.
+// O sprite tem que estar orientado como as portas da rotação 0 (o LED e a bateria da folha são
+// verticais e ligam E-W, então ficam com -1 e usam a função de desenho)
+#define COMPONENT_CATALOG(X) \
+    X(EMPTY,       NONE,      PORT_NONE,       false, false, EMPTY,        -1, CatalogColor(15, 18, 35),   "???",      "",    CatalogColor(0, 0, 0),       DrawNothing) \
+    X(WIRE,        CONDUCTOR, PORT_E | PORT_W, false, true,  WIRE,          0, CatalogColor(0, 255, 100),  "FIO",      "",    CatalogColor(0, 0, 0),       DrawWire) \
+    X(WIRE_CORNER, CONDUCTOR, PORT_N | PORT_E, false, true,  WIRE,          3, CatalogColor(0, 255, 100),  "FIO",      "",    CatalogColor(0, 0, 0),       DrawWire) \
+    X(RESISTOR,    LIMITER,   PORT_E | PORT_W, false, true,  RESISTOR,      6, CatalogColor(200, 150, 50), "RESISTOR", "",    CatalogColor(0, 0, 0),       DrawResistor) \
+    X(LED,         LOAD,      PORT_E | PORT_W, true,  true,  LED,          -1, CatalogColor(255, 50, 50),  "LED",      "+",   CatalogColor(255, 100, 100), DrawLED) \
+    X(BATTERY,     SOURCE,    PORT_E | PORT_W, false, false, BATTERY,      -1, CatalogColor(50, 200, 255), "BATERIA",  "BAT", CatalogColor(255, 255, 0),   DrawBattery) \
+    X(SWITCH_COMP, SWITCH,    PORT_E | PORT_W, false, true,  SWITCH_COMP,  19, CatalogColor(200, 200, 0),  "CHAVE",    "",    CatalogColor(0, 0, 0),       DrawSwitch)
+
+// Tipos de componentes que o jogador pode colocar no grid (gerado do catálogo)
+#define CATALOG_ENUM_ENTRY(type, ...) type,
+enum class ComponentType : Uint8 {
+    COMPONENT_CATALOG(CATALOG_ENUM_ENTRY)
+};
+#undef CATALOG_ENUM_ENTRY
+
+#define CATALOG_COUNT_ENTRY(...) + 1
+constexpr int COMPONENT_COUNT = 0 COMPONENT_CATALOG(CATALOG_COUNT_ENTRY);
+#undef CATALOG_COUNT_ENTRY
+
+// Gira a máscara de portas 90 graus no sentido horário (N->E->S->W)
+constexpr Uint8 RotatePorts(Uint8 ports, int quarterTurns) {
+    for (int i = 0; i < quarterTurns; ++i) {
+        ports = (Uint8)(((ports << 1) | (ports >> 3)) & 0xF);
+    }
+    return ports;
+}
+
+struct ComponentTraits {
+    ElectricalModel model;
+    bool conducts;           // Participa da conectividade do circuito
+    bool polarized;          // Rotação 180 inverte a polaridade
+    bool inInventory;        // Colocado pelo jogador e devolvido ao remover
+    ComponentType stock;     // Item do inventário que esta forma consome e devolve
+    Uint8 ports[4];          // Portas por rotação (0, 90, 180, 270)
+    int spriteId;            // Índice em assets/components.png (-1 = sem sprite)
+    SDL_Color color;
+    const char* inventoryName;
+    const char* label;
+    SDL_Color labelColor;
+};
+
+// Tabela de traits expandida em tempo de compilação: o validador e o renderizador
+// indexam por (int)ComponentType em vez de fazer switch no tipo
+#define CATALOG_TRAITS_ENTRY(type, model, ports, polarized, inInventory, stock, sprite, color, invName, label, labelColor, draw) \
+    { ElectricalModel::model, ElectricalModel::model != ElectricalModel::NONE, polarized, inInventory, ComponentType::stock, \
+      { RotatePorts(ports, 0), RotatePorts(ports, 1), RotatePorts(ports, 2), RotatePorts(ports, 3) }, \
+      sprite, color, invName, label, labelColor },
+inline constexpr ComponentTraits COMPONENT_TRAITS[COMPONENT_COUNT] = {
+    COMPONENT_CATALOG(CATALOG_TRAITS_ENTRY)
+};
+#undef CATALOG_TRAITS_ENTRY
+
+constexpr const ComponentTraits& GetTraits(ComponentType type) {
+    return COMPONENT_TRAITS[(int)type];
+}
+
+constexpr Uint8 GetPorts(ComponentType type, int rotation) {
+    return COMPONENT_TRAITS[(int)type].ports[(rotation / 90) & 3];
+}
+
+static_assert(GetPorts(ComponentType::WIRE, 90) == (PORT_N | PORT_S), "fio vertical liga norte-sul");
+static_assert(GetPorts(ComponentType::WIRE_CORNER, 90) == (PORT_E | PORT_S), "curva gira com as portas");
+static_assert(!GetTraits(ComponentType::EMPTY).conducts, "célula vazia não conduz");
+
+#endif // COMPONENT_CATALOG_H
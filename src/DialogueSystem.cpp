@@ -1,7 +1,7 @@
 #include "DialogueSystem.h"
-#include <SDL2/SDL_image.h>
 #include <iostream>
 #include <cmath>
+#include "Trace.h"
 
 DialogueSystem::DialogueSystem()
     : font(nullptr), fontSmall(nullptr), active(false),
@@ -15,30 +15,57 @@ DialogueSystem::~DialogueSystem() {
     Shutdown();
 }
 
-bool DialogueSystem::Initialize(SDL_Renderer* renderer) {
-    if (TTF_WasInit() == 0) {
-        if (TTF_Init() == -1) {
-            std::cerr << "Failed to initialize SDL_ttf: " << TTF_GetError() << "\n";
-            return false;
+void DialogueSystem::WrapText(TTF_Font* font, const std::string& text, int maxWidth, std::vector<std::string>& lines) {
+    // Wrapping manual simples para controlar o espaçamento entre as linhas
+    std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+    lines.clear();
+    std::string currentLine = "";
+    std::string word = "";
+
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == ' ' || c == '\n') {
+            int w, h;
+            std::string testLine = currentLine + word + " ";
+            TTF_SizeText(font, testLine.c_str(), &w, &h);
+            if (w > maxWidth && !currentLine.empty()) {
+                lines.push_back(currentLine);
+                currentLine = word + " ";
+            } else {
+                currentLine += word + " ";
+            }
+            word = "";
+            if (c == '\n') {
+                lines.push_back(currentLine);
+                currentLine = "";
+            }
+        } else {
+            word += c;
         }
     }
-
-    font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 10);
-    if (!font) {
-        std::cerr << "Warning: Could not load dialogue font: " << TTF_GetError() << "\n";
+    if (!word.empty()) {
+        int w, h;
+        std::string testLine = currentLine + word;
+        TTF_SizeText(font, testLine.c_str(), &w, &h);
+        if (w > maxWidth && !currentLine.empty()) {
+            lines.push_back(currentLine);
+            currentLine = word;
+        } else {
+            currentLine += word;
+        }
     }
-
-    fontSmall = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 8);
-    if (!fontSmall) {
-        std::cerr << "Warning: Could not load small font: " << TTF_GetError() << "\n";
+    if (!currentLine.empty()) {
+        lines.push_back(currentLine);
     }
+}
 
-    SDL_Surface* portraitSurf = IMG_Load("assets/prof_leo.png");
-    if (portraitSurf) {
-        portraitTexture = SDL_CreateTextureFromSurface(renderer, portraitSurf);
-        SDL_FreeSurface(portraitSurf);
-    } else {
-        std::cerr << "Warning: Could not load assets/prof_leo.png\n";
+bool DialogueSystem::Initialize() {
+    TRACE_ZONE("DialogueSystem::Initialize");
+    if (TTF_WasInit() == 0) {
+        if (TTF_Init() == -1) {
+            std::cerr << "Failed to initialize SDL_ttf: " << TTF_GetError() << "\n";
+            return false;
+        }
     }
 
     return true;
@@ -102,10 +129,11 @@ void DialogueSystem::Update(float deltaTime) {
     }
 }
 
-void DialogueSystem::Render(SDL_Renderer* renderer, int screenW, int screenH) {
+void DialogueSystem::Render(RenderList& list, int screenW, int screenH) {
+    TRACE_ZONE("DialogueSystem::Render");
     if (!active) return;
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Caixa de diálogo na parte inferior
     int boxH = 100;
@@ -114,63 +142,57 @@ void DialogueSystem::Render(SDL_Renderer* renderer, int screenW, int screenH) {
     int boxY = screenH - boxH - 20;
 
     // Fundo da caixa
-    SDL_SetRenderDrawColor(renderer, 10, 10, 40, (Uint8)boxAlpha);
+    list.SetDrawColor(10, 10, 40, (Uint8)boxAlpha);
     SDL_Rect bg = {boxX, boxY, boxW, boxH};
-    SDL_RenderFillRect(renderer, &bg);
+    list.FillRect(bg);
 
     // Retrato do Professor Leo
     if (showPortrait && portraitTexture) {
         SDL_Rect portraitRect = {boxX + 10, boxY + 10, 80, 80};
-        SDL_RenderCopy(renderer, portraitTexture, nullptr, &portraitRect);
+        list.Copy(portraitTexture, nullptr, &portraitRect);
         
         // Borda do retrato
-        SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-        SDL_RenderDrawRect(renderer, &portraitRect);
+        list.SetDrawColor(0, 200, 255, 255);
+        list.DrawRect(portraitRect);
     }
 
     // Borda neon ciano
-    SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-    SDL_RenderDrawRect(renderer, &bg);
+    list.SetDrawColor(0, 200, 255, 255);
+    list.DrawRect(bg);
     SDL_Rect bg2 = {boxX + 1, boxY + 1, boxW - 2, boxH - 2};
-    SDL_RenderDrawRect(renderer, &bg2);
+    list.DrawRect(bg2);
 
     // Pequena decoração nos cantos
     int cornerSize = 6;
-    SDL_SetRenderDrawColor(renderer, 0, 255, 200, 255);
+    list.SetDrawColor(0, 255, 200, 255);
     // Canto superior esquerdo
-    SDL_RenderDrawLine(renderer, boxX, boxY, boxX + cornerSize, boxY);
-    SDL_RenderDrawLine(renderer, boxX, boxY, boxX, boxY + cornerSize);
+    list.DrawLine(boxX, boxY, boxX + cornerSize, boxY);
+    list.DrawLine(boxX, boxY, boxX, boxY + cornerSize);
     // Canto superior direito
-    SDL_RenderDrawLine(renderer, boxX + boxW - 1, boxY, boxX + boxW - cornerSize - 1, boxY);
-    SDL_RenderDrawLine(renderer, boxX + boxW - 1, boxY, boxX + boxW - 1, boxY + cornerSize);
+    list.DrawLine(boxX + boxW - 1, boxY, boxX + boxW - cornerSize - 1, boxY);
+    list.DrawLine(boxX + boxW - 1, boxY, boxX + boxW - 1, boxY + cornerSize);
     // Canto inferior esquerdo
-    SDL_RenderDrawLine(renderer, boxX, boxY + boxH - 1, boxX + cornerSize, boxY + boxH - 1);
-    SDL_RenderDrawLine(renderer, boxX, boxY + boxH - 1, boxX, boxY + boxH - cornerSize - 1);
+    list.DrawLine(boxX, boxY + boxH - 1, boxX + cornerSize, boxY + boxH - 1);
+    list.DrawLine(boxX, boxY + boxH - 1, boxX, boxY + boxH - cornerSize - 1);
     // Canto inferior direito
-    SDL_RenderDrawLine(renderer, boxX + boxW - 1, boxY + boxH - 1, boxX + boxW - cornerSize - 1, boxY + boxH - 1);
-    SDL_RenderDrawLine(renderer, boxX + boxW - 1, boxY + boxH - 1, boxX + boxW - 1, boxY + boxH - cornerSize - 1);
+    list.DrawLine(boxX + boxW - 1, boxY + boxH - 1, boxX + boxW - cornerSize - 1, boxY + boxH - 1);
+    list.DrawLine(boxX + boxW - 1, boxY + boxH - 1, boxX + boxW - 1, boxY + boxH - cornerSize - 1);
 
     if (!font) return;
 
     // Nome do speaker
-    if (!currentSpeaker.empty()) {
+    int nameW, nameH;
+    if (!currentSpeaker.empty() && RenderList::MeasureText(font, currentSpeaker.c_str(), &nameW, &nameH)) {
         SDL_Color speakerColor = {0, 255, 200, 255};
-        SDL_Surface* surf = TTF_RenderText_Solid(font, currentSpeaker.c_str(), speakerColor);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-
-            // Background do nome
-            SDL_SetRenderDrawColor(renderer, 10, 10, 40, 240);
-            SDL_Rect nameBg = {boxX + 10, boxY - 14, surf->w + 12, surf->h + 6};
-            SDL_RenderFillRect(renderer, &nameBg);
-            SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-            SDL_RenderDrawRect(renderer, &nameBg);
-
-            SDL_Rect dst = {boxX + 16, boxY - 11, surf->w, surf->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
+
+        // Background do nome
+        list.SetDrawColor(10, 10, 40, 240);
+        SDL_Rect nameBg = {boxX + 10, boxY - 14, nameW + 12, nameH + 6};
+        list.FillRect(nameBg);
+        list.SetDrawColor(0, 200, 255, 255);
+        list.DrawRect(nameBg);
+
+        list.Text(font, currentSpeaker.c_str(), speakerColor, boxX + 16, boxY - 11);
     }
 
     // Texto com typewriter
@@ -181,46 +203,8 @@ void DialogueSystem::Render(SDL_Renderer* renderer, int screenW, int screenH) {
         int lineSpacing = 8; // Espaçamento extra entre linhas
         int lineHeight = TTF_FontLineSkip(fontSmall) + lineSpacing;
 
-        // Wrapping manual simples para controlar o espaçamento entre as linhas
         std::vector<std::string> lines;
-        std::string currentLine = "";
-        std::string word = "";
-
-        for (size_t i = 0; i < displayedText.size(); i++) {
-            char c = displayedText[i];
-            if (c == ' ' || c == '\n') {
-                int w, h;
-                std::string testLine = currentLine + word + " ";
-                TTF_SizeText(fontSmall, testLine.c_str(), &w, &h);
-                if (w > maxWidth && !currentLine.empty()) {
-                    lines.push_back(currentLine);
-                    currentLine = word + " ";
-                } else {
-                    currentLine += word + " ";
-                }
-                word = "";
-                if (c == '\n') {
-                    lines.push_back(currentLine);
-                    currentLine = "";
-                }
-            } else {
-                word += c;
-            }
-        }
-        if (!word.empty()) {
-            int w, h;
-            std::string testLine = currentLine + word;
-            TTF_SizeText(fontSmall, testLine.c_str(), &w, &h);
-            if (w > maxWidth && !currentLine.empty()) {
-                lines.push_back(currentLine);
-                currentLine = word;
-            } else {
-                currentLine += word;
-            }
-        }
-        if (!currentLine.empty()) {
-            lines.push_back(currentLine);
-        }
+        WrapText(fontSmall, displayedText, maxWidth, lines);
 
         int drawY = boxY + 15;
         for (const auto& line : lines) {
@@ -228,16 +212,8 @@ void DialogueSystem::Render(SDL_Renderer* renderer, int screenW, int screenH) {
             std::string renderLine = line;
             if (!renderLine.empty() && renderLine.back() == ' ') renderLine.pop_back();
 
-            if (!renderLine.empty()) {
-                SDL_Surface* surf = TTF_RenderText_Blended(fontSmall, renderLine.c_str(), textColor);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                    SDL_Rect dst = {textX, drawY, surf->w, surf->h};
-                    SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                    SDL_DestroyTexture(tex);
-                    SDL_FreeSurface(surf);
-                }
-            }
+            list.Text(fontSmall, renderLine.c_str(), textColor, textX, drawY,
+                      TEXT_LEFT | TEXT_TOP, 1, TextStyle::BLENDED);
             drawY += lineHeight;
         }
     }
@@ -249,14 +225,7 @@ void DialogueSystem::Render(SDL_Renderer* renderer, int screenW, int screenH) {
             SDL_Color gray = {150, 150, 150, 255};
             const char* prompt = currentMessageIndex < (int)messageQueue.size() - 1
                                  ? ">> SPACE >>" : "[SPACE]";
-            SDL_Surface* surf = TTF_RenderText_Solid(fontSmall, prompt, gray);
-            if (surf) {
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect dst = {boxX + boxW - surf->w - 15, boxY + boxH - surf->h - 10, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                SDL_DestroyTexture(tex);
-                SDL_FreeSurface(surf);
-            }
+            list.Text(fontSmall, prompt, gray, boxX + boxW - 15, boxY + boxH - 10, TEXT_RIGHT | TEXT_BOTTOM);
         }
     }
 }
@@ -294,16 +263,7 @@ bool DialogueSystem::IsFinished() const {
 }
 
 void DialogueSystem::Shutdown() {
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
-    }
-    if (fontSmall) {
-        TTF_CloseFont(fontSmall);
-        fontSmall = nullptr;
-    }
-    if (portraitTexture) {
-        SDL_DestroyTexture(portraitTexture);
-        portraitTexture = nullptr;
-    }
+    font = nullptr;
+    fontSmall = nullptr;
+    portraitTexture = nullptr;
 }
@@ -5,15 +5,19 @@
 #include <SDL2/SDL_ttf.h>
 #include <string>
 #include <vector>
+#include "RenderList.h"
 
 class DialogueSystem {
 public:
     DialogueSystem();
     ~DialogueSystem();
 
-    bool Initialize(SDL_Renderer* renderer);
+    bool Initialize();
+    // Fontes e retrato vêm do AssetLoader (que os libera); sem eles o diálogo é desenhado sem texto/retrato
+    void SetFonts(TTF_Font* textFont, TTF_Font* smallFont) { font = textFont; fontSmall = smallFont; }
+    void SetPortrait(SDL_Texture* texture) { portraitTexture = texture; }
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer, int screenW, int screenH);
+    void Render(RenderList& list, int screenW, int screenH);
     void Shutdown();
 
     // Mostra uma mensagem com efeito typewriter e retrato
@@ -25,6 +29,10 @@ public:
     bool IsActive() const;
     bool IsFinished() const;
 
+    // Quebra o texto em linhas de até maxWidth pixels (separa em espaços e '\n'). Mede com a fonte
+    // sob RenderList::FontMutex, já que a thread de render rasteriza textos ao mesmo tempo
+    static void WrapText(TTF_Font* font, const std::string& text, int maxWidth, std::vector<std::string>& lines);
+
 private:
     TTF_Font* font;
     TTF_Font* fontSmall;
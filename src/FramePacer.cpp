@@ -0,0 +1,118 @@
+#include "FramePacer.h"
+#include <cmath>
+#include <iostream>
+
+static const double SPIN_MARGIN_MS = 2.0; // Abaixo disso o SDL_Delay não é confiável: gira no contador
+
+FramePacer::FramePacer()
+    : renderThread(nullptr), mode(PacingMode::SLEEP_SPIN), targetHz(60), frequency(1.0), period(0),
+      nextDeadline(0), lastFrameEnd(0), vsyncAvailable(false) {
+    ResetStats();
+}
+
+void FramePacer::Initialize(RenderThread* thread, PacingMode initialMode, int hz) {
+    renderThread = thread;
+    SDL_Renderer* renderer = renderThread ? renderThread->GetRenderer() : nullptr;
+    targetHz = hz > 0 ? hz : 60;
+    frequency = (double)SDL_GetPerformanceFrequency();
+    period = (Uint64)(frequency / targetHz);
+
+    SDL_RendererInfo info;
+    vsyncAvailable = renderer && SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    vsyncAvailable = vsyncAvailable || renderer != nullptr; // Pode ser ligado depois com SDL_RenderSetVSync
+#endif
+    SetMode(initialMode);
+}
+
+void FramePacer::SetMode(PacingMode newMode) {
+    if (newMode == PacingMode::VSYNC && !vsyncAvailable) {
+        std::cerr << "Warning: VSync not available on this renderer, using sleep-spin pacing\n";
+        newMode = PacingMode::SLEEP_SPIN;
+    }
+    if (renderThread) renderThread->SetVSync(newMode == PacingMode::VSYNC);
+
+    if (stats.frames > 0) LogStats(); // Fecha as estatísticas do modo anterior
+    mode = newMode;
+    nextDeadline = 0;
+    lastFrameEnd = 0;
+    ResetStats();
+    std::cout << "[PACING] Mode: " << ModeName(mode) << " (target " << targetHz << " Hz)\n";
+}
+
+void FramePacer::NextMode() {
+    switch (mode) {
+        case PacingMode::VSYNC: SetMode(PacingMode::SLEEP_SPIN); break;
+        case PacingMode::SLEEP_SPIN: SetMode(PacingMode::UNCAPPED); break;
+        case PacingMode::UNCAPPED: SetMode(vsyncAvailable ? PacingMode::VSYNC : PacingMode::SLEEP_SPIN); break;
+    }
+}
+
+void FramePacer::WaitUntil(Uint64 deadline) const {
+    Uint64 margin = (Uint64)(SPIN_MARGIN_MS * frequency / 1000.0);
+    for (;;) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= deadline) return;
+        Uint64 remaining = deadline - now;
+        if (remaining <= margin) break;
+        Uint32 sleepMs = (Uint32)((remaining - margin) * 1000.0 / frequency);
+        SDL_Delay(sleepMs > 0 ? sleepMs : 1);
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+        // Espera ativa no último trecho: precisão de microssegundos
+    }
+}
+
+void FramePacer::EndFrame() {
+    if (mode == PacingMode::SLEEP_SPIN) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (nextDeadline == 0 || now > nextDeadline + period) {
+            nextDeadline = now + period; // Primeiro quadro ou atraso de mais de um quadro: ressincroniza
+        }
+        WaitUntil(nextDeadline);
+        nextDeadline += period;
+    }
+
+    Uint64 frameEnd = SDL_GetPerformanceCounter();
+    if (lastFrameEnd != 0) {
+        double ms = (frameEnd - lastFrameEnd) * 1000.0 / frequency;
+        stats.frames++;
+        double delta = ms - stats.meanMs;
+        stats.meanMs += delta / stats.frames;
+        stats.m2 += delta * (ms - stats.meanMs);
+        if (ms < stats.minMs) stats.minMs = ms;
+        if (ms > stats.maxMs) stats.maxMs = ms;
+    }
+    lastFrameEnd = frameEnd;
+}
+
+void FramePacer::ResetStats() {
+    stats.frames = 0;
+    stats.meanMs = 0.0;
+    stats.m2 = 0.0;
+    stats.minMs = 1e9;
+    stats.maxMs = 0.0;
+}
+
+void FramePacer::LogStats() const {
+    if (stats.frames == 0) return;
+    std::cout << "[PACING] " << ModeName(mode) << ": " << stats.frames << " frames, mean "
+              << stats.meanMs << " ms, stddev " << std::sqrt(stats.VarianceMs2()) << " ms, min "
+              << stats.minMs << " ms, max " << stats.maxMs << " ms\n";
+}
+
+const char* FramePacer::ModeName(PacingMode pacing) {
+    switch (pacing) {
+        case PacingMode::VSYNC: return "vsync";
+        case PacingMode::SLEEP_SPIN: return "spin";
+        case PacingMode::UNCAPPED: return "uncapped";
+    }
+    return "?";
+}
+
+bool FramePacer::ParseMode(const std::string& name, PacingMode& out) {
+    for (PacingMode m : {PacingMode::VSYNC, PacingMode::SLEEP_SPIN, PacingMode::UNCAPPED}) {
+        if (name == ModeName(m)) { out = m; return true; }
+    }
+    return false;
+}
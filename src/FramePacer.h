@@ -0,0 +1,59 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include "RenderThread.h"
+
+enum class PacingMode {
+    VSYNC,      // SDL_RenderPresent espera o retraço do monitor
+    SLEEP_SPIN, // Dorme a maior parte do quadro e gira os últimos milissegundos no contador
+    UNCAPPED    // Sem limite (benchmark)
+};
+
+// Estatísticas dos intervalos entre quadros (média e variância pelo método de Welford)
+struct FrameStats {
+    int frames;
+    double meanMs;
+    double m2;
+    double minMs;
+    double maxMs;
+    double VarianceMs2() const { return frames > 1 ? m2 / (frames - 1) : 0.0; }
+};
+
+// Limita o ritmo dos quadros no modo escolhido e mede a regularidade obtida
+class FramePacer {
+public:
+    FramePacer();
+
+    void Initialize(RenderThread* renderThread, PacingMode mode, int targetHz);
+    void SetMode(PacingMode mode);
+    void NextMode(); // Cicla VSYNC -> SLEEP_SPIN -> UNCAPPED
+    PacingMode GetMode() const { return mode; }
+    int GetTargetHz() const { return targetHz; }
+
+    // Chamado depois do SDL_RenderPresent: espera até o prazo do quadro e registra o intervalo
+    void EndFrame();
+
+    const FrameStats& GetStats() const { return stats; }
+    void ResetStats();
+    void LogStats() const;
+
+    static const char* ModeName(PacingMode mode);
+    static bool ParseMode(const std::string& name, PacingMode& mode);
+
+private:
+    void WaitUntil(Uint64 deadline) const;
+
+    RenderThread* renderThread; // Dona do renderer: o VSync é trocado por ela antes do próximo present
+    PacingMode mode;
+    int targetHz;
+    double frequency;
+    Uint64 period;       // Duração alvo do quadro em ticks do contador
+    Uint64 nextDeadline; // Prazos absolutos: o erro de um quadro não se acumula no seguinte
+    Uint64 lastFrameEnd;
+    bool vsyncAvailable;
+    FrameStats stats;
+};
+
+#endif // FRAME_PACER_H
@@ -1,22 +1,109 @@
 #include "Game.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <SDL2/SDL_image.h>
 #include "TileMap.h"
 #include "Camera.h"
+#include "StateHash.h"
+#include "Trace.h"
+
+static const int ASSET_LOADER_THREADS = 2;
+static const char* ASSET_PACK_FILE = "assets.pak";
+
+constexpr unsigned StateBit(GameState state) { return 1u << (int)state; }
+
+// Escopos de estado: cada linha da tabela diz em que estados o asset precisa estar residente
+const unsigned SCOPE_MENU = StateBit(GameState::MAIN_MENU) | StateBit(GameState::LEVEL_SELECTION);
+const unsigned SCOPE_LEVEL = StateBit(GameState::EXPLORATION) | StateBit(GameState::PUZZLE) |
+                             StateBit(GameState::DIALOGUE) | StateBit(GameState::VICTORY);
+const unsigned SCOPE_ALL = SCOPE_MENU | SCOPE_LEVEL;
+
+// Estados prováveis a seguir (indexado por GameState): os assets deles carregam em segundo plano
+static const unsigned STATE_PREFETCH[] = {
+    StateBit(GameState::LEVEL_SELECTION),                                         // MAIN_MENU
+    StateBit(GameState::MAIN_MENU) | StateBit(GameState::EXPLORATION) |
+        StateBit(GameState::DIALOGUE),                                            // LEVEL_SELECTION (intro)
+    StateBit(GameState::PUZZLE) | StateBit(GameState::DIALOGUE),                  // EXPLORATION
+    StateBit(GameState::EXPLORATION) | StateBit(GameState::DIALOGUE),             // PUZZLE
+    StateBit(GameState::EXPLORATION) | StateBit(GameState::PUZZLE) |
+        StateBit(GameState::VICTORY),                                             // DIALOGUE
+    0                                                                             // VICTORY (só sair)
+};
+
+static const char* STATE_NAMES[] = {"main_menu", "level_selection", "exploration", "puzzle", "dialogue", "victory"};
+
+// Um pedido ao AssetLoader em nome de um subsistema; pedidos iguais de donos diferentes dividem o recurso
+struct GameAssetDesc {
+    AssetDesc desc;
+    unsigned states;      // StateBit dos estados que usam o asset
+    const char* owner;
+};
+
+// Índices de GAME_ASSETS (e de Game::assetRefs). Os do menu vêm primeiro: a fila do loader é FIFO
+enum GameAsset {
+    ASSET_FONT_TITLE, ASSET_FONT_LARGE, ASSET_FONT_HEADING, ASSET_FONT_MENU, ASSET_FONT_SMALL,
+    ASSET_MENU_BACKGROUND, ASSET_MENU_MUSIC, ASSET_SOUND_SELECT,
+    ASSET_DIALOGUE_FONT, ASSET_DIALOGUE_FONT_SMALL, ASSET_ACHIEVEMENT_FONT, ASSET_ACHIEVEMENT_FONT_SMALL,
+    ASSET_PUZZLE_FONT, ASSET_PERF_FONT,
+    ASSET_TILESET, ASSET_OBJECTS, ASSET_PLAYER, ASSET_PORTRAIT, ASSET_COMPONENTS,
+    ASSET_SOUND_SUCCESS, ASSET_SOUND_ERROR, ASSET_SOUND_EXPLOSION, ASSET_GAME_MUSIC, ASSET_PUZZLE_MUSIC,
+    ASSET_COUNT
+};
+
+static const char* FONT_FILE = "assets/PressStart2P-Regular.ttf";
+
+static const GameAssetDesc GAME_ASSETS[ASSET_COUNT] = {
+    {{AssetKind::FONT,  FONT_FILE, 24, false}, StateBit(GameState::MAIN_MENU), "Game"},
+    {{AssetKind::FONT,  FONT_FILE, 20, false}, StateBit(GameState::VICTORY), "Game"},
+    {{AssetKind::FONT,  FONT_FILE, 14, false}, StateBit(GameState::LEVEL_SELECTION), "Game"},
+    {{AssetKind::FONT,  FONT_FILE, 10, false}, StateBit(GameState::MAIN_MENU) | StateBit(GameState::VICTORY), "Game"},
+    {{AssetKind::FONT,  FONT_FILE, 8, false},  SCOPE_ALL, "Game"}, // Tela de carregamento
+    {{AssetKind::IMAGE, "assets/menu_background.png", 0, false},   StateBit(GameState::MAIN_MENU), "Game"},
+    {{AssetKind::MUSIC, "assets/sounds/menu_music.mp3", 0, false}, SCOPE_MENU, "AudioSystem"},
+    {{AssetKind::SOUND, "assets/sounds/success.wav", 0, false},    SCOPE_MENU, "AudioSystem"}, // Sem select.wav próprio
+    {{AssetKind::FONT,  FONT_FILE, 10, false}, StateBit(GameState::DIALOGUE), "DialogueSystem"},
+    {{AssetKind::FONT,  FONT_FILE, 8, false},  StateBit(GameState::DIALOGUE), "DialogueSystem"},
+    {{AssetKind::FONT,  FONT_FILE, 10, false}, SCOPE_ALL, "AchievementSystem"}, // Avisos em qualquer tela
+    {{AssetKind::FONT,  FONT_FILE, 8, false},  SCOPE_ALL, "AchievementSystem"},
+    {{AssetKind::FONT,  FONT_FILE, 8, false},  StateBit(GameState::PUZZLE), "CircuitPuzzle"},
+    {{AssetKind::FONT,  FONT_FILE, 8, false},  SCOPE_ALL, "PerfMonitor"},
+    {{AssetKind::IMAGE, "assets/tileset_circuit.png", 0, false},     SCOPE_LEVEL, "TileMap"},
+    {{AssetKind::IMAGE, "assets/tileset_objects.png", 0, false},     SCOPE_LEVEL, "CircuitSystem"},
+    {{AssetKind::IMAGE, "assets/player_scifi.png", 0, true},         SCOPE_LEVEL, "Player"},
+    {{AssetKind::IMAGE, "assets/prof_leo.png", 0, false},            StateBit(GameState::DIALOGUE), "DialogueSystem"},
+    {{AssetKind::IMAGE, "assets/components.png", 0, false},          StateBit(GameState::PUZZLE), "CircuitPuzzle"},
+    {{AssetKind::SOUND, "assets/sounds/success.wav", 0, false},      SCOPE_LEVEL, "AudioSystem"},
+    {{AssetKind::SOUND, "assets/sounds/error.wav", 0, false},        SCOPE_LEVEL, "AudioSystem"},
+    {{AssetKind::SOUND, "assets/sounds/explosion.wav", 0, false},    SCOPE_LEVEL, "AudioSystem"},
+    {{AssetKind::MUSIC, "assets/sounds/game_music.mp3", 0, false},
+     StateBit(GameState::EXPLORATION) | StateBit(GameState::DIALOGUE) | StateBit(GameState::VICTORY), "AudioSystem"},
+    {{AssetKind::MUSIC, "assets/sounds/puzzle_music.mp3", 0, false}, StateBit(GameState::PUZZLE), "AudioSystem"}
+};
 
 Game::Game()
     : window(nullptr), renderer(nullptr), running(false),
       currentState(GameState::MAIN_MENU),
+      assetScopeReady(false), scopeCounter(0),
       tilesetTexture(nullptr), objectsTexture(nullptr), menuBackgroundTexture(nullptr),
+      fontTitle(nullptr), fontLarge(nullptr), fontHeading(nullptr), fontMenu(nullptr), fontSmall(nullptr),
       tileMap(nullptr), camera(nullptr),
-      lastFrameTime(0),
-      puzzleTriggerX(6), puzzleTriggerY(4),
-      puzzleSolved(false), lastPuzzleResult(PuzzleResult::NONE),
+      renderAlpha(1.0f), pacingMode(PacingMode::VSYNC), headless(false), frameLimit(0), frameCount(0),
+      renderThreadMode(RenderThreadMode::PIPELINED), jobThreads(0),
+      randomSeed(1),
+      spawnX(9), spawnY(7),
+      puzzleTriggerId(-1),
+      puzzleSolved(false), victoryAfterDialogue(false), lastPuzzleResult(PuzzleResult::NONE),
       pendingPuzzleId(0), firstTimePuzzle(true), puzzleFails(0),
       mainMenuSelection(0), levelSelection(1) {
 }
 
+bool Game::BuildAssetPack(const std::string& file) {
+    AssetDesc descs[ASSET_COUNT];
+    for (int i = 0; i < ASSET_COUNT; ++i) descs[i] = GAME_ASSETS[i].desc;
+    return AssetPack::Build(descs, ASSET_COUNT, file.c_str());
+}
+
 Game::~Game() {
     if (tileMap) delete tileMap;
     if (camera) delete camera;
@@ -24,7 +111,25 @@ Game::~Game() {
 }
 
 bool Game::Initialize() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
+    TRACE_ZONE("Game::Initialize");
+    scopeCounter = SDL_GetPerformanceCounter();
+    // Antes de abrir a janela: um --replay/--record que não abre não pode virar uma partida ao vivo
+    // (teste de regressão que "passa" sem ter reproduzido nada)
+    if (!replayFile.empty()) {
+        if (!inputRecorder.StartPlayback(replayFile)) return false;
+        randomSeed = inputRecorder.GetSeed();
+    } else if (!recordFile.empty()) {
+        if (!inputRecorder.StartRecording(recordFile, randomSeed)) return false;
+    }
+    Uint32 sdlFlags = SDL_INIT_VIDEO | SDL_INIT_AUDIO;
+    if (headless) {
+        // Driver dummy por padrão; SDL_VIDEODRIVER=offscreen no ambiente continua valendo
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        sdlFlags = SDL_INIT_VIDEO;
+        if (pacingMode == PacingMode::VSYNC) pacingMode = PacingMode::UNCAPPED; // Não há monitor
+        std::cout << "[GAME] Headless mode (video driver " << SDL_getenv("SDL_VIDEODRIVER") << ", no audio)\n";
+    }
+    if (SDL_Init(sdlFlags) != 0) {
         std::cerr << "Failed to initialize SDL: " << SDL_GetError() << "\n";
         return false;
     }
@@ -46,7 +151,7 @@ bool Game::Initialize() {
         SDL_WINDOWPOS_CENTERED,
         SCREEN_WIDTH,
         SCREEN_HEIGHT,
-        0
+        headless ? SDL_WINDOW_HIDDEN : 0
     );
 
     if (!window) {
@@ -55,7 +160,9 @@ bool Game::Initialize() {
         return false;
     }
 
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+    if (pacingMode == PacingMode::VSYNC) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (!renderer) {
         std::cerr << "Failed to create renderer: " << SDL_GetError() << "\n";
         SDL_DestroyWindow(window);
@@ -64,159 +171,318 @@ bool Game::Initialize() {
         return false;
     }
 
-    if (!player.Initialize(renderer)) {
-        std::cerr << "Failed to initialize player\n";
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        IMG_Quit();
-        SDL_Quit();
-        return false;
-    }
-
-    SDL_Surface* tileSurface = IMG_Load("assets/tileset_circuit.png");
-    if (!tileSurface) {
-        std::cerr << "Failed to load tileset_circuit: " << IMG_GetError() << "\n";
-        player.Shutdown();
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        IMG_Quit();
-        SDL_Quit();
-        return false;
-    }
-    tilesetTexture = SDL_CreateTextureFromSurface(renderer, tileSurface);
-    SDL_FreeSurface(tileSurface);
-
-    if (!tilesetTexture) {
-        std::cerr << "Failed to create tileset texture: " << SDL_GetError() << "\n";
-        return false;
-    }
-
-    tileMap = new TileMap();
-    if (!tileMap->LoadFromFile("assets/map1.csv")) {
-        std::cerr << "Warning: Could not load assets/map1.csv. Creating fallback map.\n";
-        delete tileMap;
-        tileMap = new TileMap(24, 16);
-        for (int y = 0; y < 16; ++y) {
-            for (int x = 0; x < 24; ++x) {
-                bool solid = (x == 0 || y == 0 || x == 23 || y == 15);
-                tileMap->SetTile(x, y, solid ? 16 : 0, solid);
+    // Imagens, sons e fontes carregam em segundo plano; cada estado espera só os seus (AssetsReadyFor)
+    if (!headless) audioSystem.Initialize(); // Não é fatal se falhar; sem ele os sons viram log
+    assetLoader.SetAudioEnabled(audioSystem.IsInitialized());
+    if (assetPack.Open(ASSET_PACK_FILE)) assetLoader.SetPack(&assetPack);
+    assetRefs.resize(ASSET_COUNT);
+    boundAssets.assign(ASSET_COUNT, nullptr);
+    if (stressScene.IsEnabled()) currentState = GameState::EXPLORATION; // A cena começa direto na fase
+    UpdateAssetScope();
+    assetLoader.Start(ASSET_LOADER_THREADS);
+
+    if (stressScene.IsEnabled()) {
+        tileMap = stressScene.GenerateMap();
+        std::cout << "[STRESS] Generated " << tileMap->GetWidth() << "x" << tileMap->GetHeight() << " map\n";
+    } else {
+        tileMap = new TileMap();
+        if (!tileMap->LoadFromFile("assets/map1.csv")) {
+            std::cerr << "Warning: Could not load assets/map1.csv. Creating fallback map.\n";
+            delete tileMap;
+            tileMap = new TileMap(24, 16);
+            for (int y = 0; y < 16; ++y) {
+                for (int x = 0; x < 24; ++x) {
+                    bool solid = (x == 0 || y == 0 || x == 23 || y == 15);
+                    tileMap->SetTile(x, y, solid ? 16 : 0, solid);
+                }
             }
         }
     }
 
-    tileMap->SetTilesetTexture(tilesetTexture);
-
-    // Configurando Circuit System (Objetos do Labirinto)
-    SDL_Surface* objSurface = IMG_Load("assets/tileset_objects.png");
-    if (!objSurface) {
-        std::cerr << "Warning: Could not load assets/tileset_objects.png: " << IMG_GetError() << "\n";
+    // Configurando Circuit System (Objetos do Labirinto); a textura chega com o grupo GAME
+    circuitSystem.Initialize(nullptr);
+    circuitSystem.SetTileMap(tileMap);
+    hazardField.Build(*tileMap);
+    triggerSystem.Initialize(tileMap->GetWidth(), tileMap->GetHeight());
+
+    // Switches, portas, gatilhos e NPCs vêm da camada de objetos, lida em segundo plano
+    // enquanto o menu roda (ApplyLevelObjects quando terminar)
+    if (stressScene.IsEnabled()) {
+        LevelObjects objects;
+        stressScene.GenerateObjects(objects);
+        ApplyLevelObjects(objects);
+        std::cout << "[STRESS] " << objects.elements.size() << " circuit elements, " << objects.triggers.size()
+                  << " triggers, " << objects.npcs.size() << " NPCs\n";
     } else {
-        objectsTexture = SDL_CreateTextureFromSurface(renderer, objSurface);
-        SDL_FreeSurface(objSurface);
+        levelLoader.Start("assets/map1_objects.txt");
     }
 
-    SDL_Surface* menuBgSurf = IMG_Load("assets/menu_background.png");
-    if (!menuBgSurf) {
-        std::cerr << "Warning: Could not load assets/menu_background.png: " << IMG_GetError() << "\n";
-    } else {
-        menuBackgroundTexture = SDL_CreateTextureFromSurface(renderer, menuBgSurf);
-        SDL_FreeSurface(menuBgSurf);
-    }
-
-    circuitSystem.Initialize(objectsTexture);
-    // Switch de ID 1 na posição 3,7
-    circuitSystem.AddElement(CircuitType::SWITCH, 1, 3, 7);
-    // Porta de ID 1 na posição 4,14 (Saída)
-    circuitSystem.AddElement(CircuitType::DOOR, 1, 4, 14);
-
-    // Bancada de trabalho principal (para o puzzle)
-    puzzleTriggerX = 18;
-    puzzleTriggerY = 12;
-
-    // Decorações extras
-    circuitSystem.AddElement(CircuitType::SWITCH, 99, 10, 8); // Apenas decorativo
-    circuitSystem.AddElement(CircuitType::SWITCH, 99, 11, 8);
-    circuitSystem.AddElement(CircuitType::SWITCH, 99, 12, 8);
-
     camera = new Camera(SCREEN_WIDTH, SCREEN_HEIGHT);
     player.SetTileMap(tileMap);
     player.SetCircuitSystem(&circuitSystem);
-    player.SetWorldPos(9, 7);
+    player.SetWorldPos(spawnX, spawnY);
 
     // Inicializa novos subsistemas da Fase 1
-    if (!circuitPuzzle.Initialize(renderer)) {
+    if (!circuitPuzzle.Initialize()) {
         std::cerr << "Warning: CircuitPuzzle initialization had issues\n";
     }
 
-    if (!dialogueSystem.Initialize(renderer)) {
+    if (!dialogueSystem.Initialize()) {
         std::cerr << "Warning: DialogueSystem initialization had issues\n";
     }
 
-    if (!achievementSystem.Initialize(renderer)) {
+    if (!achievementSystem.Initialize()) {
         std::cerr << "Warning: AchievementSystem initialization had issues\n";
     }
 
-    audioSystem.Initialize(); // Não é fatal se falhar
-    audioSystem.PlayBGM(AudioSystem::BGMType::MENU);
+    perfMonitor.Initialize();
+
+    jobSystem.Initialize(jobThreads);
+    vfx.SetJobSystem(&jobSystem);
+    circuitSystem.SetJobSystem(&jobSystem);
+    hazardField.SetJobSystem(&jobSystem);
+    circuitPuzzle.SetJobSystem(&jobSystem);
+    botPlayer.SetJobSystem(&jobSystem);
+
+    vfx.Seed(randomSeed);
+    if (botPlayer.IsEnabled() && inputRecorder.IsPlaying()) {
+        std::cout << "[BOT] Replay active, bot disabled\n";
+        botPlayer.Disable();
+    }
+    if (botPlayer.IsEnabled()) botPlayer.Start(randomSeed);
+    // Gravando ou reproduzindo, a carga termina antes do primeiro quadro: as telas de carregamento
+    // (quadros sem simulação) caem nos mesmos quadros em toda execução
+    if (inputRecorder.IsActive()) assetLoader.Wait();
+
+    audioSystem.PlayBGM(AudioSystem::BGMType::MENU); // Toca quando a música chegar
     hardwareInterface.Initialize();
 
-    lastFrameTime = SDL_GetTicks();
+    // Render no ritmo do monitor (120/144 Hz também); a simulação continua em FPS ticks/s
+    int refreshHz = FPS;
+    SDL_DisplayMode mode;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) == 0 && mode.refresh_rate > 0) {
+        refreshHz = mode.refresh_rate;
+    }
+    // Daqui em diante o renderer é da RenderThread (texturas já carregadas continuam válidas)
+    renderThread.Initialize(window, renderer, renderThreadMode);
+    framePacer.Initialize(&renderThread, pacingMode, refreshHz);
+    std::cout << "[GAME] Simulation at " << FPS << " Hz, display " << refreshHz << " Hz\n";
+
+    if (stressScene.IsEnabled()) {
+        // Direto para a exploração; --frames manda na duração, senão vale a da cena
+        StressConfig config = stressScene.GetConfig();
+        if (frameLimit > 0) config.frames = frameLimit;
+        else frameLimit = config.frames;
+        stressScene.Enable(config);
+        audioSystem.PlayBGM(AudioSystem::BGMType::GAME);
+    }
+
     running = true;
 
     return true;
 }
 
 void Game::Run() {
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+    Uint64 jobStatsCounter = lastCounter;
+
     while (running) {
-        Uint32 frameStart = SDL_GetTicks();
-        float deltaTime = (frameStart - lastFrameTime) / 1000.0f;
-        if (deltaTime > 0.1f) deltaTime = 0.1f; // Cap para evitar saltos
-        lastFrameTime = frameStart;
+        TRACE_ZONE("Frame");
+        perfMonitor.BeginFrame();
+        if (!inputRecorder.BeginFrame()) {
+            running = false; // Fim do log de replay
+            break;
+        }
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        double frameSeconds = (frameStart - lastCounter) / frequency;
+        lastCounter = frameStart;
+        if (frameSeconds > MAX_FRAME_TIME) frameSeconds = MAX_FRAME_TIME; // Cap para evitar saltos (janela arrastada, breakpoint)
+        // Headless: um tick por quadro, o mais rápido possível (mesma simulação em qualquer máquina)
+        accumulator += headless ? SIM_DT : frameSeconds;
+
+        // Assets do estado atual ainda carregando: a entrada é descartada (só fechar conta) e a
+        // simulação espera, com a tela de carregamento no lugar
+        bool loading = !AssetsReadyFor(currentState);
+        {
+            TRACE_ZONE("Game::HandleInput");
+            PerfScope input(perfMonitor, PerfSection::INPUT);
+            if (loading) {
+                SDL_Event event;
+                while (NextInputEvent(event)) {
+                    if (event.type == SDL_QUIT) running = false;
+                }
+            } else {
+                if (botPlayer.IsEnabled()) UpdateBot();
+                HandleInput();
+            }
+        }
 
-        HandleInput();
-        
-        // Update com deltaTime
-        switch (currentState) {
-            case GameState::MAIN_MENU:
-                Update_MainMenu(deltaTime);
-                break;
-            case GameState::LEVEL_SELECTION:
-                Update_LevelSelection(deltaTime);
-                break;
-            case GameState::EXPLORATION:
-                Update_Exploration();
-                break;
-            case GameState::PUZZLE:
-                Update_Puzzle(deltaTime);
-                break;
-            case GameState::DIALOGUE:
-                Update_Dialogue(deltaTime);
-                break;
-            case GameState::VICTORY:
-                Update_Victory(deltaTime);
-                break;
+        // Camada de objetos da fase: aplicada no frame em que a thread de carga termina.
+        // Gravando ou reproduzindo, espera a thread no primeiro frame para não depender do tempo de disco
+        if (levelLoader.IsLoading()) {
+            LevelObjects objects;
+            bool loaded = inputRecorder.IsActive() ? levelLoader.Wait(objects) : levelLoader.Poll(objects);
+            if (loaded) ApplyLevelObjects(objects);
         }
 
-        // VFX sempre atualiza
-        vfx.Update(deltaTime);
-        achievementSystem.Update(deltaTime);
+        // Simulação em passo fixo: a velocidade do jogo não depende da taxa de quadros
+        int steps = 0;
+        if (inputRecorder.IsPlaying()) {
+            // Replay: exatamente os ticks gravados neste quadro
+            for (int i = inputRecorder.GetFrameSteps(); i > 0 && running; --i) {
+                Update((float)SIM_DT);
+                ++steps;
+            }
+            accumulator = 0.0;
+        } else if (loading) {
+            accumulator = 0.0;
+        } else {
+            while (accumulator >= SIM_DT && steps < MAX_SIM_STEPS && running) {
+                Update((float)SIM_DT);
+                accumulator -= SIM_DT;
+                ++steps;
+            }
+            if (steps == MAX_SIM_STEPS) accumulator = 0.0; // Máquina lenta demais: descarta o atraso
+        }
+        TRACE_COUNTER("sim_steps", steps);
+        if (inputRecorder.IsActive()) {
+            inputRecorder.RecordSteps(steps);
+            if (!inputRecorder.EndFrame(ComputeStateHash())) running = false; // Divergência: para no quadro exato
+        }
 
+        // Fração do próximo tick já decorrida, para interpolar as posições desenhadas
+        renderAlpha = (float)(accumulator / SIM_DT);
         Render();
+        double frameMs = (SDL_GetPerformanceCounter() - frameStart) * 1000.0 / frequency;
+        if (stressScene.IsEnabled()) stressScene.RecordFrame(frameMs);
+        botPlayer.RecordFrame(frameMs, steps);
+        PerfMonitor::SetGauge(PerfCounter::PARTICLES, vfx.GetParticleCount());
+        PerfMonitor::SetGauge(PerfCounter::ASSET_KB, (int)(assetLoader.GetResidentBytes() / 1024));
+        TRACE_COUNTER("particles", vfx.GetParticleCount());
+
+        // Ociosidade dos workers desde a leitura anterior (inclui a espera do pacing)
+        JobStats jobStats = jobSystem.TakeStats();
+        Uint64 jobNow = SDL_GetPerformanceCounter();
+        int workerCount = jobSystem.GetThreadCount() - 1;
+        int jobIdle = 100;
+        if (workerCount > 0 && jobNow > jobStatsCounter) {
+            double busy = (double)jobStats.busyTicks / ((double)(jobNow - jobStatsCounter) * workerCount);
+            jobIdle = 100 - std::min(100, (int)(busy * 100.0 + 0.5));
+        }
+        jobStatsCounter = jobNow;
+        PerfMonitor::SetGauge(PerfCounter::JOBS, jobStats.jobs);
+        PerfMonitor::SetGauge(PerfCounter::JOB_STEALS, jobStats.steals);
+        PerfMonitor::SetGauge(PerfCounter::JOB_IDLE, jobIdle);
+        perfMonitor.EndFrame();
+        {
+            TRACE_ZONE("FramePacer::EndFrame");
+            framePacer.EndFrame();
+        }
+
+        if (frameLimit > 0 && ++frameCount >= frameLimit) {
+            std::cout << "[GAME] Frame limit reached (" << frameCount << " frames)\n";
+            running = false;
+        }
+    }
+    stressScene.Report();
+    botPlayer.Report();
+}
 
-        Uint32 frameTime = SDL_GetTicks() - frameStart;
-        if (FRAME_DELAY > frameTime) {
-            SDL_Delay(FRAME_DELAY - frameTime);
+bool Game::NextInputEvent(SDL_Event& event) {
+    if (inputRecorder.IsPlaying()) {
+        // A janela continua sendo drenada, mas só fechar conta; o resto da entrada vem do log
+        SDL_Event real;
+        while (SDL_PollEvent(&real)) {
+            if (real.type == SDL_QUIT) running = false;
+        }
+        return inputRecorder.NextEvent(event);
+    }
+    if (botPlayer.IsEnabled()) {
+        // Teclas vêm do bot e são gravadas como as de um jogador; a janela só conta para fechar
+        SDL_Event real;
+        while (SDL_PollEvent(&real)) {
+            if (real.type == SDL_QUIT) running = false;
         }
+        if (!botPlayer.NextEvent(event)) return false;
+        inputRecorder.RecordEvent(event);
+        return true;
+    }
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT || event.type == SDL_KEYDOWN) {
+            inputRecorder.RecordEvent(event);
+            return true;
+        }
+    }
+    return false;
+}
+
+Uint8 Game::SampleMovementKeys() {
+    if (inputRecorder.IsPlaying()) return inputRecorder.NextKeys();
+    Uint8 keys = 0;
+    if (stressScene.IsEnabled()) {
+        keys = stressScene.MovementKeys();
+    } else if (botPlayer.IsEnabled()) {
+        keys = botPlayer.MovementKeys();
+    } else {
+        const Uint8* keystate = SDL_GetKeyboardState(NULL);
+        if (keystate[SDL_SCANCODE_UP]) keys |= INPUT_KEY_UP;
+        if (keystate[SDL_SCANCODE_DOWN]) keys |= INPUT_KEY_DOWN;
+        if (keystate[SDL_SCANCODE_LEFT]) keys |= INPUT_KEY_LEFT;
+        if (keystate[SDL_SCANCODE_RIGHT]) keys |= INPUT_KEY_RIGHT;
     }
+    inputRecorder.RecordKeys(keys);
+    return keys;
+}
+
+Uint64 Game::ComputeStateHash() const {
+    Uint64 hash = STATE_HASH_SEED;
+    hash = HashValue(hash, (int)currentState);
+    hash = HashValue(hash, puzzleSolved);
+    hash = HashValue(hash, puzzleFails);
+    hash = HashValue(hash, mainMenuSelection);
+    hash = HashValue(hash, levelSelection);
+    hash = HashValue(hash, dialogueSystem.IsActive());
+    hash = player.HashState(hash);
+    hash = circuitSystem.HashState(hash);
+    hash = hazardField.HashState(hash);
+    return vfx.HashState(hash);
+}
+
+void Game::UpdateBot() {
+    BotView view;
+    view.state = currentState;
+    view.mainMenuSelection = mainMenuSelection;
+    view.levelSelection = levelSelection;
+    view.playerX = player.GetGridX();
+    view.playerY = player.GetGridY();
+    const TriggerZone* bench = puzzleSolved ? nullptr : triggerSystem.GetTrigger(puzzleTriggerId);
+    view.hasGoal = bench != nullptr;
+    view.goalX = bench ? bench->markerX : 0;
+    view.goalY = bench ? bench->markerY : 0;
+    view.tileMap = tileMap;
+    view.circuitSystem = &circuitSystem;
+    view.puzzle = &circuitPuzzle;
+    botPlayer.Think(view);
 }
 
 void Game::HandleInput() {
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+    while (NextInputEvent(event)) {
         if (event.type == SDL_QUIT) {
             running = false;
             return;
         }
+        // F6: alterna o modo de ritmo de quadros (vsync / spin / uncapped); F7/F8: HUD e CSV de desempenho;
+        // F9: relatório dos assets residentes no console
+        if (event.type == SDL_KEYDOWN && event.key.repeat == 0) {
+            SDL_Keycode key = event.key.keysym.sym;
+            if (key == SDLK_F6) { framePacer.NextMode(); continue; }
+            if (key == SDLK_F7) { perfMonitor.ToggleHUD(); continue; }
+            if (key == SDLK_F8) { perfMonitor.ToggleCSV(); continue; }
+            if (key == SDLK_F9) { assetLoader.LogResidency(); continue; }
+        }
 
         // Dispatch por estado
         switch (currentState) {
@@ -239,7 +505,7 @@ void Game::HandleInput() {
                     if (event.key.keysym.sym == SDLK_SPACE || event.key.keysym.sym == SDLK_RETURN) {
                         audioSystem.PlaySelect();
                         if (levelSelection == 1) {
-                            currentState = GameState::EXPLORATION;
+                            ChangeState(GameState::EXPLORATION);
                             audioSystem.PlayBGM(AudioSystem::BGMType::GAME);
                             // Diálogo inicial
                             std::vector<std::string> intro = {"Ola Berta! Pronto para encarar a Fase 1?"};
@@ -253,28 +519,11 @@ void Game::HandleInput() {
             case GameState::EXPLORATION:
                 if (event.type == SDL_KEYDOWN && event.key.repeat == 0) {
                     if (event.key.keysym.sym == SDLK_SPACE || event.key.keysym.sym == SDLK_e) {
-                        // Checa se está perto do puzzle trigger
+                        // Zonas de gatilho na célula do player têm prioridade
                         int px = player.GetGridX();
                         int py = player.GetGridY();
-                        int dx = std::abs(px - puzzleTriggerX);
-                        int dy = std::abs(py - puzzleTriggerY);
-                        if (dx + dy <= 1 && !puzzleSolved) {
-                            if (firstTimePuzzle) {
-                                pendingPuzzleId = 1;
-                                std::vector<std::string> tutor = {
-                                    "Berta, vamos montar seu primeiro circuito!",
-                                    "O objetivo e fazer a energia sair da BATERIA e chegar no LED.",
-                                    "Mas cuidado! O LED e sensivel e precisa de um RESISTOR no caminho.",
-                                    "Se a energia for muito forte, o LED vai queimar!",
-                                    "Use as [SETAS] para mover e [SPACE] para colocar as pecas do inventario.",
-                                    "Nao esqueca de alinhar os FIOS usando a tecla [R] para rotacionar.",
-                                    "Quando achar que terminou, aperte [V] para VALIDAR seu circuito. Boa sorte!"
-                                };
-                                EnterDialogue("Prof. Leo", tutor);
-                                firstTimePuzzle = false;
-                            } else {
-                                EnterPuzzle(1);
-                            }
+                        if (triggerSystem.Interact(px, py)) {
+                            HandleTriggerEvents();
                             return;
                         }
                         // Interação normal com circuitos do mapa
@@ -302,8 +551,8 @@ void Game::HandleInput() {
                     if (event.key.keysym.sym == SDLK_SPACE || event.key.keysym.sym == SDLK_RETURN) {
                         dialogueSystem.Advance();
                         if (!dialogueSystem.IsActive()) {
-                            // Se for o diálogo final (após puzzleSolved), entra em Victory
-                            if (puzzleSolved) {
+                            // Se for o diálogo final (após resolver o puzzle), entra em Victory
+                            if (victoryAfterDialogue) {
                                 EnterVictory();
                             } else {
                                 ExitDialogue();
@@ -323,29 +572,25 @@ void Game::HandleInput() {
         }
     }
 
-    // Input contínuo apenas no modo exploração
-    if (currentState == GameState::EXPLORATION) {
-        HandleInput_Exploration();
-    }
 }
 
 void Game::HandleInput_Exploration() {
-    const Uint8* keystate = SDL_GetKeyboardState(NULL);
+    Uint8 keys = SampleMovementKeys();
     bool moving = false;
 
-    if (keystate[SDL_SCANCODE_UP]) {
+    if (keys & INPUT_KEY_UP) {
         player.MoveUp();
         moving = true;
     }
-    else if (keystate[SDL_SCANCODE_DOWN]) {
+    else if (keys & INPUT_KEY_DOWN) {
         player.MoveDown();
         moving = true;
     }
-    else if (keystate[SDL_SCANCODE_LEFT]) {
+    else if (keys & INPUT_KEY_LEFT) {
         player.MoveLeft();
         moving = true;
     }
-    else if (keystate[SDL_SCANCODE_RIGHT]) {
+    else if (keys & INPUT_KEY_RIGHT) {
         player.MoveRight();
         moving = true;
     }
@@ -361,20 +606,76 @@ void Game::HandleInput_Dialogue() {
     // Handled via event dispatch
 }
 
-void Game::Update() {
-    // Chamado pelo Run() via dispatch
+void Game::Update(float deltaTime) {
+    TRACE_ZONE("Game::Update");
+    // Um tick fixo de simulação (SIM_DT), chamado pelo Run() quantas vezes o acumulador permitir
+    if (stressScene.IsEnabled()) Update_Stress();
+    switch (currentState) {
+        case GameState::MAIN_MENU: {
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_MAIN_MENU);
+            Update_MainMenu(deltaTime);
+            break;
+        }
+        case GameState::LEVEL_SELECTION: {
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_LEVEL_SELECTION);
+            Update_LevelSelection(deltaTime);
+            break;
+        }
+        case GameState::EXPLORATION: {
+            // Input contínuo apenas no modo exploração, amostrado no ritmo da simulação
+            {
+                PerfScope scope(perfMonitor, PerfSection::INPUT);
+                HandleInput_Exploration();
+            }
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_EXPLORATION);
+            Update_Exploration(deltaTime);
+            break;
+        }
+        case GameState::PUZZLE: {
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_PUZZLE);
+            Update_Puzzle(deltaTime);
+            break;
+        }
+        case GameState::DIALOGUE: {
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_DIALOGUE);
+            Update_Dialogue(deltaTime);
+            break;
+        }
+        case GameState::VICTORY: {
+            PerfScope scope(perfMonitor, PerfSection::UPDATE_VICTORY);
+            Update_Victory(deltaTime);
+            break;
+        }
+    }
+
+    // VFX sempre atualiza
+    {
+        PerfScope scope(perfMonitor, PerfSection::UPDATE_VFX);
+        vfx.Update(deltaTime);
+    }
+    PerfScope scope(perfMonitor, PerfSection::UPDATE_ACHIEVEMENTS);
+    achievementSystem.Update(deltaTime);
 }
 
 void Game::Update_MainMenu(float deltaTime) {}
 void Game::Update_LevelSelection(float deltaTime) {}
 
-void Game::Update_Exploration() {
-    player.Update();
+void Game::Update_Exploration(float deltaTime) {
+    player.Update(deltaTime);
+    circuitSystem.SetPlayerCell(player.GetGridX(), player.GetGridY());
     circuitSystem.Update();
+    hazardField.Update();
+    triggerSystem.UpdatePlayerCell(player.GetGridX(), player.GetGridY());
+    HandleTriggerEvents();
+    if (hazardField.IsDangerous(player.GetGridX(), player.GetGridY())) {
+        HandleHazardDamage();
+    }
+}
 
-    // Centralizar câmera no player
-    int camX = player.GetWorldX() * SCALE + (TILE_SIZE * SCALE) / 2 - SCREEN_WIDTH / 2;
-    int camY = player.GetWorldY() * SCALE + (TILE_SIZE * SCALE) / 2 - SCREEN_HEIGHT / 2;
+void Game::UpdateCamera(float alpha) {
+    // Centralizar câmera no player (posição interpolada entre os dois últimos ticks)
+    int camX = player.GetRenderX(alpha) * SCALE + (TILE_SIZE * SCALE) / 2 - SCREEN_WIDTH / 2;
+    int camY = player.GetRenderY(alpha) * SCALE + (TILE_SIZE * SCALE) / 2 - SCREEN_HEIGHT / 2;
     int maxCamX = tileMap->GetWidth() * TILE_SIZE * SCALE - SCREEN_WIDTH;
     int maxCamY = tileMap->GetHeight() * TILE_SIZE * SCALE - SCREEN_HEIGHT;
     if (camX < 0) camX = 0;
@@ -395,103 +696,172 @@ void Game::Update_Dialogue(float deltaTime) {
 void Game::Update_Victory(float deltaTime) {
 }
 
+void Game::Update_Stress() {
+    int tick = stressScene.NextTick();
+    StressPhase phase = stressScene.GetPhase();
+
+    // O sinal atravessa a cadeia inteira de portas AND duas vezes por segundo
+    if (tick % 30 == 0) circuitSystem.ToggleSwitches(0);
+
+    // A cada 10 s o jogador salta para outra região: chunks, trilhas e gatilhos ainda frios
+    if (tick % 600 == 599 && currentState == GameState::EXPLORATION) {
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            int x = stressScene.Random(tileMap->GetWidth());
+            int y = stressScene.Random(tileMap->GetHeight());
+            if (!tileMap->GetTile(x, y).IsSolid() && !circuitSystem.IsSolid(x, y)) {
+                player.SetWorldPos(x, y);
+                break;
+            }
+        }
+    }
+
+    if (phase != StressPhase::WALK) {
+        // Tempestade: quatro nuvens espalhadas pela área visível
+        int cx = (int)player.GetWorldX() + TILE_SIZE / 2;
+        int cy = (int)player.GetWorldY() + TILE_SIZE / 2;
+        int perCloud = stressScene.GetConfig().smokePerTick / 4;
+        for (int i = 0; i < 4; ++i) {
+            vfx.TriggerSmoke(cx + stressScene.Random(192) - 96, cy + stressScene.Random(160) - 80, perCloud);
+        }
+    }
+
+    if (phase == StressPhase::DIALOGUE) {
+        if (currentState == GameState::EXPLORATION) {
+            EnterDialogue("Roteiro", stressScene.GetScript());
+        } else if (currentState == GameState::DIALOGUE && tick % 12 == 0) {
+            dialogueSystem.Advance(); // Completa o texto ou passa para a próxima fala
+            if (!dialogueSystem.IsActive()) ExitDialogue();
+        }
+    }
+}
+
 void Game::Render() {
+    TRACE_ZONE("Game::Render");
     // Aplica screen shake offset
     int shakeX = vfx.GetShakeOffsetX();
     int shakeY = vfx.GetShakeOffsetY();
+    RenderList& list = renderThread.BeginFrame(SCREEN_WIDTH, SCREEN_HEIGHT);
+    {
+        PerfScope scope(perfMonitor, PerfSection::ASSETS);
+        assetLoader.Update(list);
+        BindAssets();
+    }
+
+    if (!AssetsReadyFor(currentState)) {
+        {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_LOADING);
+            Render_Loading(list);
+        }
+        PresentFrame(list);
+        return;
+    }
 
     if (currentState == GameState::MAIN_MENU) {
-        Render_MainMenu();
-        SDL_RenderPresent(renderer);
+        {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_MAIN_MENU);
+            Render_MainMenu(list);
+        }
+        PresentFrame(list);
         return;
     }
     
     if (currentState == GameState::LEVEL_SELECTION) {
-        Render_LevelSelection();
-        SDL_RenderPresent(renderer);
+        {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_LEVEL_SELECTION);
+            Render_LevelSelection(list);
+        }
+        PresentFrame(list);
         return;
     }
 
-    SDL_SetRenderDrawColor(renderer, 20, 20, 40, 255);
-    SDL_RenderClear(renderer);
+    list.SetDrawColor(20, 20, 40, 255);
+    list.Clear();
+
+    if (currentState == GameState::EXPLORATION) UpdateCamera(renderAlpha);
 
     // Sempre renderiza o mapa de fundo
     int camX = camera->GetX() + shakeX;
     int camY = camera->GetY() + shakeY;
-    tileMap->Render(renderer, camX, camY, SCALE);
-    circuitSystem.Render(renderer, camX, camY, SCALE);
-
-    // Renderiza indicador do puzzle trigger
-    if (!puzzleSolved) {
-        int ptDrawX = puzzleTriggerX * 32 * SCALE - camX;
-        int ptDrawY = puzzleTriggerY * 32 * SCALE - camY;
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-
-        // Efeito visual Holográfico Sci-Fi
-        Uint32 ticks = SDL_GetTicks();
-        float pulse = (float)(std::sin(ticks / 150.0) * 0.5 + 0.5);
-        Uint8 alpha = (Uint8)(150 * pulse);
-
-        // 1. Base glowing circle / console outline (Ciano)
-        SDL_SetRenderDrawColor(renderer, 0, 255, 255, alpha);
-        for (int w = 0; w < 4; w++) {
-            SDL_Rect baseRect = {ptDrawX + 8 - w, ptDrawY + 32 * SCALE - 8 - w, 32 * SCALE - 16 + w*2, 8 + w*2};
-            SDL_RenderDrawRect(renderer, &baseRect);
-        }
-
-        // 2. Holograma de Ponto de Exclamação Flutuante
-        float floatY = (float)(std::sin(ticks / 200.0) * 8.0f);
-        SDL_SetRenderDrawColor(renderer, 255, 230, 0, 255); // Amarelo vibrante
-        int exX = ptDrawX + (32 * SCALE) / 2 - 4;
-        int exY = ptDrawY - 15 + (int)floatY;
-        SDL_Rect exclamLine = {exX, exY - 20, 8, 16};
-        SDL_Rect exclamDot = {exX, exY, 8, 8};
-        SDL_RenderFillRect(renderer, &exclamLine);
-        SDL_RenderFillRect(renderer, &exclamDot);
-
-        // 3. Feixes de luz holográficos (linhas verticais subindo da base)
-        SDL_SetRenderDrawColor(renderer, 0, 255, 255, alpha / 3);
-        for (int i = 0; i < 5; i++) {
-            int lineX = ptDrawX + 12 + i * (32 * SCALE - 24) / 4;
-            SDL_RenderDrawLine(renderer, lineX, ptDrawY + 32 * SCALE - 10, lineX, exY + 10);
-        }
+    {
+        PerfScope scope(perfMonitor, PerfSection::RENDER_EXPLORATION);
+        Render_Exploration(list, camX, camY);
     }
 
-    player.Render(renderer, camX, camY);
-
     // Efeitos atmosféricos e Vignette
-    Render_Vignette();
+    {
+        PerfScope scope(perfMonitor, PerfSection::RENDER_VIGNETTE);
+        Render_Vignette(list);
+    }
 
     // VFX em cima de tudo
-    vfx.Render(renderer, camX, camY, SCALE);
+    vfx.Render(list, camX, camY, SCALE);
 
-    // Indicador de Objetivo (Bússola) para exploração
-    if (currentState == GameState::EXPLORATION && !puzzleSolved) {
-        Render_ObjectiveIndicator();
+    // Indicador de Objetivo (Bússola) e vida para exploração
+    if (currentState == GameState::EXPLORATION) {
+        PerfScope scope(perfMonitor, PerfSection::RENDER_HUD);
+        if (!puzzleSolved) Render_ObjectiveIndicator(list);
+        Render_HealthHUD(list);
     }
 
     // Overlay de estado
     switch (currentState) {
-        case GameState::PUZZLE:
-            circuitPuzzle.Render(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+        case GameState::PUZZLE: {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_PUZZLE);
+            circuitPuzzle.Render(list, SCREEN_WIDTH, SCREEN_HEIGHT);
             break;
-        case GameState::DIALOGUE:
-            dialogueSystem.Render(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+        }
+        case GameState::DIALOGUE: {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_DIALOGUE);
+            dialogueSystem.Render(list, SCREEN_WIDTH, SCREEN_HEIGHT);
             break;
-        case GameState::VICTORY:
-            Render_Victory();
+        }
+        case GameState::VICTORY: {
+            PerfScope scope(perfMonitor, PerfSection::RENDER_VICTORY);
+            Render_Victory(list);
             break;
+        }
         default:
             break;
     }
 
-    achievementSystem.Render(renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+    {
+        PerfScope scope(perfMonitor, PerfSection::RENDER_ACHIEVEMENTS);
+        achievementSystem.Render(list, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+
+    PresentFrame(list);
+}
+
+void Game::Render_Exploration(RenderList& list, int camX, int camY) {
+    tileMap->Render(list, camX, camY, SCALE);
+    hazardField.Render(list, camX, camY, SCALE, SCREEN_WIDTH, SCREEN_HEIGHT);
+    circuitSystem.Render(list, camX, camY, SCALE);
+
+    // Hologramas das zonas de gatilho (bancada do puzzle)
+    triggerSystem.Render(list, camX, camY, SCALE, SCREEN_WIDTH, SCREEN_HEIGHT);
 
-    SDL_RenderPresent(renderer);
+    player.Render(list, camX, camY, renderAlpha);
 }
 
+void Game::PresentFrame(RenderList& list) {
+    perfMonitor.Render(list);
+    {
+        // PIPELINED: só espera se a thread de render ainda estiver no quadro anterior
+        TRACE_ZONE("RenderThread::Submit");
+        PerfScope scope(perfMonitor, PerfSection::PRESENT);
+        renderThread.Submit();
+    }
+
+    // Trabalho da thread de render desde o último quadro (em PIPELINED, o do quadro anterior)
+    RenderThreadStats stats = renderThread.TakeStats();
+    PerfMonitor::Count(PerfCounter::TEXTURE_CREATES, stats.textureCreates);
+    PerfMonitor::Count(PerfCounter::TTF_RENDERS, stats.ttfRenders);
+    perfMonitor.AddTime(PerfSection::RENDER_THREAD, stats.executeTicks);
+}
+
+
 void Game::EnterPuzzle(int puzzleId) {
-    currentState = GameState::PUZZLE;
+    ChangeState(GameState::PUZZLE);
     circuitPuzzle.LoadPuzzle(puzzleId);
     circuitPuzzle.Activate();
     audioSystem.PlayBGM(AudioSystem::BGMType::PUZZLE);
@@ -500,19 +870,19 @@ void Game::EnterPuzzle(int puzzleId) {
 }
 
 void Game::ExitPuzzle() {
-    currentState = GameState::EXPLORATION;
+    ChangeState(GameState::EXPLORATION);
     circuitPuzzle.Deactivate();
     audioSystem.PlayBGM(AudioSystem::BGMType::GAME);
     std::cout << "[GAME] Exiting puzzle\n";
 }
 
 void Game::EnterDialogue(const std::string& speaker, const std::vector<std::string>& messages, bool showPortrait) {
-    currentState = GameState::DIALOGUE;
+    ChangeState(GameState::DIALOGUE);
     dialogueSystem.ShowMessages(speaker, messages, showPortrait);
 }
 
 void Game::ExitDialogue() {
-    currentState = GameState::EXPLORATION;
+    ChangeState(GameState::EXPLORATION);
     std::cout << "[GAME] Dialogue finished\n";
     
     // Se havia um puzzle esperando o fim do diálogo (tutorial)
@@ -524,152 +894,212 @@ void Game::ExitDialogue() {
 }
 
 void Game::EnterVictory() {
-    currentState = GameState::VICTORY;
+    ChangeState(GameState::VICTORY);
     audioSystem.SetVolume(128);
     audioSystem.PlaySuccess();
     std::cout << "[GAME] Victory State Entered\n";
 }
 
-void Game::Render_Victory() {
+void Game::Render_Victory(RenderList& list) {
+    TRACE_ZONE("Game::Render_Victory");
     // Fundo preto semi-transparente
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 230);
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    list.SetDrawColor(0, 0, 0, 230);
     SDL_Rect screen = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderFillRect(renderer, &screen);
+    list.FillRect(screen);
 
     // Borda Neon dourada
-    SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
+    list.SetDrawColor(255, 200, 0, 255);
     SDL_Rect border = {50, 50, SCREEN_WIDTH - 100, SCREEN_HEIGHT - 100};
-    SDL_RenderDrawRect(renderer, &border);
+    list.DrawRect(border);
 
     // Texto de Vitória
-    TTF_Font* font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 20);
-    if (font) {
-        SDL_Color gold = {255, 215, 0, 255};
-        SDL_Surface* surf = TTF_RenderText_Solid(font, "FASE 1 COMPLETA!", gold);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_Rect dst = {SCREEN_WIDTH/2 - surf->w/2, 100, surf->w, surf->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
-        TTF_CloseFont(font);
-    }
-
-    TTF_Font* smallFont = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 10);
-    if (smallFont) {
-        SDL_Color white = {255, 255, 255, 255};
-        const char* msgs[] = {
-            "Voce provou ser um mestre dos circuitos!",
-            "O Professor Leo esta impressionado.",
-            "",
-            "Pressione ESPACO para Sair"
-        };
-        for(int i=0; i<4; i++) {
-            SDL_Surface* surf = TTF_RenderText_Solid(smallFont, msgs[i], white);
-            if (surf) {
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect dst = {SCREEN_WIDTH/2 - surf->w/2, 180 + i*25, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                SDL_DestroyTexture(tex);
-                SDL_FreeSurface(surf);
-            }
+    SDL_Color gold = {255, 215, 0, 255};
+    list.Text(fontLarge, "FASE 1 COMPLETA!", gold, SCREEN_WIDTH / 2, 100, TEXT_CENTER);
+
+    SDL_Color white = {255, 255, 255, 255};
+    const char* msgs[] = {
+        "Voce provou ser um mestre dos circuitos!",
+        "O Professor Leo esta impressionado.",
+        "",
+        "Pressione ESPACO para Sair"
+    };
+    for(int i=0; i<4; i++) {
+        list.Text(fontMenu, msgs[i], white, SCREEN_WIDTH / 2, 180 + i*25, TEXT_CENTER);
+    }
+}
+
+void Game::ChangeState(GameState state) {
+    currentState = state;
+    UpdateAssetScope();
+}
+
+void Game::UpdateAssetScope() {
+    // O estado atual e os prováveis seguintes; o resto é devolvido (descarrega no próximo Update do loader)
+    unsigned scope = StateBit(currentState) | STATE_PREFETCH[(int)currentState];
+    bool acquired = false;
+    for (int i = 0; i < ASSET_COUNT; ++i) {
+        bool wanted = (GAME_ASSETS[i].states & scope) != 0;
+        if (wanted && assetRefs[i].id < 0) {
+            assetRefs[i] = assetLoader.Acquire(GAME_ASSETS[i].desc, GAME_ASSETS[i].owner);
+            acquired = true;
+        } else if (!wanted && assetRefs[i].id >= 0) {
+            assetLoader.Release(assetRefs[i], GAME_ASSETS[i].owner);
         }
-        TTF_CloseFont(smallFont);
     }
+    // Gravando ou reproduzindo, a decodificação termina aqui: as telas de carregamento caem nos
+    // mesmos quadros em toda execução (o prefetch também, já que só é pedido nas transições)
+    if (acquired && inputRecorder.IsActive()) assetLoader.Wait();
+    assetScopeReady = AssetsReadyFor(currentState);
+    scopeCounter = SDL_GetPerformanceCounter();
+}
+
+bool Game::AssetsReadyFor(GameState state) const {
+    for (int i = 0; i < ASSET_COUNT; ++i) {
+        if (!(GAME_ASSETS[i].states & StateBit(state))) continue;
+        if (!assetLoader.IsLoaded(assetRefs[i])) return false;
+    }
+    return true;
+}
+
+void Game::BindAssets() {
+    auto font = [this](int asset) { return assetLoader.Get(assetRefs[asset].As<AssetKind::FONT>()); };
+    auto texture = [this](int asset) { return assetLoader.Get(assetRefs[asset].As<AssetKind::IMAGE>()); };
+    auto sound = [this](int asset) { return assetLoader.Get(assetRefs[asset].As<AssetKind::SOUND>()); };
+    auto music = [this](int asset) { return assetLoader.Get(assetRefs[asset].As<AssetKind::MUSIC>()); };
+
+    // Roda logo depois do Update do loader: um asset descarregado nele sai dos subsistemas antes de
+    // qualquer uso. Só repassa quando algum ponteiro mudou (chegou ou saiu do escopo)
+    bool changed = false;
+    for (int i = 0; i < ASSET_COUNT; ++i) {
+        const void* object = nullptr;
+        switch (GAME_ASSETS[i].desc.kind) {
+            case AssetKind::IMAGE: object = texture(i); break;
+            case AssetKind::SOUND: object = sound(i); break;
+            case AssetKind::MUSIC: object = music(i); break;
+            case AssetKind::FONT:  object = font(i); break;
+        }
+        if (object != boundAssets[i]) changed = true;
+        boundAssets[i] = object;
+    }
+    if (changed) {
+        fontTitle = font(ASSET_FONT_TITLE);
+        fontLarge = font(ASSET_FONT_LARGE);
+        fontHeading = font(ASSET_FONT_HEADING);
+        fontMenu = font(ASSET_FONT_MENU);
+        fontSmall = font(ASSET_FONT_SMALL);
+        menuBackgroundTexture = texture(ASSET_MENU_BACKGROUND);
+        tilesetTexture = texture(ASSET_TILESET);
+        objectsTexture = texture(ASSET_OBJECTS);
+        dialogueSystem.SetFonts(font(ASSET_DIALOGUE_FONT), font(ASSET_DIALOGUE_FONT_SMALL));
+        dialogueSystem.SetPortrait(texture(ASSET_PORTRAIT));
+        achievementSystem.SetFonts(font(ASSET_ACHIEVEMENT_FONT), font(ASSET_ACHIEVEMENT_FONT_SMALL));
+        circuitPuzzle.SetFont(font(ASSET_PUZZLE_FONT));
+        circuitPuzzle.SetComponentTexture(texture(ASSET_COMPONENTS));
+        perfMonitor.SetFont(font(ASSET_PERF_FONT));
+        tileMap->SetTilesetTexture(tilesetTexture);
+        circuitSystem.SetObjectTexture(objectsTexture);
+        player.SetTexture(texture(ASSET_PLAYER));
+        // O select do menu é o mesmo success.wav: fora da fase vale a referência do menu
+        Mix_Chunk* select = sound(ASSET_SOUND_SELECT) ? sound(ASSET_SOUND_SELECT) : sound(ASSET_SOUND_SUCCESS);
+        audioSystem.SetSounds(sound(ASSET_SOUND_SUCCESS), sound(ASSET_SOUND_ERROR), sound(ASSET_SOUND_EXPLOSION), select);
+        audioSystem.SetMusic(AudioSystem::BGMType::MENU, music(ASSET_MENU_MUSIC));
+        audioSystem.SetMusic(AudioSystem::BGMType::GAME, music(ASSET_GAME_MUSIC));
+        audioSystem.SetMusic(AudioSystem::BGMType::PUZZLE, music(ASSET_PUZZLE_MUSIC));
+    }
+
+    // Transição que caiu na tela de carregamento (o prefetch não chegou a tempo)
+    if (!assetScopeReady && AssetsReadyFor(currentState)) {
+        assetScopeReady = true;
+        double frequency = (double)SDL_GetPerformanceFrequency();
+        std::cout << "[ASSETS] " << STATE_NAMES[(int)currentState] << " ready after "
+                  << (SDL_GetPerformanceCounter() - scopeCounter) * 1000.0 / frequency << " ms ("
+                  << assetLoader.GetResidentBytes() / 1024 << " KB resident)\n";
+    }
+    if (running && assetScopeReady && (StateBit(currentState) & SCOPE_LEVEL) &&
+        (!tilesetTexture || !texture(ASSET_PLAYER))) {
+        std::cerr << "Failed to load the tileset or the player sprite\n";
+        running = false;
+    }
+}
+
+void Game::Render_Loading(RenderList& list) {
+    TRACE_ZONE("Game::Render_Loading");
+    list.SetDrawColor(10, 10, 20, 255);
+    list.Clear();
+
+    // Só retângulos: a barra aparece antes de qualquer asset; o texto, quando a fonte chegar
+    int total = 0;
+    int ready = 0;
+    for (int i = 0; i < ASSET_COUNT; ++i) {
+        if (!(GAME_ASSETS[i].states & StateBit(currentState))) continue;
+        total++;
+        if (assetLoader.IsLoaded(assetRefs[i])) ready++;
+    }
+    SDL_Rect outline = {SCREEN_WIDTH / 2 - 150, SCREEN_HEIGHT / 2 - 8, 300, 16};
+    SDL_Rect bar = {outline.x + 3, outline.y + 3, total > 0 ? (outline.w - 6) * ready / total : 0, outline.h - 6};
+    list.SetDrawColor(0, 255, 255, 255);
+    list.DrawRect(outline);
+    list.FillRect(bar);
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "CARREGANDO %d%%", total > 0 ? ready * 100 / total : 100);
+    SDL_Color white = {255, 255, 255, 255};
+    list.Text(fontSmall, buf, white, SCREEN_WIDTH / 2, outline.y - 20, TEXT_CENTER);
 }
 
 void Game::EnterMainMenu() {
-    currentState = GameState::MAIN_MENU;
+    ChangeState(GameState::MAIN_MENU);
     audioSystem.PlayBGM(AudioSystem::BGMType::MENU);
 }
 
 void Game::EnterLevelSelection() {
-    currentState = GameState::LEVEL_SELECTION;
+    ChangeState(GameState::LEVEL_SELECTION);
 }
 
-void Game::Render_MainMenu() {
+void Game::Render_MainMenu(RenderList& list) {
+    TRACE_ZONE("Game::Render_MainMenu");
     // Fundo da imagem
     if (menuBackgroundTexture) {
-        SDL_RenderCopy(renderer, menuBackgroundTexture, nullptr, nullptr);
+        list.Copy(menuBackgroundTexture, nullptr, nullptr);
         
         // Overlay escuro para melhorar legibilidade
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150); // Preto com ~60% de opacidade
+        list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+        list.SetDrawColor(0, 0, 0, 150); // Preto com ~60% de opacidade
         SDL_Rect fullScreen = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-        SDL_RenderFillRect(renderer, &fullScreen);
+        list.FillRect(fullScreen);
     } else {
-        SDL_SetRenderDrawColor(renderer, 10, 10, 20, 255);
-        SDL_RenderClear(renderer);
-    }
-
-
-    TTF_Font* fontBig = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 24);
-    if (fontBig) {
-        // Sombra do título
-        SDL_Color shadow = {0, 100, 200, 255};
-        SDL_Surface* surfS = TTF_RenderText_Solid(fontBig, "CIRCUIT ESCAPE", shadow);
-        if (surfS) {
-            SDL_Texture* texS = SDL_CreateTextureFromSurface(renderer, surfS);
-            SDL_Rect dstS = {SCREEN_WIDTH / 2 - surfS->w / 2 + 3, 83, surfS->w, surfS->h};
-            SDL_RenderCopy(renderer, texS, nullptr, &dstS);
-            SDL_DestroyTexture(texS);
-            SDL_FreeSurface(surfS);
-        }
-
-        SDL_Color neon = {0, 255, 255, 255};
-        SDL_Surface* surf = TTF_RenderText_Solid(fontBig, "CIRCUIT ESCAPE", neon);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_Rect dst = {SCREEN_WIDTH / 2 - surf->w / 2, 80, surf->w, surf->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
-        TTF_CloseFont(fontBig);
-    }
-
-    TTF_Font* font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 10);
-    if (font) {
-        SDL_Color white = {255, 255, 255, 255};
-        SDL_Color yellow = {255, 255, 0, 255};
-
-        const char* options[] = {"INICIAR JOGO", "SAIR"};
-        for (int i = 0; i < 2; i++) {
-            SDL_Color col = (i == mainMenuSelection) ? yellow : white;
-            const char* prefix = (i == mainMenuSelection) ? "> " : "  ";
-            char buf[32]; snprintf(buf, 32, "%s%s", prefix, options[i]);
-            SDL_Surface* surf = TTF_RenderText_Solid(font, buf, col);
-            if (surf) {
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect dst = {SCREEN_WIDTH / 2 - surf->w / 2, 220 + i * 30, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                SDL_DestroyTexture(tex);
-                SDL_FreeSurface(surf);
-            }
-        }
-        TTF_CloseFont(font);
+        list.SetDrawColor(10, 10, 20, 255);
+        list.Clear();
     }
-}
 
-void Game::Render_LevelSelection() {
-    SDL_SetRenderDrawColor(renderer, 10, 15, 40, 255);
-    SDL_RenderClear(renderer);
 
-    TTF_Font* titleFont = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 14);
-    if (titleFont) {
-        SDL_Color white = {255, 255, 255, 255};
-        SDL_Surface* surf = TTF_RenderText_Solid(titleFont, "SELECIONE A FASE", white);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_Rect dst = {SCREEN_WIDTH / 2 - surf->w / 2, 60, surf->w, surf->h};
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
-        }
-        TTF_CloseFont(titleFont);
+    // Sombra do título
+    SDL_Color shadow = {0, 100, 200, 255};
+    list.Text(fontTitle, "CIRCUIT ESCAPE", shadow, SCREEN_WIDTH / 2 + 3, 83, TEXT_CENTER);
+
+    SDL_Color neon = {0, 255, 255, 255};
+    list.Text(fontTitle, "CIRCUIT ESCAPE", neon, SCREEN_WIDTH / 2, 80, TEXT_CENTER);
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color yellow = {255, 255, 0, 255};
+
+    const char* options[] = {"INICIAR JOGO", "SAIR"};
+    for (int i = 0; i < 2; i++) {
+        SDL_Color col = (i == mainMenuSelection) ? yellow : white;
+        const char* prefix = (i == mainMenuSelection) ? "> " : "  ";
+        char buf[32]; snprintf(buf, 32, "%s%s", prefix, options[i]);
+        list.Text(fontMenu, buf, col, SCREEN_WIDTH / 2, 220 + i * 30, TEXT_CENTER);
     }
+}
+
+void Game::Render_LevelSelection(RenderList& list) {
+    TRACE_ZONE("Game::Render_LevelSelection");
+    list.SetDrawColor(10, 15, 40, 255);
+    list.Clear();
+
+    SDL_Color white = {255, 255, 255, 255};
+    list.Text(fontHeading, "SELECIONE A FASE", white, SCREEN_WIDTH / 2, 60, TEXT_CENTER);
 
     // Renderiza cards das fases
     for (int i = 1; i <= 3; i++) {
@@ -678,13 +1108,13 @@ void Game::Render_LevelSelection() {
         SDL_Rect card = {x, y, 120, 150};
         
         if (i == levelSelection) {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
-            SDL_RenderDrawRect(renderer, &card);
+            list.SetDrawColor(0, 255, 255, 255);
+            list.DrawRect(card);
             SDL_Rect inner = {card.x + 2, card.y + 2, card.w - 4, card.h - 4};
-            SDL_RenderDrawRect(renderer, &inner);
+            list.DrawRect(inner);
         } else {
-            SDL_SetRenderDrawColor(renderer, 50, 50, 80, 255);
-            SDL_RenderDrawRect(renderer, &card);
+            list.SetDrawColor(50, 50, 80, 255);
+            list.DrawRect(card);
         }
 
         // Desenha miniatura usando o tilesetTexture de forma criativa
@@ -697,50 +1127,33 @@ void Game::Render_LevelSelection() {
             SDL_Rect destRect = {x + 10, y + 10, 100, 100};
 
             // Escurece se estiver bloqueada
-            if (i > 1) SDL_SetTextureColorMod(tilesetTexture, 80, 80, 80);
-            SDL_RenderCopy(renderer, tilesetTexture, &srcRect, &destRect);
-            if (i > 1) SDL_SetTextureColorMod(tilesetTexture, 255, 255, 255); // Reset
-        }
-
-        TTF_Font* font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 8);
-        if (font) {
-            char buf[16]; snprintf(buf, 16, "FASE %d", i);
-            SDL_Color col = (i == levelSelection) ? SDL_Color{255,255,255,255} : SDL_Color{150,150,150,255};
-            SDL_Surface* surf = TTF_RenderText_Solid(font, buf, col);
-            if (surf) {
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                SDL_Rect dst = {x + card.w / 2 - surf->w / 2, y + 120, surf->w, surf->h};
-                SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                SDL_DestroyTexture(tex);
-                SDL_FreeSurface(surf);
-            }
-            if (i > 1) { // Fase 2 e 3 bloqueadas por enquanto
-                SDL_Surface* lock = TTF_RenderText_Solid(font, "BLOQUEADA", {255,0,0,255});
-                if (lock) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, lock);
-                    SDL_Rect dst = {x + card.w / 2 - lock->w / 2, y + 60, lock->w, lock->h};
-                    SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                    SDL_DestroyTexture(tex);
-                    SDL_FreeSurface(lock);
-                }
-            }
-            TTF_CloseFont(font);
+            // O color mod também é um comando: vale na ordem em que foi gravado
+            if (i > 1) list.SetTextureColorMod(tilesetTexture, 80, 80, 80);
+            list.Copy(tilesetTexture, &srcRect, &destRect);
+            if (i > 1) list.SetTextureColorMod(tilesetTexture, 255, 255, 255); // Reset
+        }
+
+        char buf[16]; snprintf(buf, 16, "FASE %d", i);
+        SDL_Color col = (i == levelSelection) ? SDL_Color{255,255,255,255} : SDL_Color{150,150,150,255};
+        list.Text(fontSmall, buf, col, x + card.w / 2, y + 120, TEXT_CENTER);
+        if (i > 1) { // Fase 2 e 3 bloqueadas por enquanto
+            list.Text(fontSmall, "BLOQUEADA", {255,0,0,255}, x + card.w / 2, y + 60, TEXT_CENTER);
         }
     }
 }
 
-void Game::Render_Vignette() {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+void Game::Render_Vignette(RenderList& list) {
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // 1. Tint Atmosférico (Azul profundo sutil para clima Sci-Fi)
-    SDL_SetRenderDrawColor(renderer, 5, 10, 30, 60); 
+    list.SetDrawColor(5, 10, 30, 60); 
     SDL_Rect fullScreen = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-    SDL_RenderFillRect(renderer, &fullScreen);
+    list.FillRect(fullScreen);
 
     // 2. Efeito Vignette Circular (Simulado com gradientes lineares nas bordas)
     for (int i = 0; i < 6; i++) {
         Uint8 alpha = (Uint8)(120 - (i * 15));
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, alpha);
+        list.SetDrawColor(0, 0, 0, alpha);
         
         int thickness = 30 + i * 15;
         // Desenha moldura de sombra gradual
@@ -750,16 +1163,17 @@ void Game::Render_Vignette() {
             {0, 0, thickness, SCREEN_HEIGHT}, // Left
             {SCREEN_WIDTH - thickness, 0, thickness, SCREEN_HEIGHT}  // Right
         };
-        for(int j=0; j<4; j++) SDL_RenderFillRect(renderer, &rects[j]);
+        list.FillRects(rects, 4);
     }
 }
 
-void Game::Render_ObjectiveIndicator() {
-    if (puzzleSolved) return;
+void Game::Render_ObjectiveIndicator(RenderList& list) {
+    const TriggerZone* bench = triggerSystem.GetTrigger(puzzleTriggerId);
+    if (puzzleSolved || !bench) return;
 
     // Posição alvo (Mundo)
-    float tx = (float)(puzzleTriggerX * 32 * SCALE + 16 * SCALE);
-    float ty = (float)(puzzleTriggerY * 32 * SCALE + 16 * SCALE);
+    float tx = (float)(bench->markerX * 32 * SCALE + 16 * SCALE);
+    float ty = (float)(bench->markerY * 32 * SCALE + 16 * SCALE);
 
     // Posição player (Tela)
     float px = (player.GetWorldX() * SCALE + 16 * SCALE) - camera->GetX();
@@ -789,26 +1203,116 @@ void Game::Render_ObjectiveIndicator() {
     pts[2] = { (int)(centerX + std::cos(angle - 2.4) * size), (int)(centerY + std::sin(angle - 2.4) * size) };
     pts[3] = pts[0];
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
     Uint32 ticks = SDL_GetTicks();
     float pulse = (float)(std::sin(ticks / 150.0) * 0.3 + 0.7);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, (Uint8)(200 * pulse));
+    list.SetDrawColor(255, 255, 0, (Uint8)(200 * pulse));
     
     // Desenha a seta
-    SDL_RenderDrawLines(renderer, pts, 4);
+    list.DrawLines(pts, 4);
     
     // Pequeno texto informativo
-    TTF_Font* font = TTF_OpenFont("assets/PressStart2P-Regular.ttf", 8);
-    if (font) {
-        SDL_Surface* surf = TTF_RenderText_Solid(font, "OBJETIVO", {255, 255, 0, 255});
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_Rect dst = { centerX - surf->w/2, centerY - 25, surf->w, surf->h };
-            SDL_RenderCopy(renderer, tex, nullptr, &dst);
-            SDL_DestroyTexture(tex);
-            SDL_FreeSurface(surf);
+    list.Text(fontSmall, "OBJETIVO", {255, 255, 0, 255}, centerX, centerY - 25, TEXT_CENTER);
+}
+
+void Game::Render_HealthHUD(RenderList& list) {
+    // Um bloco ciano por ponto de vida no canto superior esquerdo
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < PLAYER_MAX_HEALTH; ++i) {
+        SDL_Rect pip = {10 + i * 22, 10, 16, 16};
+        if (i < player.GetHealth()) {
+            list.SetDrawColor(0, 230, 255, 230);
+            list.FillRect(pip);
         }
-        TTF_CloseFont(font);
+        list.SetDrawColor(255, 255, 255, 180);
+        list.DrawRect(pip);
+    }
+}
+
+void Game::HandleHazardDamage() {
+    if (!player.TakeDamage(1)) return;
+
+    std::cout << "[GAME] Player shocked! Health: " << player.GetHealth() << "\n";
+    audioSystem.PlayError();
+    vfx.TriggerScreenShake(0.25f, 5.0f);
+    vfx.TriggerFlash({80, 200, 255, 120}, 0.2f);
+    vfx.TriggerSmoke(player.GetGridX() * 32 + 16, player.GetGridY() * 32 + 16, 8);
+    hardwareInterface.BlinkLED(0, 200, 255, 200);
+
+    if (player.GetHealth() <= 0) {
+        // Sem vida: volta para o ponto de renascimento com a vida cheia
+        player.SetWorldPos(spawnX, spawnY);
+        player.ResetHealth();
+    }
+}
+
+void Game::HandleTriggerEvents() {
+    TriggerFired fired;
+    while (triggerSystem.PollEvent(fired)) {
+        const TriggerZone* zone = triggerSystem.GetTrigger(fired.triggerId);
+        if (zone && zone->fireOn == fired.event) ExecuteTrigger(*zone);
+    }
+}
+
+void Game::ExecuteTrigger(const TriggerZone& zone) {
+    switch (zone.action) {
+        case TriggerAction::OPEN_PUZZLE:
+            if (firstTimePuzzle) {
+                pendingPuzzleId = zone.param;
+                std::vector<std::string> tutor = {
+                    "Berta, vamos montar seu primeiro circuito!",
+                    "O objetivo e fazer a energia sair da BATERIA e chegar no LED.",
+                    "Mas cuidado! O LED e sensivel e precisa de um RESISTOR no caminho.",
+                    "Se a energia for muito forte, o LED vai queimar!",
+                    "Use as [SETAS] para mover e [SPACE] para colocar as pecas do inventario.",
+                    "Nao esqueca de alinhar os FIOS usando a tecla [R] para rotacionar.",
+                    "Quando achar que terminou, aperte [V] para VALIDAR seu circuito. Boa sorte!"
+                };
+                EnterDialogue("Prof. Leo", tutor);
+                firstTimePuzzle = false;
+            } else {
+                EnterPuzzle(zone.param);
+            }
+            break;
+        case TriggerAction::START_DIALOGUE:
+            EnterDialogue(zone.speaker, zone.lines);
+            break;
+        case TriggerAction::TOGGLE_CIRCUIT:
+            circuitSystem.ToggleSwitches(zone.param);
+            break;
+    }
+}
+
+void Game::ApplyLevelObjects(LevelObjects& objects) {
+    circuitSystem.AddElements(objects.elements);
+
+    triggerSystem.Reserve((int)(objects.triggers.size() + objects.npcs.size()));
+    for (const LevelTrigger& trigger : objects.triggers) {
+        int id = triggerSystem.AddCells(trigger.zone, trigger.cells);
+        // A primeira bancada de puzzle é o objetivo da fase (bússola e fumaça)
+        if (puzzleTriggerId < 0 && trigger.zone.action == TriggerAction::OPEN_PUZZLE) puzzleTriggerId = id;
+    }
+
+    // NPCs: conversa ao interagir na célula do NPC ou nas 4 vizinhas
+    for (const NpcSpawn& npc : objects.npcs) {
+        TriggerZone talk;
+        talk.action = TriggerAction::START_DIALOGUE;
+        talk.fireOn = TriggerEvent::INTERACT;
+        talk.param = 0;
+        talk.speaker = npc.speaker;
+        talk.lines = npc.lines;
+        talk.once = false;
+        talk.enabled = true;
+        talk.showMarker = true;
+        talk.markerX = npc.x;
+        talk.markerY = npc.y;
+        triggerSystem.AddCells(talk, {{npc.x, npc.y}, {npc.x, npc.y - 1}, {npc.x, npc.y + 1}, {npc.x - 1, npc.y}, {npc.x + 1, npc.y}});
+    }
+
+    if (objects.hasSpawn) {
+        spawnX = objects.spawnX;
+        spawnY = objects.spawnY;
+        if (currentState != GameState::EXPLORATION) player.SetWorldPos(spawnX, spawnY);
     }
 }
 
@@ -821,6 +1325,8 @@ void Game::HandlePuzzleResult(PuzzleResult result) {
             hardwareInterface.PlayBuzzerPattern("success");
             vfx.TriggerFlash({0, 255, 100, 150}, 0.5f);
             puzzleSolved = true;
+            victoryAfterDialogue = true;
+            triggerSystem.SetEnabled(puzzleTriggerId, false);
 
             if (puzzleFails == 0) {
                 achievementSystem.Unlock("prodigy", "Prodigio", "Resolveu de primeira! Tesla ficaria orgulhoso.");
@@ -848,7 +1354,9 @@ void Game::HandlePuzzleResult(PuzzleResult result) {
             hardwareInterface.PlayBuzzerPattern("error");
             // VFX: fumaça + screen shake
             vfx.TriggerScreenShake(0.5f, 8.0f);
-            vfx.TriggerSmoke(puzzleTriggerX * 32 + 16, puzzleTriggerY * 32 + 16, 20);
+            if (const TriggerZone* bench = triggerSystem.GetTrigger(puzzleTriggerId)) {
+                vfx.TriggerSmoke(bench->markerX * 32 + 16, bench->markerY * 32 + 16, 20);
+            }
             vfx.TriggerFlash({255, 50, 0, 120}, 0.3f);
             
             achievementSystem.Unlock("burned_led", "LED Descartavel", "Fritou o LED por nao usar resistor. Genial!");
@@ -883,22 +1391,34 @@ void Game::HandlePuzzleResult(PuzzleResult result) {
 }
 
 void Game::Shutdown() {
+    // Primeiro: termina o quadro em voo e devolve o renderer antes de destruir texturas e fontes
+    renderThread.Shutdown();
+    perfMonitor.Shutdown();
+    jobSystem.Shutdown();
+    inputRecorder.Shutdown(); // Grava o resto do log / mostra o resultado do replay
+    framePacer.LogStats();
+    framePacer.ResetStats();
     player.Shutdown();
+    levelLoader.Shutdown();
     circuitSystem.Shutdown();
+    triggerSystem.Shutdown();
+    hazardField.Clear();
     circuitPuzzle.Shutdown();
     dialogueSystem.Shutdown();
-    audioSystem.Shutdown();
-    hardwareInterface.Shutdown();
+    achievementSystem.Shutdown();
 
-    if (objectsTexture) {
-        SDL_DestroyTexture(objectsTexture);
-        objectsTexture = nullptr;
-    }
-
-    if (tilesetTexture) {
-        SDL_DestroyTexture(tilesetTexture);
-        tilesetTexture = nullptr;
+    // Texturas, fontes e sons (antes de fechar o mixer; o renderer já voltou para esta thread)
+    if (!assetRefs.empty()) assetLoader.LogResidency();
+    for (int i = 0; i < (int)assetRefs.size(); ++i) {
+        if (assetRefs[i].id >= 0) assetLoader.Release(assetRefs[i], GAME_ASSETS[i].owner);
     }
+    assetRefs.clear();
+    assetLoader.Shutdown();
+    tilesetTexture = objectsTexture = menuBackgroundTexture = nullptr;
+    fontTitle = fontLarge = fontHeading = fontMenu = fontSmall = nullptr;
+    audioSystem.Shutdown();
+    assetPack.Close(); // Sons e fontes do pacote apontavam para o mapeamento
+    hardwareInterface.Shutdown();
 
     if (renderer) {
         SDL_DestroyRenderer(renderer);
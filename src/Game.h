@@ -9,6 +9,18 @@
 #include "Player.h"
 #include "CircuitSystem.h"
 #include "CircuitPuzzle.h"
+#include "HazardField.h"
+#include "TriggerSystem.h"
+#include "LevelLoader.h"
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "FramePacer.h"
+#include "RenderThread.h"
+#include "JobSystem.h"
+#include "PerfMonitor.h"
+#include "InputRecorder.h"
+#include "StressScene.h"
+#include "BotPlayer.h"
 #include "DialogueSystem.h"
 #include "TileMap.h"
 #include "Camera.h"
@@ -20,14 +32,34 @@
 const int SCALE = 3;
 const int SCREEN_WIDTH = 192 * SCALE;
 const int SCREEN_HEIGHT = 160 * SCALE;
-const int FPS = 60;
-const int FRAME_DELAY = 1000 / FPS;
+const int FPS = 60;                       // Ticks de simulação por segundo (independente do render)
+const double SIM_DT = 1.0 / FPS;
+const int MAX_SIM_STEPS = 5;              // Limite de ticks por quadro para não entrar em espiral
+const double MAX_FRAME_TIME = 0.25;
 
 class Game {
 public:
     Game();
     ~Game();
 
+    // Grava o pacote pré-decodificado dos assets do jogo (--build-pack); não precisa do Initialize
+    static bool BuildAssetPack(const std::string& file);
+
+    void SetPacingMode(PacingMode mode) { pacingMode = mode; } // Antes do Initialize
+    void SetRenderThreadMode(RenderThreadMode mode) { renderThreadMode = mode; } // Antes do Initialize
+    void SetJobThreads(int threads) { jobThreads = threads; } // Antes do Initialize; 0 = uma por núcleo
+    // Sem janela visível nem áudio (driver de vídeo dummy + renderer por software), para rodar em CI
+    void SetHeadless(bool enabled) { headless = enabled; }
+    void SetFrameLimit(int frames) { frameLimit = frames; } // 0 = até fechar
+    // Gravação/replay da entrada (InputRecorder); o replay usa a semente gravada no log
+    void SetRecordFile(const std::string& filename) { recordFile = filename; }
+    void SetReplayFile(const std::string& filename) { replayFile = filename; }
+    void SetRandomSeed(Uint32 seed) { randomSeed = seed; }
+    bool ReplayDiverged() const { return inputRecorder.HasDiverged(); }
+    // Cena sintética gigante no lugar da fase 1 (StressScene), com relatório de tempos no fim
+    void SetStressConfig(const StressConfig& config) { stressScene.Enable(config); }
+    // Jogador automático (BotPlayer) no lugar do teclado; a semente vem de SetRandomSeed
+    void SetBotConfig(const BotConfig& config) { botPlayer.Enable(config); }
     bool Initialize();
     void Run();
     void Shutdown();
@@ -35,8 +67,17 @@ public:
 private:
     // Dispatch por estado
     void HandleInput();
-    void Update();
-    void Render();
+    bool NextInputEvent(SDL_Event& event); // SDL ou log de replay; grava o que o jogo consome
+    Uint8 SampleMovementKeys();            // Setas pressionadas (bits INPUT_KEY_*)
+    Uint64 ComputeStateHash() const;
+    void UpdateBot();                      // Monta o BotView e deixa o bot decidir as teclas do quadro
+    void Update(float deltaTime);
+    void UpdateCamera(float alpha);
+    void Render();                       // Grava o quadro numa RenderList e entrega à RenderThread
+    void BindAssets();                   // Repassa aos subsistemas os assets que chegaram ou saíram do escopo
+    bool AssetsReadyFor(GameState state) const;
+    void UpdateAssetScope();             // Pede os assets do estado atual e dos prováveis seguintes, devolve o resto
+    void PresentFrame(RenderList& list); // HUD de desempenho + Submit (execução e present na thread de render)
 
     // HandleInput por estado
     void HandleInput_MainMenu();
@@ -48,22 +89,26 @@ private:
     // Update por estado
     void Update_MainMenu(float deltaTime);
     void Update_LevelSelection(float deltaTime);
-    void Update_Exploration();
+    void Update_Exploration(float deltaTime);
     void Update_Puzzle(float deltaTime);
     void Update_Dialogue(float deltaTime);
     void Update_Victory(float deltaTime);
+    void Update_Stress(); // Roteiro da cena de estresse, um tick por chamada
 
     // Render por estado
-    void Render_MainMenu();
-    void Render_LevelSelection();
-    void Render_Exploration();
-    void Render_Puzzle();
-    void Render_Dialogue();
-    void Render_Victory();
-    void Render_Vignette();
-    void Render_ObjectiveIndicator();
+    void Render_Loading(RenderList& list); // Progresso do AssetLoader, sem depender de nenhum asset
+    void Render_MainMenu(RenderList& list);
+    void Render_LevelSelection(RenderList& list);
+    void Render_Exploration(RenderList& list, int camX, int camY); // Mapa e objetos do mundo (fundo de todos os estados de jogo)
+    void Render_Puzzle(RenderList& list);
+    void Render_Dialogue(RenderList& list);
+    void Render_Victory(RenderList& list);
+    void Render_Vignette(RenderList& list);
+    void Render_ObjectiveIndicator(RenderList& list);
+    void Render_HealthHUD(RenderList& list);
 
     // Transições de estado
+    void ChangeState(GameState state);   // Troca o estado e o escopo de assets junto
     void EnterMainMenu();
     void EnterLevelSelection();
     void EnterPuzzle(int puzzleId);
@@ -74,6 +119,10 @@ private:
 
     // Processa resultado do puzzle
     void HandlePuzzleResult(PuzzleResult result);
+    void HandleHazardDamage();
+    void HandleTriggerEvents();
+    void ExecuteTrigger(const TriggerZone& zone);
+    void ApplyLevelObjects(LevelObjects& objects);
 
     SDL_Window* window;
     SDL_Renderer* renderer;
@@ -82,14 +131,32 @@ private:
     // Estado atual
     GameState currentState;
 
+    // Texturas, fontes e sons vêm do AssetLoader (dono deles), por estado; os ponteiros ficam nulos fora do escopo
+    AssetLoader assetLoader;
+    std::vector<AssetRef> assetRefs;   // Um por linha de GAME_ASSETS (Game.cpp); inválido fora do escopo
+    std::vector<const void*> boundAssets; // O que cada linha entregou aos subsistemas no último BindAssets
+    AssetPack assetPack;   // Opcional: sem ele o loader decodifica os arquivos soltos
+    bool assetScopeReady;  // Os assets do estado atual já chegaram
+    Uint64 scopeCounter;   // Última troca de escopo (ou o Initialize): tempo de espera na tela de carregamento
+
     // Texturas
     SDL_Texture* tilesetTexture;
     SDL_Texture* objectsTexture;
     SDL_Texture* menuBackgroundTexture;
 
+    // Fontes das telas do jogo, abertas uma vez e compartilhadas com diálogo, conquistas, puzzle e HUD
+    TTF_Font* fontTitle;   // 24
+    TTF_Font* fontLarge;   // 20
+    TTF_Font* fontHeading; // 14
+    TTF_Font* fontMenu;    // 10
+    TTF_Font* fontSmall;   // 8
+
     // Subsistemas
     Player player;
     CircuitSystem circuitSystem;
+    HazardField hazardField;
+    TriggerSystem triggerSystem;
+    LevelLoader levelLoader;
     CircuitPuzzle circuitPuzzle;
     DialogueSystem dialogueSystem;
     VFX vfx;
@@ -100,12 +167,34 @@ private:
     Camera* camera;
 
     // Timing
-    Uint32 lastFrameTime;
-
-    // Puzzle trigger zone (posição no mapa que abre o puzzle)
-    int puzzleTriggerX;
-    int puzzleTriggerY;
+    float renderAlpha;  // Fração entre o último tick e o próximo, para interpolar o desenho
+    PacingMode pacingMode;
+    bool headless;
+    int frameLimit;
+    int frameCount;
+    FramePacer framePacer;
+    RenderThreadMode renderThreadMode;
+    RenderThread renderThread;
+    int jobThreads;
+    JobSystem jobSystem;   // Workers para partículas, netlist, piso eletrificado, validação e bots
+    PerfMonitor perfMonitor;
+
+    // Replay determinístico
+    InputRecorder inputRecorder;
+    std::string recordFile;
+    std::string replayFile;
+    Uint32 randomSeed;
+    StressScene stressScene;
+    BotPlayer botPlayer;
+
+    // Ponto de renascimento depois de perder toda a vida
+    int spawnX;
+    int spawnY;
+
+    // Zona de gatilho da bancada que abre o puzzle
+    int puzzleTriggerId;
     bool puzzleSolved;
+    bool victoryAfterDialogue;
     PuzzleResult lastPuzzleResult;
     int pendingPuzzleId;
     bool firstTimePuzzle;
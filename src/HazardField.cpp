@@ -0,0 +1,211 @@
+#include "HazardField.h"
+#include "TileMap.h"
+#include <algorithm>
+#include "StateHash.h"
+
+static const int HAZARD_CHUNK = 32;        // Chunks de 32x32 tiles
+static const int HAZARD_STEP_FRAMES = 4;   // 15 passos por segundo a 60 FPS
+static const Uint8 CHARGE_PEAK = 12;       // Frente da onda; depois decai 1 por passo (período refratário)
+static const Uint8 DANGER_CHARGE = CHARGE_PEAK - 1;
+static const int EMITTER_PERIOD = 30;      // Passos entre pulsos de cada emissor
+static const int HAZARD_CHUNK_GRAIN = 16;  // Chunks ativos por job (16 chunks = 16K células)
+
+HazardField::HazardField()
+    : width(0), height(0), stride(0), chunksX(0), chunksY(0), jobs(nullptr), frameCounter(0), stepCounter(0) {}
+
+void HazardField::Build(const TileMap& map) {
+    width = map.GetWidth();
+    height = map.GetHeight();
+    chunksX = (width + HAZARD_CHUNK - 1) / HAZARD_CHUNK;
+    chunksY = (height + HAZARD_CHUNK - 1) / HAZARD_CHUNK;
+    // Grade arredondada para chunks inteiros: todo chunk processa 32 colunas fixas (laço vetorizável)
+    stride = chunksX * HAZARD_CHUNK + 2;
+
+    mask.assign(stride * (chunksY * HAZARD_CHUNK + 2), 0);
+    current.assign(mask.size(), 0);
+    next.assign(mask.size(), 0);
+    emitters.clear();
+    activeChunks.clear();
+    nextActive.clear();
+    chunksToClear.clear();
+    chunkQueued.assign(chunksX * chunksY, 0);
+    chunkHasHazard.assign(chunksX * chunksY, 0);
+    frameCounter = 0;
+    stepCounter = 0;
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Tile& tile = map.GetTile(x, y);
+            if (!tile.IsHazard()) continue;
+            int cell = (y + 1) * stride + (x + 1);
+            mask[cell] = 0xFF;
+            chunkHasHazard[ChunkOfCell(cell)] = 1;
+            // Fase derivada da posição para os emissores não pulsarem todos juntos
+            if (tile.IsHazardEmitter()) emitters.push_back({cell, (x * 7 + y * 13) % EMITTER_PERIOD});
+        }
+    }
+}
+
+void HazardField::Clear() {
+    width = height = stride = chunksX = chunksY = 0;
+    mask.clear();
+    current.clear();
+    next.clear();
+    emitters.clear();
+    activeChunks.clear();
+    nextActive.clear();
+    chunkQueued.clear();
+    chunkHasHazard.clear();
+    chunksToClear.clear();
+}
+
+int HazardField::ChunkOfCell(int cell) const {
+    int x = cell % stride - 1;
+    int y = cell / stride - 1;
+    return (y / HAZARD_CHUNK) * chunksX + (x / HAZARD_CHUNK);
+}
+
+void HazardField::ActivateChunk(int chunk) {
+    // Bit 1: na lista do passo atual; bit 2: na lista do próximo passo
+    int cx = chunk % chunksX;
+    int cy = chunk / chunksX;
+    const int around[5][2] = {{0, 0}, {0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    for (const auto& o : around) {
+        int nx = cx + o[0], ny = cy + o[1];
+        if (nx < 0 || nx >= chunksX || ny < 0 || ny >= chunksY) continue;
+        int n = ny * chunksX + nx;
+        if ((chunkQueued[n] & 2) || !chunkHasHazard[n]) continue;
+        chunkQueued[n] |= 2;
+        nextActive.push_back(n);
+    }
+}
+
+void HazardField::Update() {
+    if (width == 0) return;
+    if (++frameCounter < HAZARD_STEP_FRAMES) return;
+    frameCounter = 0;
+    Step();
+}
+
+void HazardField::Step() {
+    ++stepCounter;
+
+    // Emissores disparam direto no buffer atual e acordam seu chunk e vizinhos
+    for (const Emitter& e : emitters) {
+        if ((stepCounter + e.phase) % EMITTER_PERIOD != 0) continue;
+        current[e.cell] = CHARGE_PEAK;
+        ActivateChunk(ChunkOfCell(e.cell));
+    }
+
+    // A lista "próxima" acumulada (passo anterior + emissores) vira a lista deste passo
+    for (int chunk : activeChunks) chunkQueued[chunk] &= ~1;
+    activeChunks.swap(nextActive);
+    nextActive.clear();
+    for (int chunk : activeChunks) chunkQueued[chunk] = 1;
+
+    int count = (int)activeChunks.size();
+    chunkCharged.assign(count, 0);
+    auto stepRange = [this](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            bool anyCharge = false;
+            StepChunk(activeChunks[i], anyCharge);
+            chunkCharged[i] = anyCharge ? 1 : 0;
+        }
+    };
+    if (jobs) jobs->ParallelFor(count, HAZARD_CHUNK_GRAIN, stepRange);
+    else stepRange(0, count);
+
+    // Acordar vizinhos e agendar limpezas na ordem da lista mantém o passo determinístico
+    for (int i = 0; i < count; ++i) {
+        if (chunkCharged[i]) {
+            ActivateChunk(activeChunks[i]);
+        } else {
+            chunksToClear.push_back(activeChunks[i]);
+        }
+    }
+
+    // Chunk que apagou fica zerado nos dois buffers, então pode ser pulado sem ler lixo depois
+    for (int chunk : chunksToClear) {
+        int x0 = (chunk % chunksX) * HAZARD_CHUNK;
+        int y0 = (chunk / chunksX) * HAZARD_CHUNK;
+        for (int y = y0; y < y0 + HAZARD_CHUNK; ++y) {
+            std::fill_n(&current[(y + 1) * stride + x0 + 1], HAZARD_CHUNK, (Uint8)0);
+        }
+    }
+    chunksToClear.clear();
+    current.swap(next);
+}
+
+void HazardField::StepChunk(int chunk, bool& anyCharge) {
+    int x0 = (chunk % chunksX) * HAZARD_CHUNK;
+    int y0 = (chunk / chunksX) * HAZARD_CHUNK;
+
+    Uint8 any = 0;
+    for (int y = y0; y < y0 + HAZARD_CHUNK; ++y) {
+        int base = (y + 1) * stride + x0 + 1;
+        const Uint8* c = &current[base];
+        const Uint8* up = c - stride;
+        const Uint8* down = c + stride;
+        const Uint8* m = &mask[base];
+
+        // Regra sem desvios, byte a byte, num buffer local (sem aliasing): o compilador vetoriza a linha
+        Uint8 row[HAZARD_CHUNK];
+        for (int k = 0; k < HAZARD_CHUNK; ++k) {
+            Uint8 s = c[k];
+            Uint8 rest = (s == 0);
+            Uint8 excite = (up[k] == CHARGE_PEAK) | (down[k] == CHARGE_PEAK) |
+                           (c[k - 1] == CHARGE_PEAK) | (c[k + 1] == CHARGE_PEAK);
+            Uint8 v = (Uint8)((Uint8)(s - 1 + rest) | (Uint8)((excite & rest) * CHARGE_PEAK));
+            v &= m[k];
+            row[k] = v;
+            any |= v;
+        }
+        std::copy(row, row + HAZARD_CHUNK, &next[base]);
+    }
+    anyCharge = any != 0;
+}
+
+int HazardField::GetCharge(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+    return current[(y + 1) * stride + x + 1];
+}
+
+Uint64 HazardField::HashState(Uint64 hash) const {
+    hash = HashValue(hash, frameCounter);
+    hash = HashValue(hash, stepCounter);
+    if (current.empty()) return hash;
+    return HashBytes(hash, current.data(), current.size());
+}
+
+bool HazardField::IsDangerous(int x, int y) const {
+    return GetCharge(x, y) >= DANGER_CHARGE;
+}
+
+void HazardField::Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const {
+    if (width == 0 || activeChunks.empty()) return;
+    int tileSize = 32 * scale;
+    int x0 = std::max(0, camX / tileSize);
+    int y0 = std::max(0, camY / tileSize);
+    int x1 = std::min(width - 1, (camX + viewW) / tileSize);
+    int y1 = std::min(height - 1, (camY + viewH) / tileSize);
+
+    // Agrupa por faixa de carga para desenhar cada intensidade num único FillRects
+    for (auto& rects : glowRects) rects.clear();
+    for (int y = y0; y <= y1; ++y) {
+        const Uint8* row = &current[(y + 1) * stride + 1];
+        for (int x = x0; x <= x1; ++x) {
+            if (!row[x]) continue;
+            int band = std::min(3, row[x] * 4 / (CHARGE_PEAK + 1));
+            glowRects[band].push_back({x * tileSize - camX, y * tileSize - camY, tileSize, tileSize});
+        }
+    }
+
+    list.SetDrawBlendMode(SDL_BLENDMODE_ADD);
+    for (int band = 0; band < 4; ++band) {
+        if (glowRects[band].empty()) continue;
+        Uint8 level = (Uint8)(40 + band * 50);
+        list.SetDrawColor(level / 2, level, 255, level);
+        list.FillRects(glowRects[band].data(), (int)glowRects[band].size());
+    }
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+}
@@ -0,0 +1,65 @@
+#ifndef HAZARD_FIELD_H
+#define HAZARD_FIELD_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include "JobSystem.h"
+#include "RenderList.h"
+
+class TileMap;
+
+// Piso eletrificado (armadilhas elétricas) como autômato celular excitável:
+// emissores disparam pulsos, a carga se espalha pelos tiles de risco e decai.
+// Grades de 1 byte por célula com borda, em buffer duplo; só os chunks com carga são simulados.
+// Cada chunk lê o buffer atual e escreve só a sua área do próximo: com muitos chunks ativos o
+// passo é dividido entre os workers, e a lista de ativos é montada depois, na ordem de sempre.
+class HazardField {
+public:
+    HazardField();
+
+    void SetJobSystem(JobSystem* jobSystem) { jobs = jobSystem; }
+
+    void Build(const TileMap& map);
+    void Clear();
+
+    // Avança a simulação um frame (o autômato dá um passo a cada HAZARD_STEP_FRAMES)
+    void Update();
+    void Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const;
+
+    int GetCharge(int x, int y) const;
+    bool IsDangerous(int x, int y) const; // Frente da onda: causa dano ao jogador
+    int GetActiveChunkCount() const { return (int)activeChunks.size(); }
+    Uint64 HashState(Uint64 hash) const;
+
+private:
+    struct Emitter { int cell; int phase; };
+
+    void Step();
+    void StepChunk(int chunk, bool& anyCharge);
+    void ActivateChunk(int chunk);
+    int ChunkOfCell(int cell) const;
+
+    int width;
+    int height;
+    int stride;                      // Largura em chunks inteiros + 2 (borda de zeros evita testes de limite)
+    int chunksX;
+    int chunksY;
+    std::vector<Uint8> mask;         // 0xFF nos tiles de risco
+    std::vector<Uint8> current;
+    std::vector<Uint8> next;
+    std::vector<Emitter> emitters;
+
+    std::vector<int> activeChunks;
+    std::vector<int> nextActive;
+    std::vector<Uint8> chunkQueued;
+    std::vector<Uint8> chunkHasHazard; // Chunks sem tiles de risco nunca são acordados
+    std::vector<int> chunksToClear;  // Chunks que apagaram: zerados também no outro buffer
+    std::vector<Uint8> chunkCharged; // Resultado de cada chunk ativo no passo (índice em activeChunks)
+    JobSystem* jobs;
+    int frameCounter;
+    int stepCounter;
+
+    mutable std::vector<SDL_Rect> glowRects[4];
+};
+
+#endif // HAZARD_FIELD_H
@@ -0,0 +1,258 @@
+#include "InputRecorder.h"
+#include <cstring>
+#include <iostream>
+
+static const char REPLAY_MAGIC[4] = {'C', 'E', 'R', 'P'};
+static const Uint8 REPLAY_VERSION = 1;
+static const Uint8 EVENT_QUIT = 0;
+static const Uint8 EVENT_KEYDOWN = 1;
+
+static void PutBytes(std::vector<Uint8>& buf, Uint64 value, int count) {
+    for (int i = 0; i < count; ++i) buf.push_back((Uint8)(value >> (8 * i))); // Little-endian
+}
+
+static void PutVarint(std::vector<Uint8>& buf, Uint32 value) {
+    while (value >= 0x80) {
+        buf.push_back((Uint8)(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back((Uint8)value);
+}
+
+// Leitura com limite: pos avança só quando há bytes suficientes
+static bool GetBytes(const std::vector<Uint8>& buf, size_t& pos, int count, Uint64& value) {
+    if (pos + count > buf.size()) return false;
+    value = 0;
+    for (int i = 0; i < count; ++i) value |= (Uint64)buf[pos + i] << (8 * i);
+    pos += count;
+    return true;
+}
+
+static bool GetVarint(const std::vector<Uint8>& buf, size_t& pos, Uint32& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= buf.size()) return false;
+        Uint8 byte = buf[pos++];
+        value |= (Uint32)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+InputRecorder::InputRecorder()
+    : mode(ReplayMode::OFF), seed(0), frameIndex(0), diverged(false), readPos(0), eventPos(0), keyPos(0) {
+    current.steps = 0;
+    current.hash = 0;
+}
+
+InputRecorder::~InputRecorder() {
+    Shutdown();
+}
+
+bool InputRecorder::StartRecording(const std::string& file, Uint32 randomSeed) {
+    Shutdown();
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Warning: Could not open replay file " << file << " for writing\n";
+        return false;
+    }
+    filename = file;
+    seed = randomSeed;
+    frameIndex = 0;
+    writeBuffer.clear();
+    for (char c : REPLAY_MAGIC) writeBuffer.push_back((Uint8)c);
+    writeBuffer.push_back(REPLAY_VERSION);
+    PutBytes(writeBuffer, seed, 4);
+    current = FrameRecord();
+    current.steps = 0;
+    current.hash = 0;
+    mode = ReplayMode::RECORD;
+    std::cout << "[REPLAY] Recording input to " << filename << " (seed " << seed << ")\n";
+    return true;
+}
+
+bool InputRecorder::StartPlayback(const std::string& file) {
+    Shutdown();
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Warning: Could not open replay file " << file << "\n";
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    readPos = 0;
+    Uint64 version = 0, storedSeed = 0;
+    if (data.size() < 4 || std::memcmp(data.data(), REPLAY_MAGIC, 4) != 0) {
+        std::cerr << "Warning: " << file << " is not a replay file\n";
+        data.clear();
+        return false;
+    }
+    readPos = 4;
+    if (!GetBytes(data, readPos, 1, version) || version != REPLAY_VERSION || !GetBytes(data, readPos, 4, storedSeed)) {
+        std::cerr << "Warning: Unsupported replay version in " << file << "\n";
+        data.clear();
+        return false;
+    }
+    filename = file;
+    seed = (Uint32)storedSeed;
+    frameIndex = 0;
+    diverged = false;
+    mode = ReplayMode::PLAY;
+    std::cout << "[REPLAY] Playing " << filename << " (" << data.size() << " bytes, seed " << seed << ")\n";
+    return true;
+}
+
+void InputRecorder::Shutdown() {
+    if (mode == ReplayMode::RECORD) {
+        out.write((const char*)writeBuffer.data(), writeBuffer.size());
+        out.close();
+        writeBuffer.clear();
+        std::cout << "[REPLAY] Recorded " << frameIndex << " frames to " << filename << "\n";
+    } else if (mode == ReplayMode::PLAY) {
+        std::cout << "[REPLAY] Played " << frameIndex << " frames: " << (diverged ? "DIVERGED" : "OK") << "\n";
+        data.clear();
+    }
+    mode = ReplayMode::OFF;
+}
+
+bool InputRecorder::BeginFrame() {
+    if (mode != ReplayMode::PLAY) return true;
+    eventPos = 0;
+    keyPos = 0;
+    if (readPos >= data.size()) return false;
+    if (!ReadFrame(current)) {
+        std::cerr << "Warning: Truncated replay " << filename << " at frame " << frameIndex << "\n";
+        readPos = data.size();
+        return false;
+    }
+    return true;
+}
+
+bool InputRecorder::EndFrame(Uint64 stateHash) {
+    if (mode == ReplayMode::RECORD) {
+        current.hash = stateHash;
+        WriteFrame(current);
+        current.events.clear();
+        current.keys.clear();
+        current.steps = 0;
+        // Descarrega em blocos para não segurar gravações longas inteiras na memória
+        if (writeBuffer.size() >= 64 * 1024) {
+            out.write((const char*)writeBuffer.data(), writeBuffer.size());
+            writeBuffer.clear();
+        }
+    } else if (mode == ReplayMode::PLAY && !diverged) {
+        if (stateHash != current.hash) {
+            diverged = true;
+            std::cerr << "Warning: Replay diverged at frame " << frameIndex << " (expected " << std::hex
+                      << current.hash << ", got " << stateHash << std::dec << ")\n";
+        } else if (keyPos != current.keys.size() || eventPos != current.events.size()) {
+            // Mesmo hash, mas a entrada gravada não foi toda consumida: o fluxo do jogo mudou
+            diverged = true;
+            std::cerr << "Warning: Replay diverged at frame " << frameIndex << " (input not consumed)\n";
+        }
+    }
+    ++frameIndex;
+    return !diverged;
+}
+
+void InputRecorder::RecordEvent(const SDL_Event& event) {
+    if (mode != ReplayMode::RECORD) return;
+    RecordedEvent e = {};
+    if (event.type == SDL_QUIT) {
+        e.type = EVENT_QUIT;
+    } else if (event.type == SDL_KEYDOWN) {
+        e.type = EVENT_KEYDOWN;
+        e.sym = event.key.keysym.sym;
+        e.scancode = (Uint16)event.key.keysym.scancode;
+        e.mod = event.key.keysym.mod;
+        e.repeat = event.key.repeat;
+    } else {
+        return; // O jogo só reage a QUIT e KEYDOWN
+    }
+    current.events.push_back(e);
+}
+
+void InputRecorder::RecordSteps(int steps) {
+    if (mode == ReplayMode::RECORD) current.steps = steps;
+}
+
+void InputRecorder::RecordKeys(Uint8 keys) {
+    if (mode == ReplayMode::RECORD) current.keys.push_back(keys);
+}
+
+bool InputRecorder::NextEvent(SDL_Event& event) {
+    if (mode != ReplayMode::PLAY || eventPos >= current.events.size()) return false;
+    const RecordedEvent& e = current.events[eventPos++];
+    std::memset(&event, 0, sizeof(event));
+    if (e.type == EVENT_QUIT) {
+        event.type = SDL_QUIT;
+        return true;
+    }
+    event.type = SDL_KEYDOWN;
+    event.key.type = SDL_KEYDOWN;
+    event.key.state = SDL_PRESSED;
+    event.key.repeat = e.repeat;
+    event.key.keysym.sym = e.sym;
+    event.key.keysym.scancode = (SDL_Scancode)e.scancode;
+    event.key.keysym.mod = e.mod;
+    return true;
+}
+
+int InputRecorder::GetFrameSteps() const {
+    return mode == ReplayMode::PLAY ? current.steps : 0;
+}
+
+Uint8 InputRecorder::NextKeys() {
+    if (mode != ReplayMode::PLAY || keyPos >= current.keys.size()) return 0;
+    return current.keys[keyPos++];
+}
+
+void InputRecorder::WriteFrame(const FrameRecord& frame) {
+    PutVarint(writeBuffer, (Uint32)frame.events.size());
+    for (const RecordedEvent& e : frame.events) {
+        writeBuffer.push_back(e.type);
+        if (e.type == EVENT_QUIT) continue;
+        PutBytes(writeBuffer, (Uint32)e.sym, 4);
+        PutBytes(writeBuffer, e.scancode, 2);
+        PutBytes(writeBuffer, e.mod, 2);
+        writeBuffer.push_back(e.repeat);
+    }
+    writeBuffer.push_back((Uint8)frame.steps);
+    PutVarint(writeBuffer, (Uint32)frame.keys.size());
+    writeBuffer.insert(writeBuffer.end(), frame.keys.begin(), frame.keys.end());
+    PutBytes(writeBuffer, frame.hash, 8);
+}
+
+bool InputRecorder::ReadFrame(FrameRecord& frame) {
+    frame.events.clear();
+    frame.keys.clear();
+    Uint32 count;
+    Uint64 value;
+    if (!GetVarint(data, readPos, count)) return false;
+    for (Uint32 i = 0; i < count; ++i) {
+        RecordedEvent e = {};
+        if (!GetBytes(data, readPos, 1, value)) return false;
+        e.type = (Uint8)value;
+        if (e.type == EVENT_KEYDOWN) {
+            if (!GetBytes(data, readPos, 4, value)) return false;
+            e.sym = (Sint32)(Uint32)value;
+            if (!GetBytes(data, readPos, 2, value)) return false;
+            e.scancode = (Uint16)value;
+            if (!GetBytes(data, readPos, 2, value)) return false;
+            e.mod = (Uint16)value;
+            if (!GetBytes(data, readPos, 1, value)) return false;
+            e.repeat = (Uint8)value;
+        } else if (e.type != EVENT_QUIT) {
+            return false;
+        }
+        frame.events.push_back(e);
+    }
+    if (!GetBytes(data, readPos, 1, value)) return false;
+    frame.steps = (int)value;
+    if (!GetVarint(data, readPos, count) || readPos + count > data.size()) return false;
+    frame.keys.assign(data.begin() + readPos, data.begin() + readPos + count);
+    readPos += count;
+    if (!GetBytes(data, readPos, 8, value)) return false;
+    frame.hash = value;
+    return true;
+}
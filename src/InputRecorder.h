@@ -0,0 +1,91 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <SDL2/SDL.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Bits das setas amostradas pelo HandleInput_Exploration
+const Uint8 INPUT_KEY_UP = 1 << 0;
+const Uint8 INPUT_KEY_DOWN = 1 << 1;
+const Uint8 INPUT_KEY_LEFT = 1 << 2;
+const Uint8 INPUT_KEY_RIGHT = 1 << 3;
+
+enum class ReplayMode { OFF, RECORD, PLAY };
+
+// Grava a entrada consumida pelo jogo em um log binário e a reproduz quadro a quadro.
+// Por quadro: eventos (QUIT / KEYDOWN), ticks de simulação rodados, amostras das setas
+// e o hash do estado no fim do quadro. No replay, um hash diferente é divergência.
+//
+// Formato: "CERP", versão (u8), semente (u32), e os quadros em sequência:
+//   varint eventos, { u8 tipo, i32 sym, u16 scancode, u16 mod, u8 repeat }...,
+//   u8 ticks, varint amostras, u8 setas..., u64 hash
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool StartRecording(const std::string& filename, Uint32 seed);
+    bool StartPlayback(const std::string& filename); // Lê o log inteiro para a memória
+    void Shutdown();
+
+    ReplayMode GetMode() const { return mode; }
+    bool IsActive() const { return mode != ReplayMode::OFF; }
+    bool IsPlaying() const { return mode == ReplayMode::PLAY; }
+    Uint32 GetSeed() const { return seed; }
+    bool HasDiverged() const { return diverged; }
+
+    // Replay: false quando o log acabou
+    bool BeginFrame();
+    // Grava o quadro (RECORD) ou compara o hash com o gravado (PLAY); false na divergência
+    bool EndFrame(Uint64 stateHash);
+
+    // Gravação (ignoradas fora do modo RECORD)
+    void RecordEvent(const SDL_Event& event);
+    void RecordSteps(int steps);
+    void RecordKeys(Uint8 keys);
+
+    // Replay: entrada do quadro atual na ordem gravada
+    bool NextEvent(SDL_Event& event);
+    int GetFrameSteps() const;
+    Uint8 NextKeys();
+
+private:
+    struct RecordedEvent {
+        Uint8 type; // 0 = QUIT, 1 = KEYDOWN
+        Sint32 sym;
+        Uint16 scancode;
+        Uint16 mod;
+        Uint8 repeat;
+    };
+
+    struct FrameRecord {
+        std::vector<RecordedEvent> events;
+        std::vector<Uint8> keys;
+        int steps;
+        Uint64 hash;
+    };
+
+    bool ReadFrame(FrameRecord& frame);
+    void WriteFrame(const FrameRecord& frame);
+
+    ReplayMode mode;
+    std::string filename;
+    Uint32 seed;
+    int frameIndex;
+    bool diverged;
+
+    // Gravação: o quadro atual é montado em memória e escrito no EndFrame
+    std::ofstream out;
+    std::vector<Uint8> writeBuffer;
+    FrameRecord current;
+
+    // Replay
+    std::vector<Uint8> data;
+    size_t readPos;
+    size_t eventPos;
+    size_t keyPos;
+};
+
+#endif // INPUT_RECORDER_H
@@ -0,0 +1,175 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iostream>
+#include "Trace.h"
+
+static const int JOB_MAX_THREADS = 16;
+static const int JOB_SPIN_COUNT = 64; // Tentativas (com yield) antes de dormir: jobs do quadro chegam em rajadas
+
+// Nomes literais para o trace (só o ponteiro é guardado)
+static const char* WORKER_NAMES[JOB_MAX_THREADS] = {
+    "Main", "Job 1", "Job 2", "Job 3", "Job 4", "Job 5", "Job 6", "Job 7",
+    "Job 8", "Job 9", "Job 10", "Job 11", "Job 12", "Job 13", "Job 14", "Job 15"
+};
+
+// Deque da thread atual; threads de fora do pool usam o 0, como a principal
+static thread_local const JobSystem* localSystem = nullptr;
+static thread_local int localQueue = 0;
+
+JobSystem::JobSystem() : queuedJobs(0), quit(false), jobCount(0), stealCount(0), busyTicks(0) {}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+bool JobSystem::Initialize(int threads) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > JOB_MAX_THREADS) threads = JOB_MAX_THREADS;
+    if (threads == 1) {
+        std::cout << "[JOBS] Job system off (1 thread)\n";
+        return true;
+    }
+
+    quit = false;
+    for (int i = 0; i < threads; ++i) queues.emplace_back(new WorkerQueue());
+    for (int i = 1; i < threads; ++i) workers.emplace_back(&JobSystem::WorkerMain, this, i);
+    std::cout << "[JOBS] " << threads << " threads (" << threads - 1 << " workers + main)\n";
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+    queues.clear();
+}
+
+int JobSystem::CurrentQueue() const {
+    return localSystem == this ? localQueue : 0;
+}
+
+void JobSystem::Push(Job& job) {
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    WorkerQueue& queue = *queues[CurrentQueue()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+    queuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+void JobSystem::Run(JobCounter& counter, std::function<void()> fn) {
+    if (workers.empty()) {
+        fn();
+        return;
+    }
+    Job job = {std::move(fn), nullptr, 0, 0, &counter};
+    Push(job);
+    { std::lock_guard<std::mutex> lock(sleepMutex); } // Worker entre o teste e o wait não perde o aviso
+    wake.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    int self = CurrentQueue();
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(self)) std::this_thread::yield(); // O que falta está rodando em outra thread
+    }
+}
+
+void JobSystem::ParallelFor(int count, int grain, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    int blocks = (count + grain - 1) / grain;
+    if (workers.empty() || blocks == 1) {
+        for (int begin = 0; begin < count; begin += grain) fn(begin, std::min(begin + grain, count));
+        return;
+    }
+
+    // Blocos 1..n-1 no deque desta thread (os workers roubam do começo), o bloco 0 roda aqui
+    JobCounter counter;
+    for (int b = 1; b < blocks; ++b) {
+        Job job = {nullptr, &fn, b * grain, std::min((b + 1) * grain, count), &counter};
+        Push(job);
+    }
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_all();
+
+    fn(0, std::min(grain, count));
+    jobCount.fetch_add(1, std::memory_order_relaxed);
+    Wait(counter);
+}
+
+bool JobSystem::Pop(int self, Job& job) {
+    WorkerQueue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(int self, Job& job) {
+    int count = (int)queues.size();
+    for (int k = 1; k < count; ++k) {
+        WorkerQueue& queue = *queues[(self + k) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryRunOne(int self) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0) return false;
+    Job job;
+    if (!Pop(self, job) && !Steal(self, job)) return false;
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(Job& job) {
+    if (job.rangeFn) (*job.rangeFn)(job.begin, job.end);
+    else job.fn();
+    jobCount.fetch_add(1, std::memory_order_relaxed);
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerMain(int index) {
+    localSystem = this;
+    localQueue = index;
+    TRACE_THREAD_NAME(WORKER_NAMES[index]);
+
+    int spins = 0;
+    while (true) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (TryRunOne(index)) {
+            busyTicks.fetch_add(SDL_GetPerformanceCounter() - start, std::memory_order_relaxed);
+            spins = 0;
+            continue;
+        }
+        if (++spins < JOB_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+        spins = 0;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return quit || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (quit && queuedJobs.load(std::memory_order_acquire) == 0) break;
+    }
+}
+
+JobStats JobSystem::TakeStats() {
+    JobStats stats;
+    stats.jobs = jobCount.exchange(0, std::memory_order_relaxed);
+    stats.steals = stealCount.exchange(0, std::memory_order_relaxed);
+    stats.busyTicks = busyTicks.exchange(0, std::memory_order_relaxed);
+    return stats;
+}
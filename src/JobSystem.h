@@ -0,0 +1,83 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Grupo de jobs de um fork-join: Run incrementa, o fim de cada job decrementa, Wait espera o zero
+struct JobCounter {
+    std::atomic<int> pending{0};
+};
+
+// Trabalho dos workers desde a última leitura (somado à HUD pela thread principal)
+struct JobStats {
+    int jobs;          // Jobs executados (blocos de ParallelFor contam um cada)
+    int steals;        // Jobs tirados do deque de outra thread
+    Uint64 busyTicks;  // Contador de performance dos workers executando jobs (soma de todos);
+                       // o resto do quadro é ociosidade (procurando trabalho ou dormindo)
+};
+
+// Pool de workers com um deque por thread e roubo de trabalho: cada thread empilha e desempilha
+// no fim do próprio deque (LIFO, dados ainda no cache) e, sem nada, rouba do começo do deque de
+// outra (FIFO, os blocos maiores/mais antigos). A thread que espera um grupo executa jobs em vez
+// de dormir. Sem Initialize (ou com 1 thread) tudo roda na hora, na thread que chamou.
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+
+    // threads = 0: uma por núcleo (hardware_concurrency), contando a thread principal
+    bool Initialize(int threads);
+    void Shutdown();
+
+    void Run(JobCounter& counter, std::function<void()> fn); // Fork
+    void Wait(JobCounter& counter);                          // Join (ajuda enquanto espera)
+
+    // fn(begin, end) sobre [0, count) em blocos fixos de 'grain' itens: o bloco k é sempre
+    // [k * grain, (k + 1) * grain), então resultados parciais por bloco são determinísticos
+    void ParallelFor(int count, int grain, const std::function<void(int, int)>& fn);
+
+    int GetThreadCount() const { return queues.empty() ? 1 : (int)queues.size(); }
+    JobStats TakeStats();
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        const std::function<void(int, int)>* rangeFn; // Bloco de ParallelFor (sem alocar um std::function)
+        int begin;
+        int end;
+        JobCounter* counter;
+    };
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void WorkerMain(int index);
+    void Push(Job& job);
+    bool TryRunOne(int self);
+    bool Pop(int self, Job& job);
+    bool Steal(int self, Job& job);
+    void Execute(Job& job);
+    int CurrentQueue() const;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // 0 = thread principal (e outras de fora do pool)
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs;
+    bool quit;
+
+    std::atomic<int> jobCount;
+    std::atomic<int> stealCount;
+    std::atomic<Uint64> busyTicks;
+};
+
+#endif // JOB_SYSTEM_H
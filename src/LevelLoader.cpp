@@ -0,0 +1,187 @@
+#include "LevelLoader.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "Trace.h"
+
+LevelLoader::LevelLoader() : ready(false) {}
+
+LevelLoader::~LevelLoader() {
+    Shutdown();
+}
+
+void LevelLoader::Start(const std::string& filename) {
+    Shutdown();
+    result = LevelObjects();
+    ready.store(false);
+    worker = std::thread([this, filename]() {
+        TRACE_THREAD_NAME("LevelLoader");
+        ParseFile(filename, result);
+        ready.store(true, std::memory_order_release);
+    });
+}
+
+bool LevelLoader::Poll(LevelObjects& out) {
+    if (!worker.joinable() || !ready.load(std::memory_order_acquire)) return false;
+    worker.join(); // A thread já terminou: o join é imediato
+    out = std::move(result);
+    result = LevelObjects();
+    return true;
+}
+
+bool LevelLoader::Wait(LevelObjects& out) {
+    if (!worker.joinable()) return false;
+    worker.join();
+    out = std::move(result);
+    result = LevelObjects();
+    return true;
+}
+
+void LevelLoader::Shutdown() {
+    if (worker.joinable()) worker.join();
+}
+
+static bool ParseCircuitType(const std::string& word, CircuitType& type) {
+    static const struct { const char* name; CircuitType type; } names[] = {
+        {"switch", CircuitType::SWITCH},    {"door", CircuitType::DOOR},
+        {"plate", CircuitType::PRESSURE_PLATE},
+        {"and", CircuitType::AND_GATE},     {"or", CircuitType::OR_GATE},
+        {"not", CircuitType::NOT_GATE},     {"delay", CircuitType::DELAY},
+        {"latch", CircuitType::LATCH}
+    };
+    for (const auto& n : names) {
+        if (word == n.name) { type = n.type; return true; }
+    }
+    return false;
+}
+
+static std::string RestOfLine(std::istringstream& ss) {
+    std::string rest;
+    std::getline(ss >> std::ws, rest);
+    while (!rest.empty() && (rest.back() == '\r' || rest.back() == ' ')) rest.pop_back();
+    return rest;
+}
+
+static bool ParseTrigger(std::istringstream& ss, LevelTrigger& trigger) {
+    std::string action, event, shape;
+    TriggerZone& zone = trigger.zone;
+    zone = TriggerZone();
+    zone.enabled = true;
+    zone.once = false;
+    zone.showMarker = false;
+    zone.param = 0;
+    if (!(ss >> action >> zone.param >> event >> shape)) return false;
+
+    if (action == "puzzle") zone.action = TriggerAction::OPEN_PUZZLE;
+    else if (action == "dialogue") zone.action = TriggerAction::START_DIALOGUE;
+    else if (action == "toggle") zone.action = TriggerAction::TOGGLE_CIRCUIT;
+    else return false;
+
+    if (event == "enter") zone.fireOn = TriggerEvent::ENTER;
+    else if (event == "exit") zone.fireOn = TriggerEvent::EXIT;
+    else if (event == "interact") zone.fireOn = TriggerEvent::INTERACT;
+    else return false;
+
+    // Formas: "rect x y w h" ou "plus x y" (a célula e as 4 vizinhas). O marcador fica em x, y
+    int x, y;
+    if (!(ss >> x >> y)) return false;
+    if (shape == "rect") {
+        int w, h;
+        if (!(ss >> w >> h) || w <= 0 || h <= 0) return false;
+        trigger.cells.reserve(w * h);
+        for (int cy = y; cy < y + h; ++cy) {
+            for (int cx = x; cx < x + w; ++cx) trigger.cells.push_back({cx, cy});
+        }
+    } else if (shape == "plus") {
+        trigger.cells = {{x, y}, {x, y - 1}, {x, y + 1}, {x - 1, y}, {x + 1, y}};
+    } else {
+        return false;
+    }
+    zone.markerX = x;
+    zone.markerY = y;
+
+    std::string flag;
+    while (ss >> flag) {
+        if (flag == "once") zone.once = true;
+        else if (flag == "marker") zone.showMarker = true;
+        else return false;
+    }
+    return true;
+}
+
+bool LevelLoader::ParseFile(const std::string& filename, LevelObjects& out) {
+    TRACE_ZONE("LevelLoader::ParseFile");
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Could not open level objects " << filename << "\n";
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Uma linha por objeto no caso comum: reserva antes de ler para não realocar no meio
+    size_t lineCount = std::count(text.begin(), text.end(), '\n') + 1;
+    out.elements.reserve(lineCount);
+
+    std::istringstream input(text);
+    std::string line;
+    std::vector<std::string>* lines = nullptr; // Destino das linhas "line"/"speaker" seguintes
+    std::string* speaker = nullptr;
+    int lineNumber = 0;
+    int errors = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::istringstream ss(line);
+        std::string kind;
+        if (!(ss >> kind) || kind[0] == '#') continue;
+
+        bool ok = true;
+        CircuitType type;
+        if (ParseCircuitType(kind, type)) {
+            CircuitElement el;
+            el.type = type;
+            el.isActive = false;
+            el.delayTicks = 0;
+            ok = static_cast<bool>(ss >> el.id >> el.gridX >> el.gridY);
+            if (ok && type == CircuitType::DELAY) ok = static_cast<bool>(ss >> el.delayTicks);
+            int net;
+            while (ok && ss >> net) el.inputs.push_back(net);
+            if (ok) out.elements.push_back(std::move(el));
+        } else if (kind == "trigger") {
+            LevelTrigger trigger;
+            ok = ParseTrigger(ss, trigger);
+            if (ok) {
+                out.triggers.push_back(std::move(trigger));
+                lines = &out.triggers.back().zone.lines;
+                speaker = &out.triggers.back().zone.speaker;
+            }
+        } else if (kind == "npc") {
+            NpcSpawn npc;
+            ok = static_cast<bool>(ss >> npc.x >> npc.y);
+            npc.speaker = RestOfLine(ss);
+            if (ok) {
+                out.npcs.push_back(std::move(npc));
+                lines = &out.npcs.back().lines;
+                speaker = &out.npcs.back().speaker;
+            }
+        } else if (kind == "speaker" && speaker) {
+            *speaker = RestOfLine(ss);
+        } else if (kind == "line" && lines) {
+            lines->push_back(RestOfLine(ss));
+        } else if (kind == "spawn") {
+            ok = static_cast<bool>(ss >> out.spawnX >> out.spawnY);
+            out.hasSpawn = ok;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "Warning: " << filename << ":" << lineNumber << ": invalid object \"" << line << "\"\n";
+            ++errors;
+        }
+    }
+
+    std::cout << "[LEVEL] Objects: " << out.elements.size() << " circuit elements, " << out.triggers.size()
+              << " triggers, " << out.npcs.size() << " NPCs (" << errors << " errors)\n";
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef LEVEL_LOADER_H
+#define LEVEL_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CircuitSystem.h"
+#include "TriggerSystem.h"
+
+struct LevelTrigger {
+    TriggerZone zone;
+    std::vector<SDL_Point> cells;
+};
+
+struct NpcSpawn {
+    int x;
+    int y;
+    std::string speaker;
+    std::vector<std::string> lines;
+};
+
+// Camada de objetos de uma fase (switches, portas, gatilhos, NPCs), já pronta para inserção em lote
+struct LevelObjects {
+    std::vector<CircuitElement> elements;
+    std::vector<LevelTrigger> triggers;
+    std::vector<NpcSpawn> npcs;
+    bool hasSpawn = false;
+    int spawnX = 0;
+    int spawnY = 0;
+};
+
+// Lê a camada de objetos numa thread separada; o jogo consulta o resultado com Poll a cada frame
+class LevelLoader {
+public:
+    LevelLoader();
+    ~LevelLoader();
+
+    void Start(const std::string& filename);
+    bool Poll(LevelObjects& out); // Não bloqueia: true uma vez, quando o arquivo terminou de ser lido
+    bool Wait(LevelObjects& out); // Bloqueia até a leitura terminar (replay: mesmo quadro em toda execução)
+    bool IsLoading() const { return worker.joinable(); }
+    void Shutdown();
+
+    static bool ParseFile(const std::string& filename, LevelObjects& out);
+
+private:
+    std::thread worker;
+    std::atomic<bool> ready;
+    LevelObjects result;
+};
+
+#endif // LEVEL_LOADER_H
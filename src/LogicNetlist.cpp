@@ -0,0 +1,462 @@
+#include "LogicNetlist.h"
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+static const int CONST0_BIT = 0;
+static const int CONST1_BIT = 1;
+static const int LOGIC_PARALLEL_SLICES = 512; // Nível (ou estado) com menos fatias que isso roda direto
+static const int LOGIC_SLICE_GRAIN = 256;     // Fatias por job
+
+static bool IsCombinational(LogicNetlist::Op op) {
+    return op == LogicNetlist::Op::AND || op == LogicNetlist::Op::OR || op == LogicNetlist::Op::NOT;
+}
+
+static uint64_t WordMask(int count) {
+    return count >= 64 ? ~0ull : ((1ull << count) - 1);
+}
+
+LogicNetlist::LogicNetlist() : jobs(nullptr), compiled(false), pending(false) {}
+
+void LogicNetlist::Clear() {
+    nodeOp.clear();
+    nodeParam.clear();
+    nodeInputs.clear();
+    bitOf.clear();
+    values.clear();
+    slices.clear();
+    sliceLevel.clear();
+    stateSlices.clear();
+    stateScratch.clear();
+    operands.clear();
+    gatherBits.clear();
+    readerStart.clear();
+    readers.clear();
+    dirtySlices.clear();
+    sliceQueued.clear();
+    changedWords.clear();
+    wordChanged.clear();
+    inputWords.clear();
+    inputQueued.clear();
+    stagedInputs.clear();
+    compiled = false;
+    pending = false;
+}
+
+int LogicNetlist::AddNode() {
+    nodeOp.push_back(Op::INPUT);
+    nodeParam.push_back(0);
+    nodeInputs.emplace_back();
+    compiled = false;
+    return (int)nodeOp.size() - 1;
+}
+
+void LogicNetlist::Define(int node, Op op, const std::vector<int>& inputs, int param) {
+    if (node < 0 || node >= (int)nodeOp.size()) return;
+    nodeOp[node] = op;
+    nodeParam[node] = param;
+    nodeInputs[node] = inputs;
+    compiled = false;
+}
+
+bool LogicNetlist::Compile() {
+    int n = (int)nodeOp.size();
+    bitOf.assign(n, CONST0_BIT);
+    slices.clear();
+    sliceLevel.clear();
+    stateSlices.clear();
+    operands.clear();
+    gatherBits.clear();
+
+    // Normaliza: entradas inválidas, portas sem entrada e delay zero (vira buffer)
+    std::vector<Op> op(nodeOp);
+    std::vector<std::vector<int>> in(nodeInputs);
+    for (int i = 0; i < n; ++i) {
+        for (int src : in[i]) {
+            if (src < 0 || src >= n) {
+                std::cerr << "Warning: LogicNetlist node " << i << " references invalid node " << src << "\n";
+                op[i] = Op::CONST0;
+                break;
+            }
+        }
+        if (op[i] == Op::DELAY && nodeParam[i] <= 0) op[i] = Op::OR;
+        size_t required = (op[i] == Op::LATCH) ? 2 : (op[i] == Op::INPUT || op[i] == Op::CONST0) ? 0 : 1;
+        if (in[i].size() < required) op[i] = Op::CONST0;
+        if (op[i] == Op::NOT || op[i] == Op::DELAY) in[i].resize(1);
+        if (op[i] == Op::LATCH) in[i].resize(2);
+    }
+
+    // Levelização (Kahn) só sobre arestas combinacionais; estado e entradas são nível 0
+    std::vector<int> level(n, 0);
+    std::vector<int> pendingInputs(n, 0);
+    std::vector<int> dependentStart(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        if (!IsCombinational(op[i])) continue;
+        for (int src : in[i]) {
+            if (IsCombinational(op[src])) {
+                ++pendingInputs[i];
+                ++dependentStart[src + 1];
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) dependentStart[i + 1] += dependentStart[i];
+    std::vector<int> dependents(dependentStart[n]);
+    std::vector<int> fill(dependentStart.begin(), dependentStart.end() - 1);
+    for (int i = 0; i < n; ++i) {
+        if (!IsCombinational(op[i])) continue;
+        for (int src : in[i]) {
+            if (IsCombinational(op[src])) dependents[fill[src]++] = i;
+        }
+    }
+
+    std::vector<int> order;
+    order.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (IsCombinational(op[i]) && pendingInputs[i] == 0) {
+            level[i] = 1;
+            order.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        int node = order[head];
+        for (int k = dependentStart[node]; k < dependentStart[node + 1]; ++k) {
+            int dep = dependents[k];
+            level[dep] = std::max(level[dep], level[node] + 1);
+            if (--pendingInputs[dep] == 0) order.push_back(dep);
+        }
+    }
+
+    int cycleNodes = 0;
+    for (int i = 0; i < n; ++i) {
+        if (IsCombinational(op[i]) && pendingInputs[i] > 0) {
+            op[i] = Op::CONST0; // Laço sem delay/latch: desativa em vez de oscilar
+            ++cycleNodes;
+        }
+    }
+    if (cycleNodes > 0) {
+        std::cerr << "Warning: LogicNetlist has a combinational loop; " << cycleNodes
+                  << " gates forced to 0 (use DELAY or LATCH to break it)\n";
+    }
+
+    // Layout: palavra 0 = constantes, depois entradas, registradores, latches e fatias por nível
+    int nextWord = 1;
+    int inputCount = 0;
+    for (int i = 0; i < n; ++i) {
+        if (op[i] == Op::INPUT) bitOf[i] = nextWord * 64 + inputCount++;
+    }
+    nextWord += (inputCount + 63) / 64;
+
+    // Delays de N ticks viram N registradores em cadeia; só o último é visível como nó
+    std::vector<int> registerSource;  // Nó de origem, ou -1 = registrador anterior da cadeia
+    std::vector<int> delayNodes;
+    for (int i = 0; i < n; ++i) {
+        if (op[i] != Op::DELAY) continue;
+        delayNodes.push_back(i);
+        registerSource.push_back(in[i][0]);
+        for (int k = 1; k < nodeParam[i]; ++k) registerSource.push_back(-1);
+        bitOf[i] = (int)registerSource.size() - 1; // Relativo; corrigido abaixo
+    }
+    int registerWord = nextWord;
+    int registerCount = (int)registerSource.size();
+    for (int node : delayNodes) bitOf[node] += registerWord * 64;
+    nextWord += (registerCount + 63) / 64;
+
+    std::vector<int> latchNodes;
+    for (int i = 0; i < n; ++i) {
+        if (op[i] == Op::LATCH) latchNodes.push_back(i);
+    }
+    int latchWord = nextWord;
+    for (size_t k = 0; k < latchNodes.size(); ++k) bitOf[latchNodes[k]] = latchWord * 64 + (int)k;
+    nextWord += ((int)latchNodes.size() + 63) / 64;
+
+    // Ordena por (nível, operação, fan-in) para que cada fatia seja homogênea
+    std::vector<int> gates;
+    for (int node : order) {
+        if (IsCombinational(op[node])) gates.push_back(node);
+    }
+    std::stable_sort(gates.begin(), gates.end(), [&](int a, int b) {
+        if (level[a] != level[b]) return level[a] < level[b];
+        if (op[a] != op[b]) return op[a] < op[b];
+        return in[a].size() < in[b].size();
+    });
+
+    std::vector<int> bits;
+    size_t start = 0;
+    while (start < gates.size()) {
+        size_t end = start + 1;
+        while (end < gates.size() && end - start < 64 &&
+               level[gates[end]] == level[gates[start]] && op[gates[end]] == op[gates[start]]) {
+            ++end;
+        }
+
+        Slice slice;
+        slice.op = op[gates[start]];
+        slice.outWord = nextWord++;
+        slice.count = (int)(end - start);
+        slice.fanIn = (int)in[gates[end - 1]].size();
+        for (int k = 0; k < slice.count; ++k) bitOf[gates[start + k]] = slice.outWord * 64 + k;
+
+        // Portas com menos entradas são completadas com o elemento neutro da operação
+        int padBit = (slice.op == Op::AND) ? CONST1_BIT : CONST0_BIT;
+        slice.operandStart = (int)operands.size();
+        for (int j = 0; j < slice.fanIn; ++j) {
+            bits.clear();
+            for (int k = 0; k < slice.count; ++k) {
+                const std::vector<int>& gateInputs = in[gates[start + k]];
+                bits.push_back(j < (int)gateInputs.size() ? bitOf[gateInputs[j]] : padBit);
+            }
+            AddOperand(bits);
+        }
+        slices.push_back(slice);
+        sliceLevel.push_back(level[gates[start]]);
+        start = end;
+    }
+
+    // Operandos do estado dependem dos bits de qualquer nó, então vêm por último
+    std::vector<std::vector<int>> stateBits(1);
+    for (int k = 0; k < registerCount; ++k) {
+        int src = registerSource[k];
+        stateBits[0].push_back(src >= 0 ? bitOf[src] : registerWord * 64 + k - 1);
+    }
+    AddStateSlices(Op::DELAY, registerWord, registerCount, stateBits);
+
+    stateBits.assign(2, std::vector<int>());
+    for (int node : latchNodes) {
+        stateBits[0].push_back(bitOf[in[node][0]]);
+        stateBits[1].push_back(bitOf[in[node][1]]);
+    }
+    AddStateSlices(Op::LATCH, latchWord, (int)latchNodes.size(), stateBits);
+
+    values.assign(nextWord, 0);
+    values[0] = 1ull << CONST1_BIT;
+    stateScratch.assign(stateSlices.size(), 0);
+    BuildReaders();
+
+    int maxLevel = gates.empty() ? 0 : level[gates.back()];
+    std::cout << "[LOGIC] Netlist: " << n << " nodes, " << slices.size() << " slices, "
+              << maxLevel << " levels, " << registerCount << " registers, " << latchNodes.size() << " latches\n";
+
+    // Primeiro tick: avalia tudo (índices crescentes já formam um heap mínimo)
+    dirtySlices.resize(slices.size());
+    for (int k = 0; k < (int)slices.size(); ++k) dirtySlices[k] = k;
+    sliceQueued.assign(slices.size(), 1);
+    changedWords.clear();
+    wordChanged.assign(values.size(), 0);
+    inputWords.clear();
+    inputQueued.assign(values.size(), 0);
+    stagedInputs.assign(values.size(), 0);
+
+    compiled = true;
+    pending = true;
+    return cycleNodes == 0;
+}
+
+void LogicNetlist::BuildReaders() {
+    // Palavras lidas por cada fatia (diretas ou de algum bit coletado), sem repetir na mesma fatia
+    std::vector<int> lastReader(values.size(), -1);
+    std::vector<std::pair<int, int>> edges; // (palavra, fatia)
+    for (int s = 0; s < (int)slices.size(); ++s) {
+        const Slice& slice = slices[s];
+        for (int j = 0; j < slice.fanIn; ++j) {
+            const Operand& operand = operands[slice.operandStart + j];
+            auto add = [&](int word) {
+                if (lastReader[word] == s) return;
+                lastReader[word] = s;
+                edges.push_back({word, s});
+            };
+            if (operand.directWord >= 0) {
+                add(operand.directWord);
+            } else {
+                for (int k = 0; k < slice.count; ++k) add((int)(gatherBits[operand.gatherStart + k] >> 6));
+            }
+        }
+    }
+    readerStart.assign(values.size() + 1, 0);
+    for (const auto& edge : edges) ++readerStart[edge.first + 1];
+    for (size_t w = 0; w < values.size(); ++w) readerStart[w + 1] += readerStart[w];
+    readers.resize(edges.size());
+    std::vector<int> fill(readerStart.begin(), readerStart.end() - 1);
+    for (const auto& edge : edges) readers[fill[edge.first]++] = edge.second;
+}
+
+int LogicNetlist::AddOperand(const std::vector<int>& bits) {
+    // Caminho rápido: os bits já formam uma palavra inteira na mesma ordem
+    Operand operand;
+    operand.directWord = bits[0] / 64;
+    for (int k = 0; k < (int)bits.size(); ++k) {
+        if (bits[k] != operand.directWord * 64 + k) {
+            operand.directWord = -1;
+            break;
+        }
+    }
+    operand.gatherStart = -1;
+    if (operand.directWord < 0) {
+        operand.gatherStart = (int)gatherBits.size();
+        gatherBits.insert(gatherBits.end(), bits.begin(), bits.end());
+    }
+    operands.push_back(operand);
+    return (int)operands.size() - 1;
+}
+
+void LogicNetlist::AddStateSlices(Op op, int firstWord, int count, const std::vector<std::vector<int>>& operandBits) {
+    std::vector<int> bits;
+    for (int base = 0; base < count; base += 64) {
+        Slice slice;
+        slice.op = op;
+        slice.outWord = firstWord + base / 64;
+        slice.count = std::min(64, count - base);
+        slice.fanIn = (int)operandBits.size();
+        slice.operandStart = (int)operands.size();
+        for (const std::vector<int>& source : operandBits) {
+            bits.assign(source.begin() + base, source.begin() + base + slice.count);
+            AddOperand(bits);
+        }
+        stateSlices.push_back(slice);
+    }
+}
+
+uint64_t LogicNetlist::FetchOperand(const Operand& operand, int count) const {
+    if (operand.directWord >= 0) return values[operand.directWord];
+
+    uint64_t word = 0;
+    const uint32_t* bit = &gatherBits[operand.gatherStart];
+    for (int k = 0; k < count; ++k) {
+        word |= ((values[bit[k] >> 6] >> (bit[k] & 63)) & 1ull) << k;
+    }
+    return word;
+}
+
+void LogicNetlist::SetInput(int node, bool value) {
+    if (!compiled || node < 0 || node >= (int)bitOf.size() || nodeOp[node] != Op::INPUT) return;
+    int index = bitOf[node] >> 6;
+    uint64_t bit = 1ull << (bitOf[node] & 63);
+    // Compara com o valor que vale no próximo Tick (aplicado ^ bits ainda na fila)
+    if ((((values[index] ^ stagedInputs[index]) & bit) != 0) == value) return;
+    stagedInputs[index] ^= bit;
+    if (!inputQueued[index]) {
+        inputQueued[index] = 1;
+        inputWords.push_back(index);
+    }
+    pending = true;
+}
+
+bool LogicNetlist::Get(int node) const {
+    if (!compiled || node < 0 || node >= (int)bitOf.size()) return false;
+    return (values[bitOf[node] >> 6] >> (bitOf[node] & 63)) & 1ull;
+}
+
+int LogicNetlist::GetWord(int node) const {
+    if (!compiled || node < 0 || node >= (int)bitOf.size()) return -1;
+    return bitOf[node] >> 6;
+}
+
+uint64_t LogicNetlist::EvalStateSlice(const Slice& slice) const {
+    const Operand* ops = &operands[slice.operandStart];
+    uint64_t next;
+    if (slice.op == Op::DELAY) {
+        next = FetchOperand(ops[0], slice.count);
+    } else {
+        uint64_t set = FetchOperand(ops[0], slice.count);
+        uint64_t reset = FetchOperand(ops[1], slice.count);
+        next = set | (values[slice.outWord] & ~reset);
+    }
+    return next & WordMask(slice.count);
+}
+
+bool LogicNetlist::EvalSlice(const Slice& slice) {
+    const Operand* ops = &operands[slice.operandStart];
+    uint64_t result;
+    if (slice.op == Op::NOT) {
+        result = ~FetchOperand(ops[0], slice.count);
+    } else if (slice.op == Op::AND) {
+        result = ~0ull;
+        for (int j = 0; j < slice.fanIn; ++j) result &= FetchOperand(ops[j], slice.count);
+    } else {
+        result = 0;
+        for (int j = 0; j < slice.fanIn; ++j) result |= FetchOperand(ops[j], slice.count);
+    }
+    result &= WordMask(slice.count);
+    if (values[slice.outWord] == result) return false;
+    values[slice.outWord] = result;
+    return true;
+}
+
+void LogicNetlist::QueueSlice(int slice) {
+    if (sliceQueued[slice]) return;
+    sliceQueued[slice] = 1;
+    dirtySlices.push_back(slice);
+    std::push_heap(dirtySlices.begin(), dirtySlices.end(), std::greater<int>());
+}
+
+void LogicNetlist::MarkWordChanged(int word) {
+    if (wordChanged[word]) return;
+    wordChanged[word] = 1;
+    changedWords.push_back(word);
+    for (int k = readerStart[word]; k < readerStart[word + 1]; ++k) QueueSlice(readers[k]);
+}
+
+void LogicNetlist::EvalBatch() {
+    int count = (int)levelBatch.size();
+    batchChanged.resize(count);
+    if (!jobs || count < LOGIC_PARALLEL_SLICES) {
+        for (int i = 0; i < count; ++i) batchChanged[i] = EvalSlice(slices[levelBatch[i]]);
+        return;
+    }
+    // Cada fatia escreve a própria palavra e só lê níveis anteriores
+    jobs->ParallelFor(count, LOGIC_SLICE_GRAIN, [this](int begin, int end) {
+        for (int i = begin; i < end; ++i) batchChanged[i] = EvalSlice(slices[levelBatch[i]]);
+    });
+}
+
+bool LogicNetlist::Tick() {
+    if (!compiled || !pending) return false;
+    for (int word : changedWords) wordChanged[word] = 0;
+    changedWords.clear();
+
+    // 1) Estado: todos capturam ao mesmo tempo a partir dos valores do tick anterior
+    // (as entradas novas ainda não foram aplicadas, como a saída de qualquer porta)
+    auto captureState = [this](int begin, int end) {
+        for (int s = begin; s < end; ++s) stateScratch[s] = EvalStateSlice(stateSlices[s]);
+    };
+    int stateCount = (int)stateSlices.size();
+    if (jobs && stateCount >= LOGIC_PARALLEL_SLICES) jobs->ParallelFor(stateCount, LOGIC_SLICE_GRAIN, captureState);
+    else captureState(0, stateCount);
+    for (int word : inputWords) {
+        inputQueued[word] = 0;
+        if (!stagedInputs[word]) continue; // Ligou e desligou antes do tick
+        values[word] ^= stagedInputs[word];
+        stagedInputs[word] = 0;
+        MarkWordChanged(word);
+    }
+    inputWords.clear();
+    for (size_t s = 0; s < stateSlices.size(); ++s) {
+        uint64_t& word = values[stateSlices[s].outWord];
+        if (word != stateScratch[s]) {
+            word = stateScratch[s];
+            MarkWordChanged(stateSlices[s].outWord);
+        }
+    }
+
+    // 2) Lógica combinacional, nível a nível, só nas fatias que leem uma palavra que mudou.
+    // Quem lê a saída de uma fatia está num nível acima, então o heap nunca volta de nível
+    while (!dirtySlices.empty()) {
+        int level = sliceLevel[dirtySlices.front()];
+        levelBatch.clear();
+        while (!dirtySlices.empty() && sliceLevel[dirtySlices.front()] == level) {
+            std::pop_heap(dirtySlices.begin(), dirtySlices.end(), std::greater<int>());
+            int slice = dirtySlices.back();
+            dirtySlices.pop_back();
+            sliceQueued[slice] = 0;
+            levelBatch.push_back(slice);
+        }
+        EvalBatch();
+        for (size_t i = 0; i < levelBatch.size(); ++i) {
+            if (batchChanged[i]) MarkWordChanged(slices[levelBatch[i]].outWord);
+        }
+    }
+
+    // Um tick sem nenhuma mudança significa que os seguintes também não mudariam
+    bool changed = !changedWords.empty();
+    pending = changed;
+    return changed;
+}
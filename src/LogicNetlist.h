@@ -0,0 +1,112 @@
+#ifndef LOGIC_NETLIST_H
+#define LOGIC_NETLIST_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "JobSystem.h"
+
+// Netlist lógica do mundo (switches, placas, portas lógicas, delays, latches).
+// Cada nó é um bit; depois de Compile() os nós são renumerados para que as saídas
+// de portas do mesmo nível e mesma operação fiquem contíguas, e cada palavra de
+// 64 bits é avaliada com uma única operação (bit-sliced). O Tick só avalia as fatias que leem
+// uma palavra que mudou (cadeias longas param onde o sinal para). Fatias do mesmo nível não
+// dependem umas das outras: níveis largos são avaliados em paralelo no JobSystem.
+class LogicNetlist {
+public:
+    enum class Op : Uint8 {
+        INPUT,  // Valor definido de fora (switch, placa de pressão)
+        AND,
+        OR,
+        NOT,
+        DELAY,  // Saída = entrada de 'param' ticks atrás
+        LATCH,  // Entradas: set, reset. Mantém o estado entre ticks
+        CONST0
+    };
+
+    LogicNetlist();
+
+    void SetJobSystem(JobSystem* jobSystem) { jobs = jobSystem; } // nullptr = tudo na thread atual
+    void Clear();
+    // Nós podem ser criados antes de definidos, permitindo referências adiante
+    int AddNode();
+    void Define(int node, Op op, const std::vector<int>& inputs, int param = 0);
+
+    // Levelização e layout bit-sliced. Ciclos combinacionais viram constante 0 com aviso
+    bool Compile();
+    bool IsCompiled() const { return compiled; }
+
+    // A entrada vale a partir do próximo Tick, depois da captura de estado: um delay ligado
+    // direto num switch atrasa o mesmo que um ligado através de uma porta
+    void SetInput(int node, bool value);
+    bool Get(int node) const;
+
+    // Avança um tick. Retorna true se algum sinal mudou; sem mudanças pendentes não faz nada
+    bool Tick();
+    bool IsStable() const { return !pending; }
+    // Palavras (de GetWord) que mudaram no último Tick, inclusive entradas definidas antes dele
+    const std::vector<int>& GetChangedWords() const { return changedWords; }
+    int GetWord(int node) const;
+    int GetWordCount() const { return (int)values.size(); }
+
+    int GetNodeCount() const { return (int)nodeOp.size(); }
+    int GetSliceCount() const { return (int)slices.size(); }
+
+private:
+    // Operando de uma fatia: palavra inteira (caminho rápido) ou lista de bits a coletar
+    struct Operand {
+        int directWord;  // >= 0: usa values[directWord] como está
+        int gatherStart; // Senão: 'count' posições de bit em gatherBits
+    };
+    struct Slice {
+        Op op;
+        int outWord;
+        int count;        // Portas nesta palavra (1..64)
+        int operandStart; // Índice em operands
+        int fanIn;
+    };
+
+    uint64_t FetchOperand(const Operand& operand, int count) const;
+    uint64_t EvalStateSlice(const Slice& slice) const; // Próximo valor do registrador/latch
+    bool EvalSlice(const Slice& slice);                 // Grava a saída; true se mudou
+    void EvalBatch();                                   // Fatias de levelBatch (um nível)
+    void MarkWordChanged(int word);                     // Reporta e agenda as fatias que leem a palavra
+    void QueueSlice(int slice);
+    void BuildReaders();
+    int AddOperand(const std::vector<int>& bits);
+    void AddStateSlices(Op op, int firstWord, int count, const std::vector<std::vector<int>>& operandBits);
+
+    // Definição (antes do Compile)
+    std::vector<Op> nodeOp;
+    std::vector<int> nodeParam;
+    std::vector<std::vector<int>> nodeInputs;
+
+    // Layout compilado
+    std::vector<int> bitOf;          // Nó -> posição de bit em values
+    std::vector<uint64_t> values;
+    std::vector<Slice> slices;       // Combinacionais, em ordem de nível
+    std::vector<int> sliceLevel;
+    std::vector<Slice> stateSlices;  // Registradores (delays expandidos) e latches
+    std::vector<uint64_t> stateScratch;
+    std::vector<Operand> operands;
+    std::vector<uint32_t> gatherBits;
+
+    // Propagação por evento: palavra -> fatias combinacionais que a leem
+    std::vector<int> readerStart;
+    std::vector<int> readers;
+    std::vector<int> dirtySlices;    // Heap mínimo de índices (= ordem de nível)
+    std::vector<Uint8> sliceQueued;
+    std::vector<int> levelBatch;
+    std::vector<Uint8> batchChanged;
+    std::vector<int> changedWords;
+    std::vector<Uint8> wordChanged;
+    std::vector<int> inputWords;     // Entradas mudadas desde o último Tick
+    std::vector<Uint8> inputQueued;
+    std::vector<uint64_t> stagedInputs; // Bits a inverter em values no próximo Tick
+
+    JobSystem* jobs;
+    bool compiled;
+    bool pending;
+};
+
+#endif // LOGIC_NETLIST_H
@@ -0,0 +1,195 @@
+#include "PerfMonitor.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+static const int PERF_TEXT_REFRESH = 15;   // Rasterizar a HUD todo quadro distorceria os próprios contadores
+static const int HITCH_MIN_HISTORY = 30;
+static const float HITCH_FACTOR = 1.5f;    // Engasgo: quadro 50% acima da mediana...
+static const float HITCH_MIN_MS = 4.0f;    // ...e pelo menos 4 ms mais longo
+static const char* PERF_CSV_FILE = "perf_log.csv";
+
+#define PERF_NAME_ENTRY(name, label) label,
+static const char* SECTION_NAMES[] = { PERF_SECTIONS(PERF_NAME_ENTRY) };
+static const char* COUNTER_NAMES[] = { PERF_COUNTERS(PERF_NAME_ENTRY) };
+#undef PERF_NAME_ENTRY
+
+int PerfMonitor::counters[PERF_COUNTER_COUNT] = {};
+
+PerfMonitor::PerfMonitor()
+    : frequency(1.0), frameStart(0), cpuEnd(0), sectionTicks(), historyHead(0), historyCount(0),
+      frameIndex(0), hitchCount(0), hudVisible(false), font(nullptr),
+      textW(0), textH(0), framesSinceText(PERF_TEXT_REFRESH) {}
+
+PerfMonitor::~PerfMonitor() {
+    Shutdown();
+}
+
+bool PerfMonitor::Initialize() {
+    frequency = (double)SDL_GetPerformanceFrequency();
+    history.assign(PERF_HISTORY, FrameRecord());
+    scratch.reserve(PERF_HISTORY);
+    return true;
+}
+
+void PerfMonitor::Shutdown() {
+    if (csv.is_open()) csv.close();
+    hudText.clear();
+    font = nullptr;
+}
+
+void PerfMonitor::BeginFrame() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (frameStart != 0) FinishFrame(now);
+    frameStart = now;
+    cpuEnd = 0;
+    std::fill(sectionTicks, sectionTicks + PERF_SECTION_COUNT, (Uint64)0);
+    std::fill(counters, counters + PERF_COUNTER_COUNT, 0);
+}
+
+void PerfMonitor::EndFrame() {
+    cpuEnd = SDL_GetPerformanceCounter();
+}
+
+void PerfMonitor::FinishFrame(Uint64 frameEnd) {
+    FrameRecord& rec = history[historyHead];
+    rec.frameMs = (float)((frameEnd - frameStart) * 1000.0 / frequency);
+    rec.cpuMs = (float)(((cpuEnd ? cpuEnd : frameEnd) - frameStart) * 1000.0 / frequency);
+    for (int i = 0; i < PERF_SECTION_COUNT; ++i) rec.sectionMs[i] = (float)(sectionTicks[i] * 1000.0 / frequency);
+    std::copy(counters, counters + PERF_COUNTER_COUNT, rec.counters);
+
+    // Compara com a mediana dos quadros anteriores (antes de inserir este)
+    rec.hitch = false;
+    if (historyCount >= HITCH_MIN_HISTORY) {
+        float median = Percentile(&FrameRecord::frameMs, 0.5f);
+        rec.hitch = rec.frameMs > median * HITCH_FACTOR && rec.frameMs > median + HITCH_MIN_MS;
+    }
+    if (rec.hitch) {
+        ++hitchCount;
+        std::cout << "[PERF] Hitch at frame " << frameIndex << ": " << rec.frameMs << " ms (cpu " << rec.cpuMs << " ms)\n";
+    }
+
+    if (csv.is_open()) WriteCSVRow(rec);
+
+    historyHead = (historyHead + 1) % PERF_HISTORY;
+    if (historyCount < PERF_HISTORY) ++historyCount;
+    ++frameIndex;
+    ++framesSinceText;
+}
+
+float PerfMonitor::Percentile(float FrameRecord::* field, float p) {
+    if (historyCount == 0) return 0.0f;
+    scratch.clear();
+    for (int i = 0; i < historyCount; ++i) {
+        int slot = (historyHead - 1 - i + PERF_HISTORY) % PERF_HISTORY;
+        scratch.push_back(history[slot].*field);
+    }
+    size_t k = std::min(scratch.size() - 1, (size_t)(p * scratch.size()));
+    std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+    return scratch[k];
+}
+
+void PerfMonitor::ToggleCSV() {
+    if (csv.is_open()) {
+        csv.close();
+        std::cout << "[PERF] CSV recording stopped (" << PERF_CSV_FILE << ")\n";
+        return;
+    }
+    csv.open(PERF_CSV_FILE, std::ios::trunc);
+    if (!csv.is_open()) {
+        std::cerr << "Warning: Could not open " << PERF_CSV_FILE << " for writing\n";
+        return;
+    }
+    WriteCSVHeader();
+    std::cout << "[PERF] CSV recording to " << PERF_CSV_FILE << "\n";
+}
+
+void PerfMonitor::WriteCSVHeader() {
+    csv << "frame,frame_ms,cpu_ms";
+    for (const char* name : SECTION_NAMES) csv << ',' << name;
+    for (const char* name : COUNTER_NAMES) csv << ',' << name;
+    csv << ",hitch\n";
+}
+
+void PerfMonitor::WriteCSVRow(const FrameRecord& rec) {
+    char buf[32];
+    csv << frameIndex;
+    std::snprintf(buf, sizeof(buf), ",%.3f,%.3f", rec.frameMs, rec.cpuMs);
+    csv << buf;
+    for (float ms : rec.sectionMs) {
+        std::snprintf(buf, sizeof(buf), ",%.3f", ms);
+        csv << buf;
+    }
+    for (int count : rec.counters) csv << ',' << count;
+    csv << ',' << (rec.hitch ? 1 : 0) << '\n';
+}
+
+void PerfMonitor::RebuildText() {
+    framesSinceText = 0;
+    hudText.clear();
+    textW = 0;
+    textH = 0;
+    if (!font || historyCount == 0) return;
+
+    const FrameRecord& last = history[(historyHead - 1 + PERF_HISTORY) % PERF_HISTORY];
+    std::string text;
+    char line[96];
+    std::snprintf(line, sizeof(line), "FRAME p50 %.2f p95 %.2f p99 %.2f ms\n",
+                  Percentile(&FrameRecord::frameMs, 0.5f), Percentile(&FrameRecord::frameMs, 0.95f),
+                  Percentile(&FrameRecord::frameMs, 0.99f));
+    text += line;
+    std::snprintf(line, sizeof(line), "CPU   p50 %.2f p95 %.2f p99 %.2f ms\n",
+                  Percentile(&FrameRecord::cpuMs, 0.5f), Percentile(&FrameRecord::cpuMs, 0.95f),
+                  Percentile(&FrameRecord::cpuMs, 0.99f));
+    text += line;
+    std::snprintf(line, sizeof(line), "HITCHES %lld%s\n", hitchCount, csv.is_open() ? "  [CSV]" : "");
+    text += line;
+
+    // Só as seções que rodaram no último quadro
+    for (int i = 0; i < PERF_SECTION_COUNT; ++i) {
+        if (last.sectionMs[i] <= 0.0f) continue;
+        std::snprintf(line, sizeof(line), "%-22s %6.3f ms\n", SECTION_NAMES[i], last.sectionMs[i]);
+        text += line;
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        std::snprintf(line, sizeof(line), "%-22s %6d\n", COUNTER_NAMES[i], last.counters[i]);
+        text += line;
+    }
+
+    // A rasterização fica com a thread de render; aqui só o tamanho para o painel
+    if (!text.empty() && text.back() == '\n') text.pop_back();
+    hudText = text;
+    RenderList::MeasureText(font, hudText.c_str(), &textW, &textH);
+}
+
+void PerfMonitor::Render(RenderList& list) {
+    if (!hudVisible) return;
+    if (framesSinceText >= PERF_TEXT_REFRESH) RebuildText();
+
+    const int graphH = 60;
+    SDL_Rect panel = {4, 4, std::max(textW, PERF_HISTORY) + 8, textH + graphH + 16};
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+    list.SetDrawColor(0, 0, 0, 180);
+    list.FillRect(panel);
+
+    SDL_Color color = {200, 255, 200, 255};
+    list.TextWrapped(font, hudText.c_str(), color, 8, 8, 400);
+
+    // Gráfico do tempo de quadro: 1 px = 0.5 ms, linha de referência em 16.7 ms, engasgos em vermelho
+    bars.clear();
+    hitchBars.clear();
+    int baseY = 8 + textH + 4 + graphH;
+    for (int i = 0; i < historyCount; ++i) {
+        const FrameRecord& rec = history[(historyHead - historyCount + i + PERF_HISTORY) % PERF_HISTORY];
+        int h = std::min(graphH, (int)(rec.frameMs * 2.0f));
+        SDL_Rect bar = {8 + i, baseY - h, 1, h};
+        (rec.hitch ? hitchBars : bars).push_back(bar);
+    }
+    list.SetDrawColor(0, 200, 255, 255);
+    if (!bars.empty()) list.FillRects(bars.data(), (int)bars.size());
+    list.SetDrawColor(255, 40, 40, 255);
+    if (!hitchBars.empty()) list.FillRects(hitchBars.data(), (int)hitchBars.size());
+    list.SetDrawColor(255, 255, 0, 120);
+    int refY = baseY - (int)(1000.0f / 60.0f * 2.0f);
+    list.DrawLine(8, refY, 8 + PERF_HISTORY, refY);
+}
@@ -0,0 +1,132 @@
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "RenderList.h"
+
+// Seções cronometradas por quadro: X(enum, nome na HUD/CSV)
+#define PERF_SECTIONS(X) \
+    X(INPUT,                  "HandleInput") \
+    X(UPDATE_MAIN_MENU,       "Update_MainMenu") \
+    X(UPDATE_LEVEL_SELECTION, "Update_LevelSelection") \
+    X(UPDATE_EXPLORATION,     "Update_Exploration") \
+    X(UPDATE_PUZZLE,          "Update_Puzzle") \
+    X(UPDATE_DIALOGUE,        "Update_Dialogue") \
+    X(UPDATE_VICTORY,         "Update_Victory") \
+    X(UPDATE_VFX,             "VFX") \
+    X(UPDATE_ACHIEVEMENTS,    "AchievementSystem") \
+    X(ASSETS,                 "AssetLoader") \
+    X(RENDER_LOADING,         "Render_Loading") \
+    X(RENDER_MAIN_MENU,       "Render_MainMenu") \
+    X(RENDER_LEVEL_SELECTION, "Render_LevelSelection") \
+    X(RENDER_EXPLORATION,     "Render_Exploration") \
+    X(RENDER_VIGNETTE,        "Render_Vignette") \
+    X(RENDER_HUD,             "Render_HUD") \
+    X(RENDER_PUZZLE,          "Render_Puzzle") \
+    X(RENDER_DIALOGUE,        "Render_Dialogue") \
+    X(RENDER_VICTORY,         "Render_Victory") \
+    X(RENDER_ACHIEVEMENTS,    "Render_Achievements") \
+    X(PRESENT,                "Present") \
+    X(RENDER_THREAD,          "RenderThread")
+
+// Contadores por quadro: X(enum, nome). Os de render são contados na RenderList (gravação) e na
+// RenderThread (textos e texturas criadas)
+#define PERF_COUNTERS(X) \
+    X(DRAW_CALLS,      "draw calls") \
+    X(TEXTURE_CREATES, "texture creates") \
+    X(TTF_RENDERS,     "ttf renders") \
+    X(BLEND_CHANGES,   "blend changes") \
+    X(PARTICLES,       "particles") \
+    X(JOBS,            "jobs") \
+    X(JOB_STEALS,      "job steals") \
+    X(JOB_IDLE,        "job idle %") \
+    X(ASSET_KB,        "asset KB")
+
+#define PERF_ENUM_ENTRY(name, label) name,
+enum class PerfSection { PERF_SECTIONS(PERF_ENUM_ENTRY) COUNT };
+enum class PerfCounter { PERF_COUNTERS(PERF_ENUM_ENTRY) COUNT };
+#undef PERF_ENUM_ENTRY
+
+const int PERF_SECTION_COUNT = (int)PerfSection::COUNT;
+const int PERF_COUNTER_COUNT = (int)PerfCounter::COUNT;
+const int PERF_HISTORY = 240; // Quadros na janela dos percentis (4 s a 60 FPS)
+
+// Tempos por subsistema, contadores de render, percentis móveis e marcação de engasgos (hitches).
+// HUD com F7, gravação em CSV com F8.
+class PerfMonitor {
+public:
+    PerfMonitor();
+    ~PerfMonitor();
+
+    bool Initialize();
+    void SetFont(TTF_Font* hudFont) { font = hudFont; } // Do AssetLoader; sem fonte a HUD fica oculta
+    void Shutdown();
+
+    void BeginFrame(); // Fecha o quadro anterior (intervalo, histórico, CSV) e zera os acumuladores
+    void EndFrame();   // Fim do trabalho de CPU do quadro (antes da espera do pacing)
+
+    void AddTime(PerfSection section, Uint64 ticks) { sectionTicks[(int)section] += ticks; }
+    static void Count(PerfCounter counter, int amount = 1) { counters[(int)counter] += amount; }
+    static void SetGauge(PerfCounter counter, int value) { counters[(int)counter] = value; }
+
+    void ToggleHUD() { hudVisible = !hudVisible; }
+    bool IsHUDVisible() const { return hudVisible; }
+    void ToggleCSV();
+    void Render(RenderList& list);
+
+private:
+    struct FrameRecord {
+        float frameMs;
+        float cpuMs;
+        float sectionMs[PERF_SECTION_COUNT];
+        int counters[PERF_COUNTER_COUNT];
+        bool hitch;
+    };
+
+    void FinishFrame(Uint64 frameEnd);
+    float Percentile(float FrameRecord::* field, float p);
+    void WriteCSVHeader();
+    void WriteCSVRow(const FrameRecord& rec);
+    void RebuildText();
+
+    static int counters[PERF_COUNTER_COUNT];
+
+    double frequency;
+    Uint64 frameStart;
+    Uint64 cpuEnd;
+    Uint64 sectionTicks[PERF_SECTION_COUNT];
+
+    std::vector<FrameRecord> history; // Buffer circular de PERF_HISTORY quadros
+    int historyHead;
+    int historyCount;
+    long long frameIndex;
+    long long hitchCount;
+    std::vector<float> scratch;
+
+    bool hudVisible;
+    std::ofstream csv;
+    TTF_Font* font;
+    std::string hudText;      // Texto da HUD, refeito a cada PERF_TEXT_REFRESH quadros
+    int textW, textH;
+    int framesSinceText;
+    std::vector<SDL_Rect> bars;
+    std::vector<SDL_Rect> hitchBars;
+};
+
+// Cronometra o escopo atual numa seção do PerfMonitor
+class PerfScope {
+public:
+    PerfScope(PerfMonitor& perf, PerfSection timed)
+        : monitor(perf), section(timed), start(SDL_GetPerformanceCounter()) {}
+    ~PerfScope() { monitor.AddTime(section, SDL_GetPerformanceCounter() - start); }
+private:
+    PerfMonitor& monitor;
+    PerfSection section;
+    Uint64 start;
+};
+
+#endif // PERF_MONITOR_H
@@ -1,44 +1,21 @@
 #include "Player.h"
 #include "Game.h"
 #include <iostream>
-#include <SDL2/SDL_image.h>
-#include <chrono>
+#include <cmath>
 #include "TileMap.h"
 #include "CircuitSystem.h"
+#include "StateHash.h"
+#include "Trace.h"
 
-Player::Player() : gridX(3), gridY(3), worldX(3 * TILE_SIZE), worldY(3 * TILE_SIZE), isMoving(false), direction(DOWN), frame(0), frameCounter(0), texture(nullptr), tileMap(nullptr), circuitSystem(nullptr), lastMoveTime(std::chrono::steady_clock::now()) {
+Player::Player() : gridX(3), gridY(3), worldX(3 * TILE_SIZE), worldY(3 * TILE_SIZE), prevWorldX(3 * TILE_SIZE), prevWorldY(3 * TILE_SIZE), isMoving(false), direction(DOWN), frame(0), animTimer(0.0f), health(PLAYER_MAX_HEALTH), invulnerableFrames(0), texture(nullptr), tileMap(nullptr), circuitSystem(nullptr), simTime(0.0), lastMoveTime(-1.0) {
 }
 
 Player::~Player() {
     Shutdown();
 }
 
-bool Player::Initialize(SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load("assets/player_scifi.png");
-    if (!surface) {
-        std::cerr << "Error loading player sprite: " << IMG_GetError() << "\n";
-        return false;
-    }
-
-    // Define a cor branca do fundo como transparente (Color Key)
-    SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 255, 255));
-
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-
-    if (!texture) {
-        std::cerr << "Error creating texture: " << SDL_GetError() << "\n";
-        return false;
-    }
-
-    return true;
-}
-
 void Player::Shutdown() {
-    if (texture) {
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
-    }
+    texture = nullptr;
 }
 
 void Player::SetTexture(SDL_Texture* tex) {
@@ -54,10 +31,9 @@ void Player::SetCircuitSystem(CircuitSystem* cs) {
 }
 
 void Player::MoveUp() {
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoveTime).count() < moveDelayMs) return;
+    if ((simTime - lastMoveTime) * 1000.0 < moveDelayMs) return;
     direction = UP;
-    lastMoveTime = now;
+    lastMoveTime = simTime;
     isMoving = true; // Ativa animação
     if (tileMap && !tileMap->GetTile(gridX, gridY - 1).IsSolid()) {
         if (!circuitSystem || !circuitSystem->IsSolid(gridX, gridY - 1)) {
@@ -67,10 +43,9 @@ void Player::MoveUp() {
 }
 
 void Player::MoveDown() {
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoveTime).count() < moveDelayMs) return;
+    if ((simTime - lastMoveTime) * 1000.0 < moveDelayMs) return;
     direction = DOWN;
-    lastMoveTime = now;
+    lastMoveTime = simTime;
     isMoving = true; // Ativa animação
     if (tileMap && !tileMap->GetTile(gridX, gridY + 1).IsSolid()) {
         if (!circuitSystem || !circuitSystem->IsSolid(gridX, gridY + 1)) {
@@ -80,10 +55,9 @@ void Player::MoveDown() {
 }
 
 void Player::MoveLeft() {
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoveTime).count() < moveDelayMs) return;
+    if ((simTime - lastMoveTime) * 1000.0 < moveDelayMs) return;
     direction = LEFT;
-    lastMoveTime = now;
+    lastMoveTime = simTime;
     isMoving = true; // Ativa animação
     if (tileMap && !tileMap->GetTile(gridX - 1, gridY).IsSolid()) {
         if (!circuitSystem || !circuitSystem->IsSolid(gridX - 1, gridY)) {
@@ -93,10 +67,9 @@ void Player::MoveLeft() {
 }
 
 void Player::MoveRight() {
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoveTime).count() < moveDelayMs) return;
+    if ((simTime - lastMoveTime) * 1000.0 < moveDelayMs) return;
     direction = RIGHT;
-    lastMoveTime = now;
+    lastMoveTime = simTime;
     isMoving = true; // Ativa animação
     if (tileMap && !tileMap->GetTile(gridX + 1, gridY).IsSolid()) {
         if (!circuitSystem || !circuitSystem->IsSolid(gridX + 1, gridY)) {
@@ -113,11 +86,16 @@ bool Player::IsMoving() const {
     return isMoving;
 }
 
-void Player::Update() {
+void Player::Update(float deltaTime) {
+    simTime += deltaTime;
+    prevWorldX = worldX;
+    prevWorldY = worldY;
+
     // 1. Suavização do Movimento (Interpolação)
     float targetX = gridX * TILE_SIZE;
     float targetY = gridY * TILE_SIZE;
-    float lerpSpeed = 0.15f; // Ajuste para mais ou menos fluidez
+    // 15% por tick a 60 Hz, convertido para o deltaTime recebido
+    float lerpSpeed = 1.0f - std::pow(0.85f, deltaTime * 60.0f);
 
     worldX += (targetX - worldX) * lerpSpeed;
     worldY += (targetY - worldY) * lerpSpeed;
@@ -127,19 +105,22 @@ void Player::Update() {
 
     // 2. Lógica de Animação
     if (isMoving || effectivelyMoving) {
-        frameCounter++;
-        if (frameCounter >= 12) { // Aumentado de 8 para 12 para ser mais devagar
+        animTimer += deltaTime;
+        if (animTimer >= PLAYER_ANIM_FRAME_TIME) {
             frame = (frame + 1) % FRAMES_PER_DIRECTION;
-            frameCounter = 0;
+            animTimer -= PLAYER_ANIM_FRAME_TIME;
         }
     } else {
         frame = 0; 
-        frameCounter = 0;
+        animTimer = 0.0f;
     }
+
+    if (invulnerableFrames > 0) invulnerableFrames--;
 }
 
-void Player::Render(SDL_Renderer* renderer, int camX, int camY) {
+void Player::Render(RenderList& list, int camX, int camY, float alpha) {
     if (!texture) return;
+    if ((invulnerableFrames / 4) % 2 == 1) return; // Pisca enquanto invulnerável
 
     SDL_Rect srcRect = {
         frame * FRAME_WIDTH,
@@ -149,23 +130,54 @@ void Player::Render(SDL_Renderer* renderer, int camX, int camY) {
     };
 
     SDL_Rect destRect = {
-        (int)(worldX * SCALE) - camX,
-        (int)(worldY * SCALE) - camY,
+        (int)(GetRenderX(alpha) * SCALE) - camX,
+        (int)(GetRenderY(alpha) * SCALE) - camY,
         FRAME_WIDTH * SCALE,
         FRAME_HEIGHT * SCALE
     };
 
-    SDL_RenderCopy(renderer, texture, &srcRect, &destRect);
+    list.Copy(texture, &srcRect, &destRect);
 }
 
 int Player::GetGridX() const { return gridX; }
 int Player::GetGridY() const { return gridY; }
 float Player::GetWorldX() const { return worldX; }
 float Player::GetWorldY() const { return worldY; }
+float Player::GetRenderX(float alpha) const { return prevWorldX + (worldX - prevWorldX) * alpha; }
+float Player::GetRenderY(float alpha) const { return prevWorldY + (worldY - prevWorldY) * alpha; }
+
+bool Player::TakeDamage(int amount) {
+    if (invulnerableFrames > 0 || health <= 0) return false;
+    health -= amount;
+    if (health < 0) health = 0;
+    invulnerableFrames = PLAYER_INVULNERABLE_FRAMES;
+    return true;
+}
+
+int Player::GetHealth() const { return health; }
+
+void Player::ResetHealth() {
+    health = PLAYER_MAX_HEALTH;
+    invulnerableFrames = 0;
+}
+
+Uint64 Player::HashState(Uint64 hash) const {
+    hash = HashValue(hash, gridX);
+    hash = HashValue(hash, gridY);
+    hash = HashValue(hash, worldX);
+    hash = HashValue(hash, worldY);
+    hash = HashValue(hash, (int)direction);
+    hash = HashValue(hash, isMoving);
+    hash = HashValue(hash, health);
+    hash = HashValue(hash, invulnerableFrames);
+    return HashValue(hash, lastMoveTime);
+}
 
 void Player::SetWorldPos(int x, int y) {
     gridX = x;
     gridY = y;
     worldX = (float)(x * TILE_SIZE);
     worldY = (float)(y * TILE_SIZE);
+    prevWorldX = worldX;
+    prevWorldY = worldY;
 }
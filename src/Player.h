@@ -2,7 +2,7 @@
 #define PLAYER_H
 
 #include <SDL2/SDL.h>
-#include <chrono>
+#include "RenderList.h"
 
 class TileMap;
 class CircuitSystem;
@@ -12,6 +12,9 @@ const int TILE_SIZE = 32;
 const int FRAME_WIDTH = 32;    // 128 / 4
 const int FRAME_HEIGHT = 32;   // 128 / 4
 const int FRAMES_PER_DIRECTION = 4;
+const int PLAYER_MAX_HEALTH = 3;
+const int PLAYER_INVULNERABLE_FRAMES = 60; // Ticks de simulação: 1s piscando depois de um choque
+const float PLAYER_ANIM_FRAME_TIME = 0.2f; // Segundos por quadro da animação de andar
 
 enum Direction { DOWN = 0, LEFT = 1, RIGHT = 2, UP = 3 };
 
@@ -20,9 +23,8 @@ public:
     Player();
     ~Player();
 
-    bool Initialize(SDL_Renderer* renderer);
     void Shutdown();
-    void SetTexture(SDL_Texture* tex);
+    void SetTexture(SDL_Texture* tex); // Sprite sheet (do AssetLoader, que a libera)
     void SetTileMap(TileMap* map);
     void SetCircuitSystem(CircuitSystem* cs);
 
@@ -33,28 +35,43 @@ public:
     void SetMoving(bool moving);
     bool IsMoving() const;
 
-    void Update();
-    void Render(SDL_Renderer* renderer, int camX, int camY);
+    void Update(float deltaTime);
+    // alpha: fração entre o tick anterior e o atual (interpolação do render)
+    void Render(RenderList& list, int camX, int camY, float alpha = 1.0f);
     void SetWorldPos(int x, int y);
 
     int GetGridX() const;
     int GetGridY() const;
     float GetWorldX() const;
     float GetWorldY() const;
+    float GetRenderX(float alpha) const;
+    float GetRenderY(float alpha) const;
+
+    // Retorna false se ainda está invulnerável ao último dano
+    bool TakeDamage(int amount);
+    int GetHealth() const;
+    void ResetHealth();
+
+    Uint64 HashState(Uint64 hash) const; // Estado de simulação para o hash do replay
 
 private:
     int gridX;
     int gridY;
     float worldX;
     float worldY;
+    float prevWorldX; // Posição no tick anterior
+    float prevWorldY;
     bool isMoving;
     Direction direction;
     int frame;
-    int frameCounter;
+    float animTimer;
+    int health;
+    int invulnerableFrames;
     SDL_Texture* texture;
     TileMap* tileMap;
     CircuitSystem* circuitSystem;
-    std::chrono::steady_clock::time_point lastMoveTime;
+    double simTime;       // Relógio da simulação (segundos), avança só em Update
+    double lastMoveTime;
     int moveDelayMs = 220;
 };
 
@@ -0,0 +1,366 @@
+#include "PowerGrid.h"
+#include "TileMap.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static const int FEED_OFFSETS[5][2] = {{0, 0}, {0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+// Preenchimento Kogge-Stone: espalha 'gen' dentro das sequências de 1 de 'pro' em 6 passos
+static uint64_t FillUp(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen << 1);  pro &= pro << 1;
+    gen |= pro & (gen << 2);  pro &= pro << 2;
+    gen |= pro & (gen << 4);  pro &= pro << 4;
+    gen |= pro & (gen << 8);  pro &= pro << 8;
+    gen |= pro & (gen << 16); pro &= pro << 16;
+    gen |= pro & (gen << 32);
+    return gen;
+}
+
+// Índice do bit ligado mais baixo (bits != 0)
+static int CountTrailingZeros(uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+static uint64_t FillDown(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen >> 1);  pro &= pro >> 1;
+    gen |= pro & (gen >> 2);  pro &= pro >> 2;
+    gen |= pro & (gen >> 4);  pro &= pro >> 4;
+    gen |= pro & (gen >> 8);  pro &= pro >> 8;
+    gen |= pro & (gen >> 16); pro &= pro >> 16;
+    gen |= pro & (gen >> 32);
+    return gen;
+}
+
+PowerGrid::PowerGrid() : width(0), height(0), wordsPerRow(0), allChanged(false) {}
+
+void PowerGrid::Build(const TileMap& map) {
+    // Fontes registradas antes do mapa (ou de um mapa anterior) energizam o novo
+    std::vector<Source> carried;
+    carried.swap(outsideSources);
+    for (int y = 0; y <= height && !sourceCount.empty(); ++y) {
+        for (int x = 0; x <= width; ++x) {
+            for (int n = sourceCount[y * (width + 1) + x]; n > 0; --n) carried.push_back({x, y});
+        }
+    }
+
+    width = map.GetWidth();
+    height = map.GetHeight();
+    wordsPerRow = (width + 63) / 64;
+    conductive.assign(wordsPerRow * height, 0);
+    powered.assign(wordsPerRow * height, 0);
+    region.assign(wordsPerRow * height, 0);
+    frontier.assign(wordsPerRow * height, 0);
+    rowFlags.assign(height, 0);
+    rowQueue.clear();
+    touchedRows.clear();
+    changedBits.assign(wordsPerRow * height, 0);
+    changedWords.clear();
+    sourceCount.assign((width + 1) * (height + 1), 0);
+    sourceFeed.assign(wordsPerRow * height, 0);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (map.GetTile(x, y).IsConductive()) {
+                conductive[y * wordsPerRow + (x >> 6)] |= 1ull << (x & 63);
+            }
+        }
+    }
+
+    std::vector<Source> cells;
+    for (const Source& source : carried) {
+        if (!InSourceGrid(source.x, source.y)) {
+            outsideSources.push_back(source);
+        } else if (sourceCount[source.y * (width + 1) + source.x]++ == 0) {
+            UpdateSourceFeed(source.x, source.y);
+            cells.push_back(source);
+        }
+    }
+    for (const Source& cell : cells) RepropagateAround(cell.x, cell.y);
+    allChanged = true;
+}
+
+void PowerGrid::Clear() {
+    width = height = wordsPerRow = 0;
+    conductive.clear();
+    powered.clear();
+    region.clear();
+    frontier.clear();
+    rowQueue.clear();
+    rowFlags.clear();
+    touchedRows.clear();
+    sourceCount.clear();
+    sourceFeed.clear();
+    outsideSources.clear();
+    changedBits.clear();
+    changedWords.clear();
+    allChanged = false;
+}
+
+bool PowerGrid::TestBit(const std::vector<uint64_t>& bits, int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return false;
+    return (bits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1ull;
+}
+
+bool PowerGrid::IsPowered(int x, int y) const {
+    return TestBit(powered, x, y);
+}
+
+bool PowerGrid::IsFed(int x, int y) const {
+    for (const auto& o : FEED_OFFSETS) {
+        if (TestBit(powered, x + o[0], y + o[1])) return true;
+    }
+    return false;
+}
+
+bool PowerGrid::ConsumeChanges(std::vector<SDL_Point>& tiles, bool& all) {
+    tiles.clear();
+    all = allChanged;
+    for (int word : changedWords) {
+        uint64_t bits = changedBits[word];
+        changedBits[word] = 0;
+        if (all) continue;
+        int y = word / wordsPerRow;
+        int x0 = (word % wordsPerRow) * 64;
+        while (bits) {
+            tiles.push_back({x0 + CountTrailingZeros(bits), y});
+            bits &= bits - 1;
+        }
+    }
+    changedWords.clear();
+    allChanged = false;
+    return all || !tiles.empty();
+}
+
+void PowerGrid::MarkChanged(int word, uint64_t bits) {
+    if (!changedBits[word]) changedWords.push_back(word);
+    changedBits[word] |= bits;
+}
+
+bool PowerGrid::InSourceGrid(int x, int y) const {
+    return !sourceCount.empty() && x >= 0 && x <= width && y >= 0 && y <= height;
+}
+
+bool PowerGrid::HasSourceAt(int x, int y) const {
+    return InSourceGrid(x, y) && sourceCount[y * (width + 1) + x] > 0;
+}
+
+void PowerGrid::UpdateSourceFeed(int x, int y) {
+    // Os deslocamentos são simétricos: o tile t é alimentado se alguma célula t + o tem fonte
+    for (const auto& o : FEED_OFFSETS) {
+        int tx = x + o[0];
+        int ty = y + o[1];
+        if (tx < 0 || tx >= width || ty < 0 || ty >= height) continue;
+        bool fed = false;
+        for (const auto& n : FEED_OFFSETS) fed = fed || HasSourceAt(tx + n[0], ty + n[1]);
+        uint64_t bit = 1ull << (tx & 63);
+        uint64_t& word = sourceFeed[ty * wordsPerRow + (tx >> 6)];
+        word = fed ? (word | bit) : (word & ~bit);
+    }
+}
+
+void PowerGrid::SetSource(int x, int y, bool active) {
+    if (x < 0 || y < 0) return;
+    if (!InSourceGrid(x, y)) {
+        // Não alimenta nenhum tile deste mapa; só precisa sobreviver até o próximo Build
+        if (active) {
+            outsideSources.push_back({x, y});
+            return;
+        }
+        auto it = std::find_if(outsideSources.begin(), outsideSources.end(),
+                               [x, y](const Source& s) { return s.x == x && s.y == y; });
+        if (it == outsideSources.end()) return;
+        *it = outsideSources.back();
+        outsideSources.pop_back();
+        return;
+    }
+
+    // Outra fonte na mesma célula mantém tudo como está
+    Uint16& count = sourceCount[y * (width + 1) + x];
+    if (active) {
+        if (count++ > 0) return;
+        UpdateSourceFeed(x, y);
+        // Se os tiles alimentados já estão energizados, a nova fonte não muda nada
+        bool alreadyFed = true;
+        for (const auto& o : FEED_OFFSETS) {
+            if (TestBit(conductive, x + o[0], y + o[1]) && !TestBit(powered, x + o[0], y + o[1])) alreadyFed = false;
+        }
+        if (alreadyFed) return;
+    } else {
+        if (count == 0 || --count > 0) return;
+        UpdateSourceFeed(x, y);
+    }
+    RepropagateAround(x, y);
+}
+
+void PowerGrid::SetConductive(int x, int y, bool isConductive) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    if (TestBit(conductive, x, y) == isConductive) return;
+
+    uint64_t bit = 1ull << (x & 63);
+    int word = y * wordsPerRow + (x >> 6);
+    if (isConductive) {
+        conductive[word] |= bit;
+        Repropagate(x, y); // Pode ter unido regiões: refaz a região inteira a partir do tile novo
+    } else {
+        conductive[word] &= ~bit;
+        if (powered[word] & bit) {
+            powered[word] &= ~bit;
+            MarkChanged(word, bit);
+        }
+        RepropagateAround(x, y); // Remoção pode ter dividido a região em até 4 partes
+    }
+}
+
+void PowerGrid::RepropagateAround(int x, int y) {
+    // Cada vizinho condutivo pertence a uma região; vizinhos na mesma região são refeitos uma vez só
+    bool done[5] = {false, false, false, false, false};
+    for (int k = 0; k < 5; ++k) {
+        if (done[k]) continue;
+        int fx = x + FEED_OFFSETS[k][0];
+        int fy = y + FEED_OFFSETS[k][1];
+        if (!TestBit(conductive, fx, fy)) continue;
+        Repropagate(fx, fy);
+        for (int m = k + 1; m < 5; ++m) {
+            if (TestBit(region, x + FEED_OFFSETS[m][0], y + FEED_OFFSETS[m][1])) done[m] = true;
+        }
+    }
+}
+
+void PowerGrid::Repropagate(int x, int y) {
+    ClearRegion();
+    FloodRegion(x, y);
+    bool on = RegionHasSource();
+
+    for (int row : touchedRows) {
+        uint64_t* p = &powered[row * wordsPerRow];
+        const uint64_t* r = &region[row * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t next = on ? (p[w] | r[w]) : (p[w] & ~r[w]);
+            if (next != p[w]) {
+                MarkChanged(row * wordsPerRow + w, next ^ p[w]);
+                p[w] = next;
+            }
+        }
+    }
+}
+
+void PowerGrid::ClearRegion() {
+    for (int row : touchedRows) {
+        std::fill(region.begin() + row * wordsPerRow, region.begin() + (row + 1) * wordsPerRow, 0);
+        rowFlags[row] = 0;
+    }
+    touchedRows.clear();
+}
+
+void PowerGrid::FloodRegion(int x, int y) {
+    if (!TestBit(conductive, x, y) || TestBit(region, x, y)) return;
+
+    frontier[y * wordsPerRow + (x >> 6)] |= 1ull << (x & 63);
+    rowQueue.push_back(y);
+    rowFlags[y] |= ROW_QUEUED;
+    while (!rowQueue.empty()) {
+        int row = rowQueue.back();
+        rowQueue.pop_back();
+        rowFlags[row] &= ~ROW_QUEUED;
+        FillRow(row);
+    }
+}
+
+void PowerGrid::FillRow(int y) {
+    uint64_t* f = &frontier[y * wordsPerRow];
+    const uint64_t* c = &conductive[y * wordsPerRow];
+
+    // Espalha as sementes na linha: ida propaga o carry para a palavra seguinte, volta para a anterior
+    uint64_t carry = 0;
+    for (int w = 0; w < wordsPerRow; ++w) {
+        uint64_t g = (f[w] | carry) & c[w];
+        g = FillUp(g, c[w]) | FillDown(g, c[w]);
+        f[w] = g;
+        carry = g >> 63;
+    }
+    carry = 0;
+    for (int w = wordsPerRow - 1; w >= 0; --w) {
+        uint64_t g = f[w] | ((carry << 63) & c[w]);
+        if (g != f[w]) g = FillDown(g, c[w]);
+        f[w] = g;
+        carry = g & 1ull;
+    }
+
+    // Só os bits novos na região semeiam as linhas de cima e de baixo
+    uint64_t* r = &region[y * wordsPerRow];
+    for (int w = 0; w < wordsPerRow; ++w) {
+        uint64_t fresh = f[w] & ~r[w];
+        f[w] = 0;
+        if (!fresh) continue;
+        r[w] |= fresh;
+        if (!(rowFlags[y] & ROW_TOUCHED)) {
+            rowFlags[y] |= ROW_TOUCHED;
+            touchedRows.push_back(y);
+        }
+        for (int ny = y - 1; ny <= y + 1; ny += 2) {
+            if (ny < 0 || ny >= height) continue;
+            int nw = ny * wordsPerRow + w;
+            uint64_t seeds = fresh & conductive[nw] & ~region[nw];
+            if (!seeds) continue;
+            frontier[nw] |= seeds;
+            if (!(rowFlags[ny] & ROW_QUEUED)) {
+                rowFlags[ny] |= ROW_QUEUED;
+                rowQueue.push_back(ny);
+            }
+        }
+    }
+}
+
+bool PowerGrid::RegionHasSource() const {
+    // Só as linhas da região: basta um tile dela marcado como alimentado
+    for (int row : touchedRows) {
+        const uint64_t* r = &region[row * wordsPerRow];
+        const uint64_t* f = &sourceFeed[row * wordsPerRow];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            if (r[w] & f[w]) return true;
+        }
+    }
+    return false;
+}
+
+void PowerGrid::Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const {
+    if (width == 0) return;
+    int tileSize = 32 * scale;
+    int x0 = std::max(0, camX / tileSize);
+    int y0 = std::max(0, camY / tileSize);
+    int x1 = std::min(width - 1, (camX + viewW) / tileSize);
+    int y1 = std::min(height - 1, (camY + viewH) / tileSize);
+    if (x0 > x1 || y0 > y1) return;
+
+    // Só os tiles visíveis: percorre os bits ligados de cada palavra
+    litRects.clear();
+    for (int y = y0; y <= y1; ++y) {
+        const uint64_t* p = &powered[y * wordsPerRow];
+        for (int w = x0 >> 6; w <= (x1 >> 6); ++w) {
+            uint64_t bits = p[w];
+            if (w == (x0 >> 6)) bits &= ~0ull << (x0 & 63);
+            if (w == (x1 >> 6) && (x1 & 63) != 63) bits &= (1ull << ((x1 & 63) + 1)) - 1;
+            while (bits) {
+                int x = w * 64 + CountTrailingZeros(bits);
+                bits &= bits - 1;
+                litRects.push_back({x * tileSize - camX, y * tileSize - camY, tileSize, tileSize});
+            }
+        }
+    }
+    if (litRects.empty()) return;
+
+    // Brilho aditivo pulsando sobre as trilhas energizadas
+    Uint8 glow = (Uint8)(70 + 30 * ((SDL_GetTicks() / 120) % 2));
+    list.SetDrawBlendMode(SDL_BLENDMODE_ADD);
+    list.SetDrawColor(0, glow, glow + 20, 255);
+    list.FillRects(litRects.data(), (int)litRects.size());
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+}
@@ -0,0 +1,74 @@
+#ifndef POWER_GRID_H
+#define POWER_GRID_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "RenderList.h"
+
+class TileMap;
+
+// Energia nos tiles condutivos (trilhas, junções) do TileMap.
+// Condutividade e energia são bitsets por linha; quando uma fonte muda ou um tile é editado,
+// só a região conectada afetada é refeita com flood-fill de 64 tiles por operação.
+class PowerGrid {
+public:
+    PowerGrid();
+
+    void Build(const TileMap& map);
+    void Clear();
+
+    // Uma fonte alimenta o próprio tile e os 4 vizinhos condutivos. Várias fontes podem dividir a célula
+    void SetSource(int x, int y, bool active);
+    void SetConductive(int x, int y, bool conductive);
+
+    bool IsPowered(int x, int y) const;
+    bool IsFed(int x, int y) const; // Consumidor: algum tile condutivo energizado no próprio ou vizinho
+    // Entrega (e esquece) os tiles cuja energia mudou desde a última chamada; true se houve mudança.
+    // all = true depois de Build: o mapa inteiro conta como mudado e tiles vem vazio
+    bool ConsumeChanges(std::vector<SDL_Point>& tiles, bool& all);
+
+    void Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const;
+
+private:
+    enum RowFlag : Uint8 { ROW_QUEUED = 1, ROW_TOUCHED = 2 };
+    struct Source { int x, y; };
+
+    bool TestBit(const std::vector<uint64_t>& bits, int x, int y) const;
+    bool InSourceGrid(int x, int y) const;
+    bool HasSourceAt(int x, int y) const;
+    void UpdateSourceFeed(int x, int y);
+    void Repropagate(int x, int y);
+    void RepropagateAround(int x, int y);
+    void FloodRegion(int x, int y);
+    void FillRow(int y);
+    bool RegionHasSource() const;
+    void ClearRegion();
+    void MarkChanged(int word, uint64_t bits);
+
+    int width;
+    int height;
+    int wordsPerRow;
+    std::vector<uint64_t> conductive;
+    std::vector<uint64_t> powered;
+
+    // Região do último flood (mesmo layout dos bitsets) e as linhas que ela tocou
+    std::vector<uint64_t> region;
+    std::vector<uint64_t> frontier;
+    std::vector<int> rowQueue;
+    std::vector<Uint8> rowFlags;
+    std::vector<int> touchedRows;
+
+    // Fontes ativas por célula, com uma coluna e uma linha a mais: uma fonte logo depois da borda
+    // ainda alimenta o último tile. sourceFeed (layout dos bitsets) marca os tiles alimentados
+    std::vector<Uint16> sourceCount;
+    std::vector<uint64_t> sourceFeed;
+    std::vector<Source> outsideSources; // Fora da grade (ou antes do Build): guardadas para o próximo mapa
+    mutable std::vector<SDL_Rect> litRects;
+
+    std::vector<uint64_t> changedBits; // Mesmo layout dos bitsets; palavras listadas em changedWords
+    std::vector<int> changedWords;
+    bool allChanged;
+};
+
+#endif // POWER_GRID_H
@@ -0,0 +1,238 @@
+#include "RenderList.h"
+#include <cstring>
+#include "PerfMonitor.h"
+
+RenderList::RenderList() : width(0), height(0) {}
+
+void RenderList::Reset(int w, int h) {
+    width = w;
+    height = h;
+    commands.clear();
+    rects.clear();
+    points.clear();
+    textRuns.clear();
+    text.clear();
+    pixels.clear();
+    textureTargets.clear();
+}
+
+RenderCommand& RenderList::Push(RenderOp op) {
+    commands.emplace_back();
+    RenderCommand& cmd = commands.back();
+    cmd.op = op;
+    cmd.flags = 0;
+    cmd.color = {255, 255, 255, 255};
+    cmd.first = 0;
+    cmd.count = 0;
+    cmd.src = {0, 0, 0, 0};
+    cmd.dst = {0, 0, 0, 0};
+    cmd.object = nullptr;
+    cmd.angle = 0.0f;
+    return cmd;
+}
+
+void RenderList::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    Push(RenderOp::DRAW_COLOR).color = {r, g, b, a};
+}
+
+void RenderList::SetDrawBlendMode(SDL_BlendMode mode) {
+    PerfMonitor::Count(PerfCounter::BLEND_CHANGES);
+    Push(RenderOp::BLEND_MODE).flags = (Uint8)mode;
+}
+
+void RenderList::Clear() {
+    Push(RenderOp::CLEAR);
+}
+
+void RenderList::FillRect(const SDL_Rect& rect) {
+    FillRects(&rect, 1);
+}
+
+void RenderList::FillRects(const SDL_Rect* rectArray, int count) {
+    if (count <= 0) return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::FILL_RECTS);
+    cmd.first = (int)rects.size();
+    cmd.count = count;
+    rects.insert(rects.end(), rectArray, rectArray + count);
+}
+
+void RenderList::DrawRect(const SDL_Rect& rect) {
+    DrawRects(&rect, 1);
+}
+
+void RenderList::DrawRects(const SDL_Rect* rectArray, int count) {
+    if (count <= 0) return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::DRAW_RECTS);
+    cmd.first = (int)rects.size();
+    cmd.count = count;
+    rects.insert(rects.end(), rectArray, rectArray + count);
+}
+
+void RenderList::DrawLine(int x1, int y1, int x2, int y2) {
+    SDL_Point line[2] = {{x1, y1}, {x2, y2}};
+    DrawLines(line, 2);
+}
+
+void RenderList::DrawLines(const SDL_Point* pointArray, int count) {
+    if (count <= 0) return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::DRAW_LINES);
+    cmd.first = (int)points.size();
+    cmd.count = count;
+    points.insert(points.end(), pointArray, pointArray + count);
+}
+
+void RenderList::Copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst) {
+    if (!texture) return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::COPY);
+    cmd.object = texture;
+    if (src) cmd.src = *src; else cmd.flags |= RENDER_NO_SRC;
+    if (dst) cmd.dst = *dst; else cmd.flags |= RENDER_NO_DST;
+}
+
+void RenderList::CopyEx(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst, double angle,
+                        SDL_RendererFlip flip) {
+    if (!texture) return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::COPY_EX);
+    cmd.object = texture;
+    cmd.first = (int)flip;
+    cmd.angle = (float)angle;
+    if (src) cmd.src = *src; else cmd.flags |= RENDER_NO_SRC;
+    if (dst) cmd.dst = *dst; else cmd.flags |= RENDER_NO_DST;
+}
+
+void RenderList::SetTextureColorMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b) {
+    if (!texture) return;
+    RenderCommand& cmd = Push(RenderOp::TEXTURE_COLOR_MOD);
+    cmd.object = texture;
+    cmd.color = {r, g, b, 255};
+}
+
+void RenderList::SetClipRect(const SDL_Rect* rect) {
+    RenderCommand& cmd = Push(RenderOp::CLIP_RECT);
+    if (rect) cmd.dst = *rect; else cmd.flags |= RENDER_NO_DST;
+}
+
+void RenderList::PushText(TTF_Font* font, const char* str, SDL_Color color, const SDL_Rect& dst,
+                          int align, int scale, TextStyle style, int wrapWidth) {
+    if (!font || !str || str[0] == '\0') return;
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    TextRun run;
+    run.font = font;
+    run.offset = (int)text.size();
+    run.color = color;
+    run.dst = dst;
+    run.align = (Uint8)align;
+    run.scale = (Uint8)scale;
+    run.style = style;
+    run.wrapWidth = wrapWidth;
+    text.insert(text.end(), str, str + std::strlen(str) + 1);
+
+    RenderCommand& cmd = Push(RenderOp::TEXT);
+    cmd.first = (int)textRuns.size();
+    cmd.count = 1;
+    textRuns.push_back(run);
+}
+
+void RenderList::Text(TTF_Font* font, const char* str, SDL_Color color, int x, int y,
+                      int align, int scale, TextStyle style) {
+    PushText(font, str, color, {x, y, 0, 0}, align, scale, style, 0);
+}
+
+void RenderList::TextWrapped(TTF_Font* font, const char* str, SDL_Color color, int x, int y, int wrapWidth) {
+    PushText(font, str, color, {x, y, 0, 0}, TEXT_LEFT | TEXT_TOP, 1, TextStyle::WRAPPED, wrapWidth);
+}
+
+void RenderList::TextInRect(TTF_Font* font, const char* str, SDL_Color color, const SDL_Rect& dst) {
+    PushText(font, str, color, dst, TEXT_LEFT | TEXT_TOP, 1, TextStyle::SOLID, 0);
+}
+
+void RenderList::UploadTexture(StreamTexture& texture, int texWidth, int texHeight, const SDL_Rect* region,
+                               const void* src, int pitch) {
+    int rows = region ? region->h : texHeight;
+    int rowBytes = (region ? region->w : texWidth) * 4;
+    RenderCommand& cmd = Push(RenderOp::STREAM_UPLOAD);
+    cmd.object = &texture;
+    cmd.src = {0, 0, texWidth, texHeight};
+    if (region) cmd.dst = *region; else cmd.flags |= RENDER_NO_SRC;
+
+    // Guarda só as linhas da região, compactadas (pitch = largura da região)
+    cmd.first = (int)pixels.size();
+    cmd.count = rowBytes;
+    const Uint8* row = (const Uint8*)src;
+    for (int y = 0; y < rows; ++y, row += pitch) {
+        pixels.insert(pixels.end(), row, row + rowBytes);
+    }
+}
+
+void RenderList::CopyStream(StreamTexture& texture, const SDL_Rect* src, const SDL_Rect* dst) {
+    PerfMonitor::Count(PerfCounter::DRAW_CALLS);
+    RenderCommand& cmd = Push(RenderOp::STREAM_COPY);
+    cmd.object = &texture;
+    if (src) cmd.src = *src; else cmd.flags |= RENDER_NO_SRC;
+    if (dst) cmd.dst = *dst; else cmd.flags |= RENDER_NO_DST;
+}
+
+void RenderList::CreateTexture(SDL_Surface* surface, SDL_Texture** target) {
+    RenderCommand& cmd = Push(RenderOp::CREATE_TEXTURE);
+    cmd.object = surface;
+    cmd.first = (int)textureTargets.size();
+    textureTargets.push_back(target);
+}
+
+void RenderList::CreateTexture(const void* pixelData, int texWidth, int texHeight, int pitch, SDL_Texture** target) {
+    RenderCommand& cmd = Push(RenderOp::CREATE_TEXTURE_PIXELS);
+    cmd.object = const_cast<void*>(pixelData); // Só lido pela thread de render
+    cmd.src = {0, 0, texWidth, texHeight};
+    cmd.count = pitch;
+    cmd.first = (int)textureTargets.size();
+    textureTargets.push_back(target);
+}
+
+void RenderList::DestroyTexture(SDL_Texture* texture) {
+    RenderCommand& cmd = Push(RenderOp::DESTROY_TEXTURE);
+    cmd.object = texture;
+}
+
+void RenderList::CloseFont(TTF_Font* font) {
+    RenderCommand& cmd = Push(RenderOp::CLOSE_FONT);
+    cmd.object = font;
+}
+
+bool RenderList::MeasureText(TTF_Font* font, const char* str, int* w, int* h) {
+    *w = 0;
+    *h = 0;
+    if (!font || !str) return false;
+    std::lock_guard<std::mutex> lock(FontMutex());
+    // Uma linha por '\n', como o modo WRAPPED desenha
+    std::string line;
+    int lines = 0;
+    const char* p = str;
+    while (*p) {
+        const char* end = std::strchr(p, '\n');
+        line.assign(p, end ? (size_t)(end - p) : std::strlen(p));
+        int lw = 0, lh = 0;
+        if (!line.empty() && TTF_SizeText(font, line.c_str(), &lw, &lh) != 0) return false;
+        if (lw > *w) *w = lw;
+        ++lines;
+        if (!end) break;
+        p = end + 1;
+    }
+    *h = lines > 1 ? lines * TTF_FontLineSkip(font) : TTF_FontHeight(font);
+    return true;
+}
+
+std::mutex& RenderList::FontMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+size_t RenderList::GetMemoryBytes() const {
+    return commands.capacity() * sizeof(RenderCommand) + rects.capacity() * sizeof(SDL_Rect) +
+           points.capacity() * sizeof(SDL_Point) + textRuns.capacity() * sizeof(TextRun) +
+           text.capacity() + pixels.capacity() + textureTargets.capacity() * sizeof(SDL_Texture**);
+}
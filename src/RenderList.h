@@ -0,0 +1,157 @@
+#ifndef RENDER_LIST_H
+#define RENDER_LIST_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class RenderOp : Uint8 {
+    DRAW_COLOR,
+    BLEND_MODE,
+    CLEAR,
+    FILL_RECTS,
+    DRAW_RECTS,
+    DRAW_LINES,
+    COPY,
+    COPY_EX,
+    TEXTURE_COLOR_MOD,
+    CLIP_RECT,
+    TEXT,
+    STREAM_UPLOAD,
+    STREAM_COPY,
+    CREATE_TEXTURE,
+    CREATE_TEXTURE_PIXELS,
+    DESTROY_TEXTURE,
+    CLOSE_FONT
+};
+
+// Alinhamento do texto em relação a (x, y): combinar um horizontal com um vertical
+const int TEXT_LEFT   = 0;
+const int TEXT_CENTER = 1;
+const int TEXT_RIGHT  = 2;
+const int TEXT_TOP    = 0;
+const int TEXT_MIDDLE = 4;
+const int TEXT_BOTTOM = 8;
+
+enum class TextStyle : Uint8 {
+    SOLID,    // TTF_RenderText_Solid
+    BLENDED,  // TTF_RenderText_Blended
+    WRAPPED   // TTF_RenderText_Blended_Wrapped (quebra em wrapWidth e em '\n')
+};
+
+// Textura RGBA32 alimentada por pixels da CPU. Quem desenha só guarda o objeto e grava uploads;
+// a textura é criada, redimensionada e atualizada pela thread de render (dona do renderer).
+struct StreamTexture {
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+// RenderCommand::flags dos comandos com retângulos opcionais (o ponteiro nulo do SDL)
+const Uint8 RENDER_NO_SRC = 1;   // src nulo (textura inteira); em UPLOAD, região nula
+const Uint8 RENDER_NO_DST = 2;   // dst nulo (alvo inteiro); em CLIP_RECT, recorte desligado
+
+struct RenderCommand {
+    RenderOp op;
+    Uint8 flags;       // RENDER_NO_*; em BLEND_MODE, o SDL_BlendMode
+    SDL_Color color;   // Cor de desenho ou color mod
+    int first;         // Índice no arena do comando (retângulos, pontos, textos, pixels); flip no COPY_EX
+    int count;         // Quantidade no arena; pitch no STREAM_UPLOAD
+    SDL_Rect src;
+    SDL_Rect dst;
+    void* object;      // SDL_Texture*, StreamTexture*, SDL_Surface* (CREATE_TEXTURE), pixels (CREATE_TEXTURE_PIXELS),
+                       // TTF_Font* (CLOSE_FONT)
+    float angle;
+};
+
+struct TextRun {
+    TTF_Font* font;
+    int offset;        // Início do texto em RenderList::text (terminado em '\0')
+    SDL_Color color;
+    SDL_Rect dst;      // w/h = 0: tamanho natural * scale, posicionado por align em (x, y)
+    Uint8 align;
+    Uint8 scale;
+    TextStyle style;
+    int wrapWidth;
+};
+
+// Lista de comandos de um quadro: o jogo grava o desenho com a mesma API do SDL e a RenderThread
+// executa depois, dona do renderer. Os arenas só crescem; Reset mantém a capacidade entre quadros.
+// Texturas, fontes e StreamTextures são guardadas por ponteiro e precisam viver até a execução.
+class RenderList {
+public:
+    RenderList();
+
+    void Reset(int width, int height);
+    int GetWidth() const { return width; }    // Área de desenho (substitui SDL_RenderGetViewport)
+    int GetHeight() const { return height; }
+
+    void SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    void SetDrawBlendMode(SDL_BlendMode mode);
+    void Clear();
+    void FillRect(const SDL_Rect& rect);
+    void FillRects(const SDL_Rect* rects, int count);
+    void DrawRect(const SDL_Rect& rect);
+    void DrawRects(const SDL_Rect* rects, int count);
+    void DrawLine(int x1, int y1, int x2, int y2);
+    void DrawLines(const SDL_Point* points, int count);
+    void Copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst);
+    void CopyEx(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst, double angle,
+                SDL_RendererFlip flip = SDL_FLIP_NONE);
+    void SetTextureColorMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b);
+    void SetClipRect(const SDL_Rect* rect);   // nullptr desliga o recorte
+
+    // Texto rasterizado (e guardado em cache) pela thread de render
+    void Text(TTF_Font* font, const char* str, SDL_Color color, int x, int y,
+              int align = TEXT_LEFT | TEXT_TOP, int scale = 1, TextStyle style = TextStyle::SOLID);
+    void TextWrapped(TTF_Font* font, const char* str, SDL_Color color, int x, int y, int wrapWidth);
+    void TextInRect(TTF_Font* font, const char* str, SDL_Color color, const SDL_Rect& dst);
+
+    // Copia os pixels RGBA32 (region = nullptr: textura inteira de width x height)
+    void UploadTexture(StreamTexture& texture, int texWidth, int texHeight, const SDL_Rect* region,
+                       const void* pixels, int pitch);
+    void CopyStream(StreamTexture& texture, const SDL_Rect* src, const SDL_Rect* dst);
+
+    // Cria uma textura estática a partir da superfície (liberada depois) e grava o ponteiro em
+    // *target, na thread de render; quem pediu só pode ler *target depois que a lista terminou
+    void CreateTexture(SDL_Surface* surface, SDL_Texture** target);
+    // O mesmo a partir de pixels ARGB8888 com alfa pré-multiplicado, sem cópia: os pixels (o pacote
+    // de assets mapeado) precisam viver até a execução
+    void CreateTexture(const void* pixels, int width, int height, int pitch, SDL_Texture** target);
+    // Destruídas na ordem da lista: comandos anteriores (e a lista do quadro anterior) ainda podem usá-las
+    void DestroyTexture(SDL_Texture* texture);
+    void CloseFont(TTF_Font* font);   // Também tira do cache os textos rasterizados com ela
+
+    // Medida de texto no lado da simulação; o SDL_ttf não é thread-safe, então toda chamada
+    // TTF_* feita fora da inicialização passa por FontMutex (a thread de render também)
+    static bool MeasureText(TTF_Font* font, const char* str, int* w, int* h);
+    static std::mutex& FontMutex();
+
+    const std::vector<RenderCommand>& GetCommands() const { return commands; }
+    const SDL_Rect* GetRects(int first) const { return &rects[first]; }
+    const SDL_Point* GetPoints(int first) const { return &points[first]; }
+    const TextRun& GetTextRun(int index) const { return textRuns[index]; }
+    const char* GetText(int offset) const { return &text[offset]; }
+    const Uint8* GetPixels(int offset) const { return &pixels[offset]; }
+    SDL_Texture** GetTextureTarget(int index) const { return textureTargets[index]; }
+    size_t GetMemoryBytes() const;
+
+private:
+    RenderCommand& Push(RenderOp op);
+    void PushText(TTF_Font* font, const char* str, SDL_Color color, const SDL_Rect& dst,
+                  int align, int scale, TextStyle style, int wrapWidth);
+
+    int width;
+    int height;
+    std::vector<RenderCommand> commands;
+    std::vector<SDL_Rect> rects;
+    std::vector<SDL_Point> points;
+    std::vector<TextRun> textRuns;
+    std::vector<char> text;
+    std::vector<Uint8> pixels;
+    std::vector<SDL_Texture**> textureTargets;
+};
+
+#endif // RENDER_LIST_H
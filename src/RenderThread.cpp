@@ -0,0 +1,350 @@
+#include "RenderThread.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "Trace.h"
+
+static const Uint32 TEXT_CACHE_FRAMES = 30; // Texto sem uso por meio segundo sai do cache
+
+RenderThread::RenderThread()
+    : window(nullptr), renderer(nullptr), mode(RenderThreadMode::OFF), releaseGLContext(false),
+      backIndex(0), pending(false), quit(false), pendingVSync(-1),
+      frameIndex(0), frameTextureCreates(0), frameTTFRenders(0), stats() {}
+
+RenderThread::~RenderThread() {
+    Shutdown();
+}
+
+bool RenderThread::Initialize(SDL_Window* sdlWindow, SDL_Renderer* sdlRenderer, RenderThreadMode threadMode) {
+    window = sdlWindow;
+    renderer = sdlRenderer;
+    mode = threadMode;
+    if (!renderer) return false;
+    if (mode == RenderThreadMode::OFF) {
+        std::cout << "[RENDER] Render thread off\n";
+        return true;
+    }
+
+    // O SDL torna o contexto GL atual na thread que desenha; ele precisa estar livre aqui antes
+    SDL_RendererInfo info;
+    releaseGLContext = window && SDL_GetRendererInfo(renderer, &info) == 0 && info.name &&
+                       std::strncmp(info.name, "opengl", 6) == 0;
+    if (releaseGLContext) SDL_GL_MakeCurrent(window, nullptr);
+
+    quit = false;
+    pending = false;
+    thread = std::thread(&RenderThread::ThreadMain, this);
+    std::cout << "[RENDER] Render thread " << ModeName(mode) << "\n";
+    return true;
+}
+
+void RenderThread::Shutdown() {
+    if (thread.joinable()) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return !pending; });
+            quit = true;
+        }
+        wake.notify_one();
+        thread.join();
+    } else {
+        EvictText(true);
+    }
+    renderer = nullptr;
+}
+
+RenderList& RenderThread::BeginFrame(int width, int height) {
+    // Em PIPELINED a outra lista pode estar em execução; esta já foi consumida
+    RenderList& list = lists[backIndex];
+    list.Reset(width, height);
+    return list;
+}
+
+void RenderThread::Submit() {
+    if (!thread.joinable()) {
+        if (renderer) RenderFrame(lists[backIndex]);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    {
+        TRACE_ZONE("RenderThread::WaitIdle");
+        done.wait(lock, [this] { return !pending; });
+    }
+    backIndex = 1 - backIndex;
+    pending = true;
+    wake.notify_one();
+    if (mode == RenderThreadMode::SYNC) done.wait(lock, [this] { return !pending; });
+}
+
+void RenderThread::ThreadMain() {
+    TRACE_THREAD_NAME("Render");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return pending || quit; });
+        if (!pending) break;
+        const RenderList& list = lists[1 - backIndex];
+        lock.unlock();
+        RenderFrame(list);
+        lock.lock();
+        pending = false;
+        done.notify_all();
+    }
+    lock.unlock();
+
+    // Texturas de texto são desta thread; depois o renderer volta para a thread principal
+    EvictText(true);
+    if (releaseGLContext) SDL_GL_MakeCurrent(window, nullptr);
+}
+
+void RenderThread::RenderFrame(const RenderList& list) {
+    TRACE_ZONE("RenderThread::RenderFrame");
+    Uint64 start = SDL_GetPerformanceCounter();
+    int vsync = pendingVSync.exchange(-1);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (vsync >= 0 && SDL_RenderSetVSync(renderer, vsync) != 0) {
+        std::cerr << "Warning: SDL_RenderSetVSync failed: " << SDL_GetError() << "\n";
+    }
+#else
+    (void)vsync;
+#endif
+
+    Execute(list);
+    {
+        TRACE_ZONE("SDL_RenderPresent");
+        SDL_RenderPresent(renderer);
+    }
+    EvictText(false);
+    ++frameIndex;
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.frames++;
+    stats.textureCreates += frameTextureCreates;
+    stats.ttfRenders += frameTTFRenders;
+    stats.executeTicks += SDL_GetPerformanceCounter() - start;
+    frameTextureCreates = 0;
+    frameTTFRenders = 0;
+}
+
+void RenderThread::Execute(const RenderList& list) {
+    for (const RenderCommand& cmd : list.GetCommands()) {
+        const SDL_Rect* src = (cmd.flags & RENDER_NO_SRC) ? nullptr : &cmd.src;
+        const SDL_Rect* dst = (cmd.flags & RENDER_NO_DST) ? nullptr : &cmd.dst;
+        switch (cmd.op) {
+            case RenderOp::DRAW_COLOR:
+                SDL_SetRenderDrawColor(renderer, cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+                break;
+            case RenderOp::BLEND_MODE:
+                SDL_SetRenderDrawBlendMode(renderer, (SDL_BlendMode)cmd.flags);
+                break;
+            case RenderOp::CLEAR:
+                SDL_RenderClear(renderer);
+                break;
+            case RenderOp::FILL_RECTS:
+                SDL_RenderFillRects(renderer, list.GetRects(cmd.first), cmd.count);
+                break;
+            case RenderOp::DRAW_RECTS:
+                SDL_RenderDrawRects(renderer, list.GetRects(cmd.first), cmd.count);
+                break;
+            case RenderOp::DRAW_LINES:
+                SDL_RenderDrawLines(renderer, list.GetPoints(cmd.first), cmd.count);
+                break;
+            case RenderOp::COPY:
+                SDL_RenderCopy(renderer, (SDL_Texture*)cmd.object, src, dst);
+                break;
+            case RenderOp::COPY_EX:
+                SDL_RenderCopyEx(renderer, (SDL_Texture*)cmd.object, src, dst, cmd.angle, nullptr,
+                                 (SDL_RendererFlip)cmd.first);
+                break;
+            case RenderOp::TEXTURE_COLOR_MOD:
+                SDL_SetTextureColorMod((SDL_Texture*)cmd.object, cmd.color.r, cmd.color.g, cmd.color.b);
+                break;
+            case RenderOp::CLIP_RECT:
+                SDL_RenderSetClipRect(renderer, dst);
+                break;
+            case RenderOp::TEXT:
+                DrawText(list, list.GetTextRun(cmd.first));
+                break;
+            case RenderOp::STREAM_UPLOAD:
+                UploadStream(list, cmd);
+                break;
+            case RenderOp::STREAM_COPY: {
+                const StreamTexture* stream = (const StreamTexture*)cmd.object;
+                if (stream->texture) SDL_RenderCopy(renderer, stream->texture, src, dst);
+                break;
+            }
+            case RenderOp::CREATE_TEXTURE: {
+                SDL_Surface* surface = (SDL_Surface*)cmd.object;
+                *list.GetTextureTarget(cmd.first) = SDL_CreateTextureFromSurface(renderer, surface);
+                ++frameTextureCreates;
+                SDL_FreeSurface(surface);
+                break;
+            }
+            case RenderOp::CREATE_TEXTURE_PIXELS:
+                *list.GetTextureTarget(cmd.first) = CreatePremultiplied(cmd);
+                ++frameTextureCreates;
+                break;
+            case RenderOp::DESTROY_TEXTURE:
+                SDL_DestroyTexture((SDL_Texture*)cmd.object);
+                break;
+            case RenderOp::CLOSE_FONT:
+                CloseFont((TTF_Font*)cmd.object);
+                break;
+        }
+    }
+}
+
+void RenderThread::DrawText(const RenderList& list, const TextRun& run) {
+    const char* str = list.GetText(run.offset);
+
+    // Chave: fonte, estilo, largura de quebra, cor e o próprio texto
+    textKey.assign((const char*)&run.font, sizeof(run.font));
+    textKey.push_back((char)run.style);
+    textKey.append((const char*)&run.wrapWidth, sizeof(run.wrapWidth));
+    textKey.append((const char*)&run.color, sizeof(run.color));
+    textKey.append(str);
+
+    auto it = textCache.find(textKey);
+    if (it == textCache.end()) {
+        SDL_Surface* surf = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+            switch (run.style) {
+                case TextStyle::SOLID: surf = TTF_RenderText_Solid(run.font, str, run.color); break;
+                case TextStyle::BLENDED: surf = TTF_RenderText_Blended(run.font, str, run.color); break;
+                case TextStyle::WRAPPED:
+                    surf = TTF_RenderText_Blended_Wrapped(run.font, str, run.color, (Uint32)run.wrapWidth);
+                    break;
+            }
+        }
+        ++frameTTFRenders;
+        if (!surf) return;
+        CachedText entry = {SDL_CreateTextureFromSurface(renderer, surf), surf->w, surf->h, frameIndex};
+        ++frameTextureCreates;
+        SDL_FreeSurface(surf);
+        if (!entry.texture) return;
+        it = textCache.emplace(textKey, entry).first;
+    }
+
+    CachedText& entry = it->second;
+    entry.lastUsed = frameIndex;
+    SDL_Rect dst = run.dst;
+    if (dst.w == 0 || dst.h == 0) {
+        dst.w = entry.w * run.scale;
+        dst.h = entry.h * run.scale;
+        if (run.align & TEXT_CENTER) dst.x -= dst.w / 2;
+        else if (run.align & TEXT_RIGHT) dst.x -= dst.w;
+        if (run.align & TEXT_MIDDLE) dst.y -= dst.h / 2;
+        else if (run.align & TEXT_BOTTOM) dst.y -= dst.h;
+    }
+    SDL_RenderCopy(renderer, entry.texture, nullptr, &dst);
+}
+
+void RenderThread::UploadStream(const RenderList& list, const RenderCommand& cmd) {
+    StreamTexture& stream = *(StreamTexture*)cmd.object;
+    int w = cmd.src.w;
+    int h = cmd.src.h;
+    if (stream.texture && (stream.width != w || stream.height != h)) {
+        SDL_DestroyTexture(stream.texture);
+        stream.texture = nullptr;
+    }
+    if (!stream.texture) {
+        stream.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, w, h);
+        ++frameTextureCreates;
+        if (!stream.texture) {
+            std::cerr << "Warning: Could not create stream texture " << w << "x" << h << ": " << SDL_GetError() << "\n";
+            return;
+        }
+        stream.width = w;
+        stream.height = h;
+    }
+    const SDL_Rect* region = (cmd.flags & RENDER_NO_SRC) ? nullptr : &cmd.dst;
+    SDL_UpdateTexture(stream.texture, region, list.GetPixels(cmd.first), cmd.count);
+}
+
+SDL_Texture* RenderThread::CreatePremultiplied(const RenderCommand& cmd) {
+    int w = cmd.src.w;
+    int h = cmd.src.h;
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!texture) return nullptr;
+    const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(texture, premultiplied) == 0) {
+        SDL_UpdateTexture(texture, nullptr, cmd.object, cmd.count); // Direto dos pixels do chamador
+        return texture;
+    }
+
+    // Renderer sem blend customizado (o de software): volta ao alfa comum numa cópia
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    straightPixels.resize((size_t)w * h);
+    for (int y = 0; y < h; ++y) {
+        const Uint32* src = (const Uint32*)((const Uint8*)cmd.object + (size_t)y * cmd.count);
+        Uint32* dst = &straightPixels[(size_t)y * w];
+        for (int x = 0; x < w; ++x) {
+            Uint32 pixel = src[x];
+            Uint32 a = pixel >> 24;
+            if (a == 0 || a == 255) {
+                dst[x] = pixel;
+                continue;
+            }
+            Uint32 r = std::min(255u, ((pixel >> 16) & 0xFF) * 255 / a);
+            Uint32 g = std::min(255u, ((pixel >> 8) & 0xFF) * 255 / a);
+            Uint32 b = std::min(255u, (pixel & 0xFF) * 255 / a);
+            dst[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    SDL_UpdateTexture(texture, nullptr, straightPixels.data(), w * 4);
+    return texture;
+}
+
+void RenderThread::CloseFont(TTF_Font* font) {
+    // A chave começa pelo ponteiro da fonte: outra fonte no mesmo endereço não pode achar estes textos
+    for (auto it = textCache.begin(); it != textCache.end();) {
+        if (it->first.compare(0, sizeof(font), (const char*)&font, sizeof(font)) == 0) {
+            SDL_DestroyTexture(it->second.texture);
+            it = textCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::lock_guard<std::mutex> lock(RenderList::FontMutex());
+    TTF_CloseFont(font);
+}
+
+void RenderThread::EvictText(bool all) {
+    for (auto it = textCache.begin(); it != textCache.end();) {
+        if (all || frameIndex - it->second.lastUsed > TEXT_CACHE_FRAMES) {
+            SDL_DestroyTexture(it->second.texture);
+            it = textCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RenderThread::SetVSync(bool enabled) {
+    pendingVSync = enabled ? 1 : 0;
+}
+
+RenderThreadStats RenderThread::TakeStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    RenderThreadStats taken = stats;
+    stats = RenderThreadStats();
+    return taken;
+}
+
+const char* RenderThread::ModeName(RenderThreadMode threadMode) {
+    switch (threadMode) {
+        case RenderThreadMode::OFF: return "off";
+        case RenderThreadMode::SYNC: return "sync";
+        case RenderThreadMode::PIPELINED: return "pipelined";
+    }
+    return "?";
+}
+
+bool RenderThread::ParseMode(const std::string& name, RenderThreadMode& out) {
+    for (RenderThreadMode m : {RenderThreadMode::OFF, RenderThreadMode::SYNC, RenderThreadMode::PIPELINED}) {
+        if (name == ModeName(m)) { out = m; return true; }
+    }
+    return false;
+}
@@ -0,0 +1,94 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "RenderList.h"
+
+enum class RenderThreadMode {
+    OFF,        // Sem thread: a lista é executada e apresentada na hora, na thread principal
+    SYNC,       // Thread de render, mas o Submit espera o quadro terminar (sem latência extra)
+    PIPELINED   // O quadro N é desenhado enquanto o jogo simula o N+1 (um quadro de latência)
+};
+
+// Trabalho feito na thread de render desde a última leitura (somado à HUD pela thread principal)
+struct RenderThreadStats {
+    int frames;
+    int textureCreates;
+    int ttfRenders;
+    Uint64 executeTicks;   // Contador de performance gasto executando listas e apresentando
+};
+
+// Dona do SDL_Renderer depois do Initialize: executa a RenderList do quadro anterior enquanto o
+// jogo grava a do quadro atual (double buffer). Os textos são rasterizados aqui, com cache por
+// fonte/cor/texto, e as StreamTextures são criadas e atualizadas aqui.
+class RenderThread {
+public:
+    RenderThread();
+    ~RenderThread();
+
+    // Texturas carregadas antes daqui continuam válidas; depois, só esta classe usa o renderer
+    bool Initialize(SDL_Window* window, SDL_Renderer* renderer, RenderThreadMode mode);
+    void Shutdown(); // Termina o quadro pendente, para a thread e devolve o renderer à thread principal
+
+    RenderList& BeginFrame(int width, int height); // Lista livre para gravar o quadro atual
+    void Submit();                                 // Entrega a lista gravada para desenho + present
+    void Execute(const RenderList& list);          // Só executa, sem present (benchmarks, modo OFF)
+    void SetVSync(bool enabled);                   // Aplicado antes do próximo present
+    RenderThreadStats TakeStats();
+
+    SDL_Renderer* GetRenderer() const { return renderer; }
+    RenderThreadMode GetMode() const { return mode; }
+
+    static const char* ModeName(RenderThreadMode mode);
+    static bool ParseMode(const std::string& name, RenderThreadMode& mode);
+
+private:
+    struct CachedText {
+        SDL_Texture* texture;
+        int w;
+        int h;
+        Uint32 lastUsed;
+    };
+
+    void ThreadMain();
+    void RenderFrame(const RenderList& list);
+    void DrawText(const RenderList& list, const TextRun& run);
+    void UploadStream(const RenderList& list, const RenderCommand& cmd);
+    SDL_Texture* CreatePremultiplied(const RenderCommand& cmd);
+    void CloseFont(TTF_Font* font);
+    void EvictText(bool all);
+
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    RenderThreadMode mode;
+    bool releaseGLContext;      // Renderer OpenGL: o contexto só pode estar ativo numa thread
+
+    RenderList lists[2];
+    int backIndex;              // Lista gravada pelo jogo; a outra pertence à thread de render
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool pending;               // Lista entregue e ainda não terminada
+    bool quit;
+    std::atomic<int> pendingVSync; // -1 = sem mudança
+
+    // Só a thread que executa as listas mexe daqui para baixo (stats sob statsMutex)
+    std::unordered_map<std::string, CachedText> textCache;
+    std::string textKey;
+    std::vector<Uint32> straightPixels; // Textura pré-multiplicada convertida (renderer sem blend customizado)
+    Uint32 frameIndex;
+    int frameTextureCreates;
+    int frameTTFRenders;
+    std::mutex statsMutex;
+    RenderThreadStats stats;
+};
+
+#endif // RENDER_THREAD_H
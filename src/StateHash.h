@@ -0,0 +1,26 @@
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+// FNV-1a de 64 bits sobre o estado da simulação: gravação e replay comparam um hash por quadro.
+// Floats entram pelos bits, então o hash só é comparável entre execuções do mesmo binário.
+const Uint64 STATE_HASH_SEED = 14695981039346656037ULL;
+
+inline Uint64 HashBytes(Uint64 hash, const void* data, size_t size) {
+    const Uint8* bytes = (const Uint8*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Só para tipos escalares (structs teriam bytes de padding indefinidos)
+template <typename T>
+inline Uint64 HashValue(Uint64 hash, T value) {
+    return HashBytes(hash, &value, sizeof(value));
+}
+
+#endif // STATE_HASH_H
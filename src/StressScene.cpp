@@ -0,0 +1,234 @@
+#include "StressScene.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include "TileMap.h"
+#include "InputRecorder.h"
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo vem do kernel32, sem linkar psapi
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static const int STRESS_ROOM = 32;          // Salas de 32x32 tiles separadas por paredes com passagem
+static const int STRESS_TRACK_ROW = 8;      // Trilha condutiva na linha 8 de cada faixa de 16
+static const int STRESS_WALK_TICKS = 180;   // Ticks em cada direção da serpentina
+static const char* STRESS_REPORT_FILE = "stress_report.json";
+static const char* PHASE_NAMES[] = {"walk", "storm", "dialogue"};
+
+// LCG local: a geração não depende da ordem das chamadas em tempo de jogo
+static Uint32 NextRandom(Uint32& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+StressScene::StressScene() : enabled(false), tick(0), frame(0), rngState(1) {
+    for (PhaseStats& p : phases) p.peakMemory = 0;
+}
+
+void StressScene::Enable(const StressConfig& cfg) {
+    enabled = true;
+    config = cfg;
+    config.mapSize = std::max(config.mapSize, 64);
+    rngState = config.seed;
+
+    // Falas longas o bastante para quebrar em várias linhas na caixa de diálogo
+    script.clear();
+    script.reserve(config.dialogueLines);
+    for (int i = 0; i < config.dialogueLines; ++i) {
+        script.push_back("Fala " + std::to_string(i + 1) + ": a corrente percorre o labirinto, atravessa as portas "
+                         "logicas e volta para a bateria; confira cada resistor antes de fechar o circuito.");
+    }
+}
+
+TileMap* StressScene::GenerateMap() const {
+    int size = config.mapSize;
+    Uint32 rng = config.seed * 2654435761u;
+    TileMap* map = new TileMap(size, size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            bool border = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            // Paredes entre salas, com uma passagem de 4 tiles no meio de cada lado
+            bool wallX = x % STRESS_ROOM == 0 && (y % STRESS_ROOM) / 4 != 4;
+            bool wallY = y % STRESS_ROOM == 0 && (x % STRESS_ROOM) / 4 != 4;
+            int id = (int)(NextRandom(rng) % 5);
+            if (y % 16 == STRESS_TRACK_ROW && x % STRESS_ROOM >= 4 && x % STRESS_ROOM < 28) {
+                id = CONDUCTIVE_TILE_FIRST + (int)(NextRandom(rng) % (CONDUCTIVE_TILE_LAST - CONDUCTIVE_TILE_FIRST + 1));
+            }
+            // Uma mancha de piso eletrificado com emissor em cada quarta sala
+            int roomX = x / STRESS_ROOM, roomY = y / STRESS_ROOM;
+            int localX = x % STRESS_ROOM, localY = y % STRESS_ROOM;
+            if ((roomX + roomY) % 4 == 0 && localX >= 20 && localX < 28 && localY >= 20 && localY < 28) {
+                id = (localX == 24 && localY == 24) ? HAZARD_EMITTER_TILE : HAZARD_TILE;
+            }
+            if (border || wallX || wallY) id = 16;
+            map->SetTile(x, y, id, id >= 16);
+        }
+    }
+    return map;
+}
+
+void StressScene::GenerateObjects(LevelObjects& objects) const {
+    int size = config.mapSize;
+    Uint32 rng = config.seed * 40503u + 7u;
+
+    // Elementos nas linhas logo acima e abaixo das trilhas, para alimentá-las
+    int groups = config.elements / 3;
+    objects.elements.reserve(groups * 3);
+    int slot = 0;
+    auto nextCell = [&](int& x, int& y) {
+        int perRow = size - 8;
+        int band = slot / (perRow * 2);
+        int inBand = slot % (perRow * 2);
+        y = band * 16 + STRESS_TRACK_ROW + (inBand < perRow ? -1 : 1);
+        y = 1 + y % (size - 2); // Mais elementos que vagas: volta ao topo e empilha
+        x = 4 + inBand % perRow;
+        ++slot;
+    };
+    for (int g = 0; g < groups; ++g) {
+        const CircuitType types[3] = {CircuitType::SWITCH, CircuitType::AND_GATE, CircuitType::DOOR};
+        for (int k = 0; k < 3; ++k) {
+            CircuitElement el;
+            el.type = types[k];
+            el.id = k == 0 ? 2 * g : 2 * g + 1;
+            el.isActive = false;
+            el.delayTicks = 0;
+            if (k == 1) el.inputs = g == 0 ? std::vector<int>{0} : std::vector<int>{2 * g, 2 * g - 1};
+            nextCell(el.gridX, el.gridY);
+            objects.elements.push_back(std::move(el));
+        }
+    }
+
+    // Gatilhos 3x3 que alternam switches ao entrar
+    int triggerCount = std::max(1, config.elements / 20);
+    objects.triggers.reserve(triggerCount);
+    for (int i = 0; i < triggerCount; ++i) {
+        LevelTrigger trigger;
+        TriggerZone& zone = trigger.zone;
+        zone.action = TriggerAction::TOGGLE_CIRCUIT;
+        zone.fireOn = TriggerEvent::ENTER;
+        zone.param = groups > 0 ? 2 * (int)(NextRandom(rng) % groups) : 0;
+        zone.once = false;
+        zone.enabled = true;
+        zone.showMarker = i % 8 == 0;
+        int x = 2 + (int)(NextRandom(rng) % (size - 5));
+        int y = 2 + (int)(NextRandom(rng) % (size - 5));
+        zone.markerX = x + 1;
+        zone.markerY = y + 1;
+        for (int dy = 0; dy < 3; ++dy) {
+            for (int dx = 0; dx < 3; ++dx) trigger.cells.push_back({x + dx, y + dy});
+        }
+        objects.triggers.push_back(std::move(trigger));
+    }
+
+    // Um NPC por sala com um trecho do roteiro
+    int rooms = size / STRESS_ROOM;
+    for (int ry = 0; ry < rooms; ++ry) {
+        for (int rx = 0; rx < rooms; ++rx) {
+            NpcSpawn npc;
+            npc.x = rx * STRESS_ROOM + 12;
+            npc.y = ry * STRESS_ROOM + 4;
+            npc.speaker = "NPC " + std::to_string(ry * rooms + rx);
+            for (int i = 0; i < 4 && !script.empty(); ++i) npc.lines.push_back(script[(ry * rooms + rx + i) % script.size()]);
+            objects.npcs.push_back(std::move(npc));
+        }
+    }
+
+    objects.hasSpawn = true;
+    objects.spawnX = STRESS_ROOM / 2;
+    objects.spawnY = STRESS_ROOM / 2;
+}
+
+StressPhase StressScene::GetPhase() const {
+    int phase = config.frames > 0 ? frame * (int)StressPhase::COUNT / config.frames : 0;
+    return (StressPhase)std::min(phase, (int)StressPhase::COUNT - 1);
+}
+
+Uint8 StressScene::MovementKeys() const {
+    // Serpentina: direita, baixo, esquerda, baixo...
+    static const Uint8 pattern[4] = {INPUT_KEY_RIGHT, INPUT_KEY_DOWN, INPUT_KEY_LEFT, INPUT_KEY_DOWN};
+    return pattern[(tick / STRESS_WALK_TICKS) % 4];
+}
+
+int StressScene::Random(int range) {
+    return range > 0 ? (int)(NextRandom(rngState) % (Uint32)range) : 0;
+}
+
+void StressScene::RecordFrame(double frameMs) {
+    int phase = (int)GetPhase();
+    phases[phase].frameMs.push_back((float)frameMs);
+    ++frame;
+    // Pico de memória ao fechar cada fase (o pico do processo só cresce)
+    if ((int)GetPhase() != phase || frame >= config.frames) phases[phase].peakMemory = PeakMemoryBytes();
+}
+
+size_t StressScene::PeakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (size_t)usage.ru_maxrss;          // Bytes no macOS
+#else
+    return (size_t)usage.ru_maxrss * 1024;   // KB no Linux
+#endif
+#endif
+}
+
+static float PercentileOf(std::vector<float> values, float p) {
+    if (values.empty()) return 0.0f;
+    size_t k = std::min(values.size() - 1, (size_t)(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+void StressScene::Report() const {
+    if (!enabled) return;
+    FILE* out = std::fopen(STRESS_REPORT_FILE, "w");
+    if (!out) std::cerr << "Warning: Could not write " << STRESS_REPORT_FILE << "\n";
+    if (out) {
+        std::fprintf(out, "{\n  \"config\": {\"map_size\": %d, \"elements\": %d, \"smoke_per_tick\": %d, "
+                          "\"dialogue_lines\": %d, \"frames\": %d, \"seed\": %u},\n  \"phases\": [\n",
+                     config.mapSize, config.elements, config.smokePerTick, config.dialogueLines, config.frames, config.seed);
+    }
+
+    for (int i = 0; i < (int)StressPhase::COUNT; ++i) {
+        const PhaseStats& stats = phases[i];
+        double sum = 0.0;
+        float worst = 0.0f;
+        for (float ms : stats.frameMs) {
+            sum += ms;
+            worst = std::max(worst, ms);
+        }
+        double mean = stats.frameMs.empty() ? 0.0 : sum / stats.frameMs.size();
+        float p50 = PercentileOf(stats.frameMs, 0.5f);
+        float p95 = PercentileOf(stats.frameMs, 0.95f);
+        float p99 = PercentileOf(stats.frameMs, 0.99f);
+        // Execução interrompida antes do fim da fase: mede agora
+        size_t peak = stats.peakMemory || stats.frameMs.empty() ? stats.peakMemory : PeakMemoryBytes();
+        double peakMB = peak / (1024.0 * 1024.0);
+
+        char line[192];
+        std::snprintf(line, sizeof(line), "[STRESS] %-8s %5d frames  mean %7.2f  p50 %7.2f  p95 %7.2f  p99 %7.2f  max %7.2f ms  peak %.1f MB\n",
+                      PHASE_NAMES[i], (int)stats.frameMs.size(), mean, p50, p95, p99, worst, peakMB);
+        std::cout << line;
+        if (out) {
+            std::fprintf(out, "    {\"phase\": \"%s\", \"frames\": %d, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, "
+                              "\"p99_ms\": %.3f, \"max_ms\": %.3f, \"peak_memory_mb\": %.1f}%s\n",
+                         PHASE_NAMES[i], (int)stats.frameMs.size(), mean, p50, p95, p99, worst, peakMB,
+                         i + 1 < (int)StressPhase::COUNT ? "," : "");
+        }
+    }
+
+    if (out) {
+        std::fprintf(out, "  ]\n}\n");
+        std::fclose(out);
+        std::cout << "[STRESS] Report written to " << STRESS_REPORT_FILE << "\n";
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef STRESS_SCENE_H
+#define STRESS_SCENE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "LevelLoader.h"
+
+class TileMap;
+
+struct StressConfig {
+    int mapSize = 1024;        // Mapa mapSize x mapSize
+    int elements = 12000;      // CircuitElements (grupos switch -> AND em cadeia -> porta)
+    int smokePerTick = 400;    // Partículas de fumaça por tick nas fases com tempestade
+    int dialogueLines = 200;   // Falas do roteiro da fase de diálogo
+    int frames = 1800;         // Quadros da execução inteira (usado se --frames não for dado)
+    Uint32 seed = 1;
+};
+
+enum class StressPhase {
+    WALK,     // Exploração: câmera atravessa o mapa, gatilhos e circuitos alternando
+    STORM,    // + tempestade de fumaça
+    DIALOGUE, // + roteiro longo de diálogo por cima da tempestade
+    COUNT
+};
+
+// Cena sintética muito maior que a map1.csv para medir o jogo de ponta a ponta:
+// gera o mapa e a camada de objetos, conduz o jogador e coleta a distribuição do tempo
+// de quadro e o pico de memória por fase. A execução é dividida em três fases iguais.
+class StressScene {
+public:
+    StressScene();
+
+    void Enable(const StressConfig& cfg);
+    bool IsEnabled() const { return enabled; }
+    const StressConfig& GetConfig() const { return config; }
+
+    TileMap* GenerateMap() const;
+    void GenerateObjects(LevelObjects& objects) const;
+    const std::vector<std::string>& GetScript() const { return script; }
+
+    // Chamado uma vez por tick de simulação; retorna o índice do tick
+    int NextTick() { return tick++; }
+    StressPhase GetPhase() const;
+    Uint8 MovementKeys() const;        // Setas do passeio em serpentina (bits INPUT_KEY_*)
+    int Random(int range);             // [0, range), determinístico pela semente
+
+    void RecordFrame(double frameMs);  // Tempo de CPU do quadro (até o present)
+    void Report() const;               // Log + stress_report.json
+
+    static size_t PeakMemoryBytes();
+
+private:
+    struct PhaseStats {
+        std::vector<float> frameMs;
+        size_t peakMemory;
+    };
+
+    bool enabled;
+    StressConfig config;
+    std::vector<std::string> script;
+    int tick;
+    int frame;
+    Uint32 rngState;
+    PhaseStats phases[(int)StressPhase::COUNT];
+};
+
+#endif // STRESS_SCENE_H
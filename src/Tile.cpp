@@ -4,16 +4,19 @@ Tile::Tile(int id, bool solid) : id(id), solid(solid) {}
 
 int Tile::GetId() const { return id; }
 bool Tile::IsSolid() const { return solid; }
-void Tile::Render(SDL_Renderer* renderer, SDL_Texture* tileset, int x, int y, int scale) const {
+bool Tile::IsConductive() const { return id >= CONDUCTIVE_TILE_FIRST && id <= CONDUCTIVE_TILE_LAST; }
+bool Tile::IsHazard() const { return id == HAZARD_TILE || id == HAZARD_EMITTER_TILE; }
+bool Tile::IsHazardEmitter() const { return id == HAZARD_EMITTER_TILE; }
+void Tile::Render(RenderList& list, SDL_Texture* tileset, int x, int y, int scale) const {
     SDL_Rect destRect = { x, y, 32 * scale, 32 * scale };
 
     if (!tileset) {
         // Placeholder render se a textura não estiver carregada
         if (solid)
-            SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+            list.SetDrawColor(100, 100, 100, 255);
         else
-            SDL_SetRenderDrawColor(renderer, 180, 180, 180, 255);
-        SDL_RenderFillRect(renderer, &destRect);
+            list.SetDrawColor(180, 180, 180, 255);
+        list.FillRect(destRect);
         return;
     }
 
@@ -22,5 +25,5 @@ void Tile::Render(SDL_Renderer* renderer, SDL_Texture* tileset, int x, int y, in
     int srcY = (id / 8) * 32;
     
     SDL_Rect srcRect = { srcX, srcY, 32, 32 };
-    SDL_RenderCopy(renderer, tileset, &srcRect, &destRect);
+    list.Copy(tileset, &srcRect, &destRect);
 }
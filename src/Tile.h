@@ -2,13 +2,24 @@
 #define TILE_H
 
 #include <SDL2/SDL.h>
+#include "RenderList.h"
+
+// Trilhas e junções de circuito: chão condutivo (ver PowerGrid)
+const int CONDUCTIVE_TILE_FIRST = 5;
+const int CONDUCTIVE_TILE_LAST = 7;
+// Piso eletrificado (armadilha) e o emissor que dispara os pulsos (ver HazardField)
+const int HAZARD_TILE = 8;
+const int HAZARD_EMITTER_TILE = 9;
 
 class Tile {
 public:
     Tile(int id = 0, bool solid = false);
     int GetId() const;
     bool IsSolid() const;
-    void Render(SDL_Renderer* renderer, SDL_Texture* tileset, int x, int y, int scale = 1) const;
+    bool IsConductive() const;
+    bool IsHazard() const;
+    bool IsHazardEmitter() const;
+    void Render(RenderList& list, SDL_Texture* tileset, int x, int y, int scale = 1) const;
 private:
     int id;
     bool solid;
@@ -1,7 +1,9 @@
 #include "TileMap.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include "Trace.h"
 
 TileMap::TileMap() : width(0), height(0), tilesetTexture(nullptr) {}
 
@@ -13,6 +15,7 @@ void TileMap::SetTile(int x, int y, int id, bool solid) {
 }
 
 bool TileMap::LoadFromFile(const std::string& filename) {
+    TRACE_ZONE("TileMap::LoadFromFile");
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Falha ao abrir arquivo de mapa: " << filename << "\n";
@@ -68,12 +71,19 @@ void TileMap::SetTilesetTexture(SDL_Texture* tex) {
     tilesetTexture = tex;
 }
 
-void TileMap::Render(SDL_Renderer* renderer, int camX, int camY, int scale) const {
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
+void TileMap::Render(RenderList& list, int camX, int camY, int scale) const {
+    TRACE_ZONE("TileMap::Render");
+    // Só os tiles que intersectam a tela: cada um vira um comando na lista do quadro
+    int tileSize = 32 * scale;
+    int x0 = std::max(0, camX / tileSize);
+    int y0 = std::max(0, camY / tileSize);
+    int x1 = std::min(width - 1, (camX + list.GetWidth()) / tileSize);
+    int y1 = std::min(height - 1, (camY + list.GetHeight()) / tileSize);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
             int drawX = x * 32 * scale - camX;
             int drawY = y * 32 * scale - camY;
-            tiles[y * width + x].Render(renderer, tilesetTexture, drawX, drawY, scale);
+            tiles[y * width + x].Render(list, tilesetTexture, drawX, drawY, scale);
         }
     }
 }
@@ -13,7 +13,7 @@ public:
     bool LoadFromFile(const std::string& filename);
     const Tile& GetTile(int x, int y) const;
     void SetTilesetTexture(SDL_Texture* tex);
-    void Render(SDL_Renderer* renderer, int camX, int camY, int scale = 1) const;
+    void Render(RenderList& list, int camX, int camY, int scale = 1) const;
     int GetWidth() const;
     int GetHeight() const;
 private:
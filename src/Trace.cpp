@@ -0,0 +1,137 @@
+#include "Trace.h"
+
+#ifdef CIRCUIT_TRACE
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+static const int TRACE_CHUNK_EVENTS = 8192;
+
+struct TraceEvent {
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+    double value;
+    char phase; // 'X' = zona, 'C' = contador
+};
+
+// Cada thread escreve só nos próprios blocos: sem locks no caminho quente.
+// count e next são publicados com release para o EndSession ler com acquire.
+struct TraceChunk {
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+    std::atomic<int> count{0};
+    std::atomic<TraceChunk*> next{nullptr};
+};
+
+struct TraceThread {
+    int tid;
+    std::string name;
+    TraceChunk* head;
+    TraceChunk* tail;
+    TraceThread* nextThread;
+};
+
+static std::atomic<TraceThread*> traceThreads{nullptr}; // Lista intrusiva, inserção por CAS
+static std::atomic<int> traceNextTid{1};
+static std::atomic<bool> traceRecording{false};
+static Uint64 traceStart = 0;
+static double traceFrequency = 1.0;
+static std::string traceFile;
+static thread_local TraceThread* localThread = nullptr;
+
+static TraceThread* LocalThread() {
+    if (localThread) return localThread;
+    TraceThread* t = new TraceThread();
+    t->tid = traceNextTid.fetch_add(1);
+    t->head = t->tail = new TraceChunk();
+    t->nextThread = traceThreads.load(std::memory_order_relaxed);
+    while (!traceThreads.compare_exchange_weak(t->nextThread, t, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    localThread = t;
+    return t;
+}
+
+static void Record(const TraceEvent& e) {
+    if (!traceRecording.load(std::memory_order_relaxed)) return;
+    TraceThread* t = LocalThread();
+    TraceChunk* chunk = t->tail;
+    int n = chunk->count.load(std::memory_order_relaxed);
+    if (n == TRACE_CHUNK_EVENTS) {
+        TraceChunk* fresh = new TraceChunk();
+        chunk->next.store(fresh, std::memory_order_release);
+        t->tail = chunk = fresh;
+        n = 0;
+    }
+    chunk->events[n] = e;
+    chunk->count.store(n + 1, std::memory_order_release);
+}
+
+void Trace::BeginSession(const char* filename) {
+    traceFile = filename;
+    traceFrequency = (double)SDL_GetPerformanceFrequency();
+    traceStart = SDL_GetPerformanceCounter();
+    traceRecording.store(true);
+    std::cout << "[TRACE] Recording to " << traceFile << "\n";
+}
+
+void Trace::SetThreadName(const char* name) {
+    LocalThread()->name = name;
+}
+
+void Trace::Zone(const char* name, Uint64 start, Uint64 end) {
+    Record({name, start, end, 0.0, 'X'});
+}
+
+void Trace::Counter(const char* name, double value) {
+    Uint64 now = Now();
+    Record({name, now, now, value, 'C'});
+}
+
+static double TraceMicros(Uint64 ticks) {
+    return ticks < traceStart ? 0.0 : (ticks - traceStart) * 1000000.0 / traceFrequency;
+}
+
+void Trace::EndSession() {
+    if (!traceRecording.exchange(false)) return;
+
+    FILE* out = std::fopen(traceFile.c_str(), "w");
+    if (!out) {
+        std::cerr << "Warning: Could not write trace file " << traceFile << "\n";
+        return;
+    }
+
+    // Os blocos não são liberados: uma zona atrasada de outra thread ainda pode estar gravando
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    size_t total = 0;
+    for (TraceThread* t = traceThreads.load(std::memory_order_acquire); t; t = t->nextThread) {
+        if (!t->name.empty()) {
+            std::fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                         first ? "" : ",\n", t->tid, t->name.c_str());
+            first = false;
+        }
+        for (TraceChunk* c = t->head; c; c = c->next.load(std::memory_order_acquire)) {
+            int n = c->count.load(std::memory_order_acquire);
+            for (int i = 0; i < n; ++i) {
+                const TraceEvent& e = c->events[i];
+                if (e.phase == 'X') {
+                    std::fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                                 first ? "" : ",\n", e.name, t->tid, TraceMicros(e.start),
+                                 (e.end - e.start) * 1000000.0 / traceFrequency);
+                } else {
+                    std::fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+                                 first ? "" : ",\n", e.name, t->tid, TraceMicros(e.start), e.value);
+                }
+                first = false;
+            }
+            total += n;
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    std::fclose(out);
+    std::cout << "[TRACE] Wrote " << total << " events to " << traceFile << "\n";
+}
+
+#endif // CIRCUIT_TRACE
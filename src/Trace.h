@@ -0,0 +1,54 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Perfil em linha do tempo no formato Chrome trace-event (abrir em ui.perfetto.dev).
+// Só existe quando compilado com -DCIRCUIT_TRACE; sem a flag as macros não geram código.
+//
+//   TRACE_ZONE("TileMap::Render");        // Zona do ponto da macro até o fim do escopo
+//   TRACE_COUNTER("particles", count);    // Série numérica
+//
+// Nomes precisam ser literais: só o ponteiro é guardado.
+
+#ifdef CIRCUIT_TRACE
+
+#include <SDL2/SDL.h>
+
+class Trace {
+public:
+    static void BeginSession(const char* filename);
+    static void EndSession(); // Escreve o JSON; chamar depois que as outras threads pararam
+    static void SetThreadName(const char* name);
+
+    static void Zone(const char* name, Uint64 start, Uint64 end);
+    static void Counter(const char* name, double value);
+    static Uint64 Now() { return SDL_GetPerformanceCounter(); }
+};
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* zoneName) : name(zoneName), start(Trace::Now()) {}
+    ~TraceZone() { Trace::Zone(name, start, Trace::Now()); }
+private:
+    const char* name;
+    Uint64 start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value) Trace::Counter(name, (double)(value))
+#define TRACE_THREAD_NAME(name) Trace::SetThreadName(name)
+#define TRACE_BEGIN_SESSION(filename) Trace::BeginSession(filename)
+#define TRACE_END_SESSION() Trace::EndSession()
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_BEGIN_SESSION(filename) ((void)0)
+#define TRACE_END_SESSION() ((void)0)
+
+#endif // CIRCUIT_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,184 @@
+#include "TriggerSystem.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+TriggerSystem::TriggerSystem()
+    : width(0), height(0), indexDirty(false), playerX(-1), playerY(-1), pendingRead(0) {}
+
+void TriggerSystem::Initialize(int mapWidth, int mapHeight) {
+    width = mapWidth;
+    height = mapHeight;
+    indexDirty = true;
+}
+
+int TriggerSystem::AddRect(const TriggerZone& zone, int x, int y, int w, int h) {
+    TriggerZone z = zone;
+    z.cells.clear();
+    for (int cy = std::max(0, y); cy < std::min(height, y + h); ++cy) {
+        for (int cx = std::max(0, x); cx < std::min(width, x + w); ++cx) {
+            z.cells.push_back(cy * width + cx);
+        }
+    }
+    return AddZone(z);
+}
+
+int TriggerSystem::AddCells(const TriggerZone& zone, const std::vector<SDL_Point>& cells) {
+    TriggerZone z = zone;
+    z.cells.clear();
+    for (const SDL_Point& p : cells) {
+        if (p.x >= 0 && p.x < width && p.y >= 0 && p.y < height) z.cells.push_back(p.y * width + p.x);
+    }
+    return AddZone(z);
+}
+
+int TriggerSystem::AddZone(const TriggerZone& zone) {
+    if (zone.cells.empty()) {
+        std::cerr << "Warning: Trigger zone has no cells inside the map\n";
+        return -1;
+    }
+    zones.push_back(zone);
+    int id = (int)zones.size() - 1;
+    if (zone.showMarker) markerZones.push_back(id);
+    indexDirty = true;
+    return id;
+}
+
+void TriggerSystem::SetEnabled(int id, bool enabled) {
+    if (id >= 0 && id < (int)zones.size()) zones[id].enabled = enabled;
+}
+
+const TriggerZone* TriggerSystem::GetTrigger(int id) const {
+    if (id < 0 || id >= (int)zones.size()) return nullptr;
+    return &zones[id];
+}
+
+void TriggerSystem::RebuildIndex() {
+    // Contagem por célula, soma de prefixos e preenchimento (CSR)
+    cellStart.assign(width * height + 1, 0);
+    for (const TriggerZone& z : zones) {
+        for (int cell : z.cells) ++cellStart[cell + 1];
+    }
+    for (int c = 0; c < width * height; ++c) cellStart[c + 1] += cellStart[c];
+
+    cellZones.assign(cellStart.back(), 0);
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int id = 0; id < (int)zones.size(); ++id) {
+        for (int cell : zones[id].cells) cellZones[fill[cell]++] = id;
+    }
+    indexDirty = false;
+}
+
+void TriggerSystem::CellTriggers(int x, int y, const int*& begin, const int*& end) {
+    begin = end = nullptr;
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    if (indexDirty) RebuildIndex();
+    int cell = y * width + x;
+    begin = cellZones.data() + cellStart[cell];
+    end = cellZones.data() + cellStart[cell + 1];
+}
+
+void TriggerSystem::Fire(int id, TriggerEvent event) {
+    TriggerZone& zone = zones[id];
+    if (!zone.enabled) return;
+    if (zone.once && zone.fireOn == event) zone.enabled = false;
+    pending.push_back({id, event});
+}
+
+void TriggerSystem::UpdatePlayerCell(int x, int y) {
+    if (x == playerX && y == playerY) return; // Parado: nada a fazer
+
+    const int* oldBegin;
+    const int* oldEnd;
+    const int* newBegin;
+    const int* newEnd;
+    CellTriggers(playerX, playerY, oldBegin, oldEnd);
+    CellTriggers(x, y, newBegin, newEnd);
+
+    // Listas por célula são curtas: a diferença direta é mais barata que um conjunto
+    for (const int* a = oldBegin; a != oldEnd; ++a) {
+        if (std::find(newBegin, newEnd, *a) == newEnd) Fire(*a, TriggerEvent::EXIT);
+    }
+    for (const int* b = newBegin; b != newEnd; ++b) {
+        if (std::find(oldBegin, oldEnd, *b) == oldEnd) Fire(*b, TriggerEvent::ENTER);
+    }
+    playerX = x;
+    playerY = y;
+}
+
+bool TriggerSystem::Interact(int x, int y) {
+    const int* begin;
+    const int* end;
+    CellTriggers(x, y, begin, end);
+    bool handled = false;
+    for (const int* id = begin; id != end; ++id) {
+        if (!zones[*id].enabled) continue;
+        Fire(*id, TriggerEvent::INTERACT);
+        handled = true;
+    }
+    return handled;
+}
+
+bool TriggerSystem::PollEvent(TriggerFired& out) {
+    if (pendingRead >= pending.size()) {
+        pending.clear();
+        pendingRead = 0;
+        return false;
+    }
+    out = pending[pendingRead++];
+    return true;
+}
+
+void TriggerSystem::Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const {
+    int tileSize = 32 * scale;
+    Uint32 ticks = SDL_GetTicks();
+
+    for (int id : markerZones) {
+        const TriggerZone& zone = zones[id];
+        if (!zone.enabled) continue;
+        int ptDrawX = zone.markerX * tileSize - camX;
+        int ptDrawY = zone.markerY * tileSize - camY;
+        if (ptDrawX + tileSize < 0 || ptDrawX > viewW || ptDrawY + tileSize < 0 || ptDrawY - 40 > viewH) continue;
+
+        list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+
+        // Efeito visual Holográfico Sci-Fi
+        float pulse = (float)(std::sin(ticks / 150.0) * 0.5 + 0.5);
+        Uint8 alpha = (Uint8)(150 * pulse);
+
+        // 1. Base glowing circle / console outline (Ciano)
+        list.SetDrawColor(0, 255, 255, alpha);
+        for (int w = 0; w < 4; w++) {
+            SDL_Rect baseRect = {ptDrawX + 8 - w, ptDrawY + tileSize - 8 - w, tileSize - 16 + w*2, 8 + w*2};
+            list.DrawRect(baseRect);
+        }
+
+        // 2. Holograma de Ponto de Exclamação Flutuante
+        float floatY = (float)(std::sin(ticks / 200.0) * 8.0f);
+        list.SetDrawColor(255, 230, 0, 255); // Amarelo vibrante
+        int exX = ptDrawX + tileSize / 2 - 4;
+        int exY = ptDrawY - 15 + (int)floatY;
+        SDL_Rect exclamLine = {exX, exY - 20, 8, 16};
+        SDL_Rect exclamDot = {exX, exY, 8, 8};
+        list.FillRect(exclamLine);
+        list.FillRect(exclamDot);
+
+        // 3. Feixes de luz holográficos (linhas verticais subindo da base)
+        list.SetDrawColor(0, 255, 255, alpha / 3);
+        for (int i = 0; i < 5; i++) {
+            int lineX = ptDrawX + 12 + i * (tileSize - 24) / 4;
+            list.DrawLine(lineX, ptDrawY + tileSize - 10, lineX, exY + 10);
+        }
+    }
+}
+
+void TriggerSystem::Shutdown() {
+    zones.clear();
+    markerZones.clear();
+    cellStart.clear();
+    cellZones.clear();
+    pending.clear();
+    pendingRead = 0;
+    indexDirty = true;
+    playerX = playerY = -1;
+}
@@ -0,0 +1,83 @@
+#ifndef TRIGGER_SYSTEM_H
+#define TRIGGER_SYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "RenderList.h"
+
+enum class TriggerAction {
+    OPEN_PUZZLE,    // param = id do puzzle
+    START_DIALOGUE, // speaker + lines
+    TOGGLE_CIRCUIT  // param = net/id dos switches alternados
+};
+
+enum class TriggerEvent {
+    ENTER,
+    EXIT,
+    INTERACT
+};
+
+struct TriggerZone {
+    TriggerAction action;
+    TriggerEvent fireOn;     // Evento que executa a ação (ENTER ou INTERACT)
+    int param;
+    std::string speaker;
+    std::vector<std::string> lines;
+    bool once;               // Desativa depois de executar
+    bool enabled;
+    bool showMarker;         // Holograma sobre markerX/markerY
+    int markerX;
+    int markerY;
+    std::vector<int> cells;  // Células cobertas (y * largura + x), preenchido pelo Add*
+};
+
+struct TriggerFired {
+    int triggerId;
+    TriggerEvent event;
+};
+
+// Zonas de gatilho indexadas por célula. Eventos só são gerados quando a célula do
+// jogador muda (ENTER/EXIT) ou quando ele interage, então um frame parado não custa nada.
+class TriggerSystem {
+public:
+    TriggerSystem();
+
+    void Initialize(int mapWidth, int mapHeight);
+    int AddRect(const TriggerZone& zone, int x, int y, int w, int h);
+    int AddCells(const TriggerZone& zone, const std::vector<SDL_Point>& cells);
+    void Reserve(int count) { zones.reserve(zones.size() + count); }
+    void SetEnabled(int id, bool enabled);
+    const TriggerZone* GetTrigger(int id) const;
+    int GetTriggerCount() const { return (int)zones.size(); }
+
+    void UpdatePlayerCell(int x, int y);
+    bool Interact(int x, int y); // true se alguma zona ativa recebeu a interação
+    bool PollEvent(TriggerFired& out);
+
+    void Render(RenderList& list, int camX, int camY, int scale, int viewW, int viewH) const;
+    void Shutdown();
+
+private:
+    int AddZone(const TriggerZone& zone);
+    void RebuildIndex();
+    void CellTriggers(int x, int y, const int*& begin, const int*& end);
+    void Fire(int id, TriggerEvent event);
+
+    int width;
+    int height;
+    std::vector<TriggerZone> zones;
+    std::vector<int> markerZones;
+
+    // Índice CSR: zonas da célula c em cellZones[cellStart[c] .. cellStart[c + 1])
+    std::vector<int> cellStart;
+    std::vector<int> cellZones;
+    bool indexDirty;
+
+    int playerX;
+    int playerY;
+    std::vector<TriggerFired> pending;
+    size_t pendingRead;
+};
+
+#endif // TRIGGER_SYSTEM_H
@@ -1,8 +1,12 @@
 #include "VFX.h"
+#include <algorithm>
 #include <cmath>
+#include "StateHash.h"
+
+static const int VFX_PARTICLE_GRAIN = 16384; // Partículas por job; abaixo disso o job custa mais que o laço
 
 VFX::VFX()
-    : shaking(false), shakeDuration(0), shakeTimer(0), shakeIntensity(0),
+    : rngState(1), jobs(nullptr), shaking(false), shakeDuration(0), shakeTimer(0), shakeIntensity(0),
       shakeOffsetX(0), shakeOffsetY(0),
       flashing(false), flashDuration(0), flashTimer(0) {
     flashColor = {255, 255, 255, 255};
@@ -10,6 +14,30 @@ VFX::VFX()
 
 VFX::~VFX() {}
 
+void VFX::Seed(Uint32 seed) {
+    rngState = seed ? seed : 1; // xorshift não sai do zero
+}
+
+int VFX::Random(int range) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (int)(rngState % (Uint32)range);
+}
+
+Uint64 VFX::HashState(Uint64 hash) const {
+    hash = HashValue(hash, rngState);
+    hash = HashValue(hash, shakeOffsetX);
+    hash = HashValue(hash, shakeOffsetY);
+    hash = HashValue(hash, particles.size());
+    for (const SmokeParticle& p : particles) {
+        hash = HashValue(hash, p.x);
+        hash = HashValue(hash, p.y);
+        hash = HashValue(hash, p.life);
+    }
+    return hash;
+}
+
 void VFX::Update(float deltaTime) {
     // Screen Shake
     if (shaking) {
@@ -21,26 +49,31 @@ void VFX::Update(float deltaTime) {
         } else {
             float progress = shakeTimer / shakeDuration;
             float currentIntensity = shakeIntensity * progress;
-            shakeOffsetX = (int)((rand() % 100 - 50) / 50.0f * currentIntensity);
-            shakeOffsetY = (int)((rand() % 100 - 50) / 50.0f * currentIntensity);
+            shakeOffsetX = (int)((Random(100) - 50) / 50.0f * currentIntensity);
+            shakeOffsetY = (int)((Random(100) - 50) / 50.0f * currentIntensity);
         }
     }
 
-    // Smoke particles
-    for (int i = (int)particles.size() - 1; i >= 0; --i) {
-        SmokeParticle& p = particles[i];
-        p.life -= deltaTime;
-        if (p.life <= 0) {
-            particles.erase(particles.begin() + i);
-            continue;
+    // Smoke particles: cada partícula só mexe em si mesma, então os blocos rodam em paralelo;
+    // as mortas saem depois, numa passada em ordem (o resultado não depende do número de threads)
+    auto integrate = [this, deltaTime](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            SmokeParticle& p = particles[i];
+            p.life -= deltaTime;
+            if (p.life <= 0) continue;
+            p.x += p.vx * deltaTime;
+            p.y += p.vy * deltaTime;
+            p.vy -= 20.0f * deltaTime; // Sobe
+            float ratio = p.life / p.maxLife;
+            p.alpha = (Uint8)(200 * ratio);
+            p.size = (int)(6 + (1.0f - ratio) * 10);
         }
-        p.x += p.vx * deltaTime;
-        p.y += p.vy * deltaTime;
-        p.vy -= 20.0f * deltaTime; // Sobe
-        float ratio = p.life / p.maxLife;
-        p.alpha = (Uint8)(200 * ratio);
-        p.size = (int)(6 + (1.0f - ratio) * 10);
-    }
+    };
+    if (jobs) jobs->ParallelFor((int)particles.size(), VFX_PARTICLE_GRAIN, integrate);
+    else integrate(0, (int)particles.size());
+    particles.erase(std::remove_if(particles.begin(), particles.end(),
+                                   [](const SmokeParticle& p) { return p.life <= 0; }),
+                    particles.end());
 
     // Flash
     if (flashing) {
@@ -51,8 +84,8 @@ void VFX::Update(float deltaTime) {
     }
 }
 
-void VFX::Render(SDL_Renderer* renderer, int camX, int camY, int scale) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+void VFX::Render(RenderList& list, int camX, int camY, int scale) {
+    list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Smoke particles
     for (const auto& p : particles) {
@@ -60,23 +93,23 @@ void VFX::Render(SDL_Renderer* renderer, int camX, int camY, int scale) {
         int drawY = (int)(p.y * scale) - camY;
         int drawSize = p.size * scale / 2;
 
-        SDL_SetRenderDrawColor(renderer, 150, 150, 150, p.alpha);
+        list.SetDrawColor(150, 150, 150, p.alpha);
         SDL_Rect rect = {drawX - drawSize / 2, drawY - drawSize / 2, drawSize, drawSize};
-        SDL_RenderFillRect(renderer, &rect);
+        list.FillRect(rect);
 
         // Borda mais clara
-        SDL_SetRenderDrawColor(renderer, 200, 200, 200, (Uint8)(p.alpha / 2));
+        list.SetDrawColor(200, 200, 200, (Uint8)(p.alpha / 2));
         SDL_Rect rect2 = {drawX - drawSize / 2 - 1, drawY - drawSize / 2 - 1, drawSize + 2, drawSize + 2};
-        SDL_RenderDrawRect(renderer, &rect2);
+        list.DrawRect(rect2);
     }
 
     // Full-screen flash
     if (flashing) {
         float ratio = flashTimer / flashDuration;
         Uint8 a = (Uint8)(flashColor.a * ratio);
-        SDL_SetRenderDrawColor(renderer, flashColor.r, flashColor.g, flashColor.b, a);
+        list.SetDrawColor(flashColor.r, flashColor.g, flashColor.b, a);
         SDL_Rect full = {0, 0, 2000, 2000}; // Grande o suficiente
-        SDL_RenderFillRect(renderer, &full);
+        list.FillRect(full);
     }
 }
 
@@ -90,13 +123,13 @@ void VFX::TriggerScreenShake(float duration, float intensity) {
 void VFX::TriggerSmoke(int worldX, int worldY, int count) {
     for (int i = 0; i < count; ++i) {
         SmokeParticle p;
-        p.x = (float)worldX + (rand() % 20 - 10);
-        p.y = (float)worldY + (rand() % 20 - 10);
-        p.vx = (rand() % 60 - 30) * 1.0f;
-        p.vy = -(rand() % 40 + 20) * 1.0f;
-        p.maxLife = 0.8f + (rand() % 100) / 100.0f * 0.6f;
+        p.x = (float)worldX + (Random(20) - 10);
+        p.y = (float)worldY + (Random(20) - 10);
+        p.vx = (Random(60) - 30) * 1.0f;
+        p.vy = -(Random(40) + 20) * 1.0f;
+        p.maxLife = 0.8f + Random(100) / 100.0f * 0.6f;
         p.life = p.maxLife;
-        p.size = 4 + rand() % 6;
+        p.size = 4 + Random(6);
         p.alpha = 200;
         particles.push_back(p);
     }
@@ -3,7 +3,8 @@
 
 #include <SDL2/SDL.h>
 #include <vector>
-#include <cstdlib>
+#include "RenderList.h"
+#include "JobSystem.h"
 
 // Partícula de fumaça
 struct SmokeParticle {
@@ -20,8 +21,9 @@ public:
     VFX();
     ~VFX();
 
+    void SetJobSystem(JobSystem* jobSystem) { jobs = jobSystem; } // nullptr = tudo na thread atual
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer, int camX, int camY, int scale);
+    void Render(RenderList& list, int camX, int camY, int scale);
 
     // Efeitos disponíveis
     void TriggerScreenShake(float duration, float intensity);
@@ -33,8 +35,18 @@ public:
     int GetShakeOffsetY() const;
 
     bool IsFlashing() const;
+    int GetParticleCount() const { return (int)particles.size(); }
+
+    // Gerador próprio (xorshift32) em vez de rand(): a mesma semente reproduz os mesmos efeitos no replay
+    void Seed(Uint32 seed);
+    Uint64 HashState(Uint64 hash) const;
 
 private:
+    int Random(int range); // [0, range)
+
+    Uint32 rngState;
+    JobSystem* jobs;
+
     // Screen Shake
     bool shaking;
     float shakeDuration;
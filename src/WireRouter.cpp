@@ -0,0 +1,375 @@
+#include "WireRouter.h"
+#include <algorithm>
+#include <cstdlib>
+
+// Direções: 0 = cima, 1 = baixo, 2 = esquerda, 3 = direita
+static const int DIR_X[4] = {0, 0, -1, 1};
+static const int DIR_Y[4] = {-1, 1, 0, 0};
+
+// Anel 8-vizinho em sentido horário a partir do norte; as posições pares são os vizinhos diretos
+static const int RING_X[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static const int RING_Y[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+// Limite inferior de curvas até o alvo (dx, dy) saindo na direção dir, ignorando obstáculos.
+// Somado à distância Manhattan continua admissível e consistente.
+static int MinTurns(int dir, int dx, int dy) {
+    if (dx == 0 && dy == 0) return 0;
+    int ahead, side; // componente do alvo ao longo da direção e perpendicular a ela
+    if (dir < 2) { ahead = (dir == 0) ? -dy : dy; side = dx; }
+    else         { ahead = (dir == 2) ? -dx : dx; side = dy; }
+    if (side == 0) return ahead > 0 ? 0 : 2;
+    return ahead >= 0 ? 1 : 2;
+}
+
+WireRouter::WireRouter()
+    : width(0), height(0), regionsDirty(true), floodGeneration(0), generation(0), lastExpanded(0) {}
+
+void WireRouter::Resize(int width_, int height_) {
+    width = width_;
+    height = height_;
+    size_t cells = (size_t)width * height;
+
+    blocked.assign(cells, 0);
+    region.resize(cells);
+    regionsDirty = true;
+    if (floodStamp.size() < cells) {
+        floodStamp.assign(cells, 0);
+        floodOwner.resize(cells);
+        floodGeneration = 0;
+    }
+    if (stamp.size() < cells * 4) {
+        gScore.resize(cells * 4);
+        parent.resize(cells * 4);
+        stamp.assign(cells * 4, 0);
+        generation = 0;
+        floodQueue.reserve(cells);
+    }
+}
+
+void WireRouter::SetBlocked(int x, int y, bool isBlocked) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    Uint8 value = isBlocked ? 1 : 0;
+    int cell = y * width + x;
+    if (blocked[cell] == value) return;
+    blocked[cell] = value;
+    if (regionsDirty) return; // Refeitas por inteiro na próxima consulta
+    if (isBlocked) BlockCell(cell);
+    else UnblockCell(cell);
+    // Rótulos novos só crescem: passou do número de células, recomeça do zero na próxima consulta
+    if (regionSize.size() > (size_t)width * height) regionsDirty = true;
+}
+
+int WireRouter::NewRegion() {
+    regionSize.push_back(0);
+    return (int)regionSize.size() - 1;
+}
+
+void WireRouter::FloodRelabel(int seed, int from, int to) {
+    floodQueue.clear();
+    floodQueue.push_back(seed);
+    region[seed] = to;
+    for (size_t head = 0; head < floodQueue.size(); ++head) {
+        int cell = floodQueue[head];
+        int cx = cell % width;
+        int cy = cell / width;
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + DIR_X[d];
+            int ny = cy + DIR_Y[d];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+            int ncell = ny * width + nx;
+            if (region[ncell] != from) continue;
+            region[ncell] = to;
+            floodQueue.push_back(ncell);
+        }
+    }
+}
+
+void WireRouter::UnblockCell(int cell) {
+    // A célula liberada junta as regiões vizinhas: a maior fica, as outras são renomeadas
+    int cx = cell % width;
+    int cy = cell / width;
+    int best = -1;
+    for (int d = 0; d < 4; ++d) {
+        int nx = cx + DIR_X[d];
+        int ny = cy + DIR_Y[d];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        int r = region[ny * width + nx];
+        if (r >= 0 && (best < 0 || regionSize[r] > regionSize[best])) best = r;
+    }
+    if (best < 0) best = NewRegion();
+    region[cell] = best;
+    regionSize[best]++;
+    for (int d = 0; d < 4; ++d) {
+        int nx = cx + DIR_X[d];
+        int ny = cy + DIR_Y[d];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        int r = region[ny * width + nx];
+        if (r < 0 || r == best) continue;
+        regionSize[best] += regionSize[r];
+        regionSize[r] = 0;
+        FloodRelabel(ny * width + nx, r, best);
+    }
+}
+
+int WireRouter::RingSeeds(int cell, int* seeds) const {
+    int cx = cell % width;
+    int cy = cell / width;
+    bool free[8];
+    int firstBlocked = -1;
+    for (int i = 0; i < 8; ++i) {
+        int nx = cx + RING_X[i];
+        int ny = cy + RING_Y[i];
+        free[i] = nx >= 0 && nx < width && ny >= 0 && ny < height && !blocked[ny * width + nx];
+        if (!free[i] && firstBlocked < 0) firstBlocked = i;
+    }
+    if (firstBlocked < 0) return 1; // Anel todo livre: os vizinhos continuam ligados em volta
+
+    // Trechos contíguos de células livres no anel; cada um liga os vizinhos diretos que contém
+    int count = 0;
+    int seed = -1;
+    for (int k = 1; k <= 8; ++k) {
+        int i = (firstBlocked + k) & 7;
+        if (!free[i]) {
+            if (seed >= 0) seeds[count++] = seed;
+            seed = -1;
+        } else if (seed < 0 && (i & 1) == 0) {
+            seed = (cy + RING_Y[i]) * width + cx + RING_X[i];
+        }
+    }
+    return count;
+}
+
+void WireRouter::BlockCell(int cell) {
+    int label = region[cell];
+    region[cell] = -1;
+    regionSize[label]--;
+
+    int seeds[4];
+    int count = RingSeeds(cell, seeds);
+    if (count < 2) return;
+
+    // Os lados podem ter se separado. Uma busca por lado, intercaladas: buscas que se encontram
+    // se unem, e um grupo que esgota sem encontrar os outros é uma região nova. O custo fica
+    // proporcional ao lado menor, não ao grid
+    if (++floodGeneration == 0) {
+        std::fill(floodStamp.begin(), floodStamp.end(), 0);
+        floodGeneration = 1;
+    }
+    int group[4];
+    size_t head[4];
+    bool closed[4] = {false, false, false, false};
+    for (int s = 0; s < count; ++s) {
+        group[s] = s;
+        head[s] = 0;
+        splitQueue[s].clear();
+        splitQueue[s].push_back(seeds[s]);
+        floodStamp[seeds[s]] = floodGeneration;
+        floodOwner[seeds[s]] = (Uint8)s;
+    }
+    auto root = [&group](int s) {
+        while (group[s] != s) s = group[s];
+        return s;
+    };
+
+    int groups = count;
+    while (groups > 1) {
+        for (int s = 0; s < count; ++s) {
+            if (closed[root(s)] || head[s] == splitQueue[s].size()) continue;
+            int cur = splitQueue[s][head[s]++];
+            int cx = cur % width;
+            int cy = cur / width;
+            for (int d = 0; d < 4; ++d) {
+                int nx = cx + DIR_X[d];
+                int ny = cy + DIR_Y[d];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                int ncell = ny * width + nx;
+                if (blocked[ncell]) continue;
+                if (floodStamp[ncell] == floodGeneration) {
+                    int a = root(s), b = root(floodOwner[ncell]);
+                    if (a != b) {
+                        group[b] = a;
+                        groups--;
+                    }
+                    continue;
+                }
+                floodStamp[ncell] = floodGeneration;
+                floodOwner[ncell] = (Uint8)s;
+                splitQueue[s].push_back(ncell);
+            }
+        }
+        if (groups <= 1) break;
+
+        // Grupo sem fronteira: componente fechada, separada do resto
+        for (int g = 0; g < count && groups > 1; ++g) {
+            if (root(g) != g || closed[g]) continue;
+            bool exhausted = true;
+            for (int s = 0; s < count; ++s) {
+                if (root(s) == g && head[s] < splitQueue[s].size()) exhausted = false;
+            }
+            if (!exhausted) continue;
+            closed[g] = true;
+            groups--;
+            int split = NewRegion();
+            for (int s = 0; s < count; ++s) {
+                if (root(s) != g) continue;
+                for (int c : splitQueue[s]) region[c] = split;
+                regionSize[split] += (int)splitQueue[s].size();
+            }
+            regionSize[label] -= regionSize[split];
+        }
+    }
+}
+
+void WireRouter::RebuildRegions() {
+    // Flood fill das células livres; células bloqueadas ficam com -1
+    std::fill(region.begin(), region.end(), -1);
+    regionSize.clear();
+    int nextRegion = 0;
+    for (int seed = 0; seed < width * height; ++seed) {
+        if (blocked[seed] || region[seed] >= 0) continue;
+        floodQueue.clear();
+        floodQueue.push_back(seed);
+        region[seed] = nextRegion;
+        for (size_t head = 0; head < floodQueue.size(); ++head) {
+            int cell = floodQueue[head];
+            int cx = cell % width;
+            int cy = cell / width;
+            for (int d = 0; d < 4; ++d) {
+                int nx = cx + DIR_X[d];
+                int ny = cy + DIR_Y[d];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                int ncell = ny * width + nx;
+                if (blocked[ncell] || region[ncell] >= 0) continue;
+                region[ncell] = nextRegion;
+                floodQueue.push_back(ncell);
+            }
+        }
+        regionSize.push_back((int)floodQueue.size());
+        nextRegion++;
+    }
+    regionsDirty = false;
+}
+
+bool WireRouter::MayConnect(int startCell, int goalCell) {
+    // Terminais bloqueados não têm região própria: valem as regiões dos vizinhos livres
+    int startRegions[5];
+    int count = 0;
+    int sx = startCell % width, sy = startCell / width;
+    int gx = goalCell % width, gy = goalCell / width;
+    if (std::abs(sx - gx) + std::abs(sy - gy) == 1) return true;
+
+    if (!blocked[startCell]) startRegions[count++] = region[startCell];
+    for (int d = 0; d < 4; ++d) {
+        int nx = sx + DIR_X[d], ny = sy + DIR_Y[d];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        int r = region[ny * width + nx];
+        if (r >= 0) startRegions[count++] = r;
+    }
+
+    auto matches = [&](int r) {
+        for (int i = 0; i < count; ++i) if (startRegions[i] == r) return true;
+        return false;
+    };
+    if (!blocked[goalCell]) return matches(region[goalCell]);
+    for (int d = 0; d < 4; ++d) {
+        int nx = gx + DIR_X[d], ny = gy + DIR_Y[d];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        int r = region[ny * width + nx];
+        if (r >= 0 && matches(r)) return true;
+    }
+    return false;
+}
+
+bool WireRouter::FindPath(int startX, int startY, int goalX, int goalY, std::vector<int>& outPath) {
+    outPath.clear();
+    lastExpanded = 0;
+
+    if (startX < 0 || startX >= width || startY < 0 || startY >= height) return false;
+    if (goalX < 0 || goalX >= width || goalY < 0 || goalY >= height) return false;
+
+    int startCell = startY * width + startX;
+    int goalCell = goalY * width + goalX;
+    if (startCell == goalCell) return false;
+
+    // Alvo inalcançável: responde sem inundar o grid inteiro
+    if (regionsDirty) RebuildRegions();
+    if (!MayConnect(startCell, goalCell)) return false;
+
+    // Nova geração invalida todos os estados sem limpar os buffers
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+    for (auto& bucket : buckets) bucket.clear();
+
+    // A origem entra com as 4 direções: o primeiro passo nunca paga curva
+    Uint32 f = (Uint32)(std::abs(goalX - startX) + std::abs(goalY - startY)) * STEP_COST;
+    int queued = 0;
+    for (int d = 0; d < 4; ++d) {
+        int s = (startCell << 2) | d;
+        stamp[s] = generation;
+        gScore[s] = 0;
+        parent[s] = -1;
+        buckets[(f / BUCKET_UNIT) % BUCKET_COUNT].push_back({0, s});
+        queued++;
+    }
+
+    int goalState = -1;
+    while (queued > 0) {
+        std::vector<Node>& bucket = buckets[(f / BUCKET_UNIT) % BUCKET_COUNT];
+        if (bucket.empty()) {
+            f += BUCKET_UNIT;
+            continue;
+        }
+        Node cur = bucket.back();
+        bucket.pop_back();
+        queued--;
+
+        // Entrada obsoleta (já achamos um caminho melhor para esse estado)
+        if (cur.g != gScore[cur.state]) continue;
+        lastExpanded++;
+
+        int cell = cur.state >> 2;
+        int dir = cur.state & 3;
+        if (cell == goalCell) {
+            goalState = cur.state;
+            break;
+        }
+
+        int cx = cell % width;
+        int cy = cell / width;
+        for (int d = 0; d < 4; ++d) {
+            int nx = cx + DIR_X[d];
+            int ny = cy + DIR_Y[d];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+            int ncell = ny * width + nx;
+            if (blocked[ncell] && ncell != goalCell) continue;
+
+            Uint32 g = cur.g + STEP_COST;
+            if (d != dir && cell != startCell) g += TURN_COST;
+
+            int ns = (ncell << 2) | d;
+            if (stamp[ns] == generation && gScore[ns] <= g) continue;
+            stamp[ns] = generation;
+            gScore[ns] = g;
+            parent[ns] = cur.state;
+
+            int dx = goalX - nx;
+            int dy = goalY - ny;
+            Uint32 h = (Uint32)(std::abs(dx) + std::abs(dy)) * STEP_COST
+                     + (Uint32)MinTurns(d, dx, dy) * TURN_COST;
+            buckets[((g + h) / BUCKET_UNIT) % BUCKET_COUNT].push_back({g, ns});
+            queued++;
+        }
+    }
+
+    if (goalState < 0) return false;
+
+    for (int s = goalState; parent[s] >= 0; s = parent[s]) {
+        outPath.push_back(s >> 2);
+    }
+    std::reverse(outPath.begin(), outPath.end());
+    return true;
+}
+
+int WireRouter::GetLastExpandedCount() const { return lastExpanded; }
@@ -0,0 +1,74 @@
+#ifndef WIRE_ROUTER_H
+#define WIRE_ROUTER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// A* sobre o grid do puzzle para traçar fios entre terminais.
+// O estado da busca é (célula, direção de entrada), o que permite penalizar curvas.
+// Todos os buffers são reaproveitados entre consultas: depois do primeiro uso
+// em um grid de um dado tamanho, FindPath não aloca memória.
+class WireRouter {
+public:
+    WireRouter();
+
+    // Redimensiona os buffers (só realoca se o grid crescer) e libera todas as células
+    void Resize(int width, int height);
+    void SetBlocked(int x, int y, bool blocked);
+
+    // Caminho de menor custo de (startX, startY) até (goalX, goalY).
+    // outPath recebe os índices (y * width + x) das células, sem a origem e com o destino.
+    // A origem e o destino podem estar bloqueados (são os terminais).
+    bool FindPath(int startX, int startY, int goalX, int goalY, std::vector<int>& outPath);
+
+    int GetLastExpandedCount() const;
+
+private:
+    static const Uint32 STEP_COST = 10;
+    static const Uint32 TURN_COST = 5;
+    // Custos são múltiplos de 5 e f cresce no máximo 35 por passo: 16 baldes circulares bastam
+    static const Uint32 BUCKET_UNIT = 5;
+    static const int BUCKET_COUNT = 16;
+
+    struct Node {
+        Uint32 g;
+        int state;
+    };
+
+    void RebuildRegions();
+    bool MayConnect(int startCell, int goalCell);
+    int NewRegion();
+    void FloodRelabel(int seed, int from, int to); // Troca o rótulo 'from' por 'to' na componente de seed
+    void BlockCell(int cell);
+    void UnblockCell(int cell);
+    int RingSeeds(int cell, int* seeds) const;     // Um vizinho livre por trecho livre do anel 8-vizinho
+
+    int width;
+    int height;
+    std::vector<Uint8> blocked;
+
+    // Componentes conexas das células livres. Refeitas inteiras só depois de Resize; colocar ou
+    // tirar uma peça atualiza os rótulos em volta da célula (uniões e, raramente, uma divisão)
+    std::vector<int> region;
+    std::vector<int> regionSize;
+    bool regionsDirty;
+
+    // Buscas intercaladas da divisão: cada uma parte de um lado da célula bloqueada
+    std::vector<int> splitQueue[4];
+    std::vector<Uint32> floodStamp;
+    std::vector<Uint8> floodOwner;
+    Uint32 floodGeneration;
+
+    // Por estado (célula * 4 + direção); válidos apenas quando stamp == generation
+    std::vector<Uint32> gScore;
+    std::vector<int> parent;
+    std::vector<Uint32> stamp;
+    Uint32 generation;
+
+    // Fila de prioridade por baldes de f (LIFO dentro do balde favorece nós mais profundos)
+    std::vector<Node> buckets[BUCKET_COUNT];
+    std::vector<int> floodQueue;
+    int lastExpanded;
+};
+
+#endif // WIRE_ROUTER_H
@@ -1,10 +1,109 @@
 #include <SDL2/SDL.h>
 #include <iostream>
+#include <string>
+#include <cstdlib>
 #include "Game.h"
+#include "BotFleet.h"
+#include "Trace.h"
 
 int main(int argc, char* argv[]) {
+    TRACE_BEGIN_SESSION("circuit_trace.json");
+    TRACE_THREAD_NAME("main");
     Game game;
-    
+
+    // --pacing=vsync|spin|uncapped (ritmo de quadros; padrão vsync), --headless, --frames=N,
+    // --render-thread=off|sync|pipelined (thread de render; padrão pipelined),
+    // --jobs=N (threads do job system contando a principal; 0 = uma por núcleo, 1 = desligado),
+    // --record=arquivo / --replay=arquivo (entrada determinística), --seed=N,
+    // --stress [--stress-size=N --stress-elements=N --stress-smoke=N --stress-dialogue=N],
+    // --bot [--bot-id=N --bot-level=N --bot-report=arquivo] (um jogador automático),
+    // --bots=N [--bot-jobs=N] (N bots headless em paralelo, relatório em bot_report.json),
+    // --build-pack=arquivo (grava o pacote de assets pré-decodificados e sai)
+    bool stress = false;
+    StressConfig stressConfig;
+    bool bot = false;
+    BotConfig botConfig;
+    BotFleetConfig fleetConfig;
+    int fleetBots = 0;
+    std::string packFile;
+    int frames = 0;
+    Uint32 seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--pacing=", 0) == 0) {
+            PacingMode mode;
+            if (FramePacer::ParseMode(arg.substr(9), mode)) game.SetPacingMode(mode);
+            else std::cerr << "Warning: Unknown pacing mode " << arg.substr(9) << "\n";
+        } else if (arg.rfind("--render-thread=", 0) == 0) {
+            RenderThreadMode mode;
+            if (RenderThread::ParseMode(arg.substr(16), mode)) game.SetRenderThreadMode(mode);
+            else std::cerr << "Warning: Unknown render thread mode " << arg.substr(16) << "\n";
+        } else if (arg.rfind("--jobs=", 0) == 0) {
+            game.SetJobThreads(std::atoi(arg.c_str() + 7));
+        } else if (arg == "--headless") {
+            game.SetHeadless(true);
+        } else if (arg.rfind("--frames=", 0) == 0) {
+            frames = std::atoi(arg.c_str() + 9);
+            game.SetFrameLimit(frames);
+        } else if (arg.rfind("--record=", 0) == 0) {
+            game.SetRecordFile(arg.substr(9));
+        } else if (arg.rfind("--replay=", 0) == 0) {
+            game.SetReplayFile(arg.substr(9));
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            seed = (Uint32)std::strtoul(arg.c_str() + 7, nullptr, 10);
+            game.SetRandomSeed(seed);
+        } else if (arg == "--stress") {
+            stress = true;
+        } else if (arg.rfind("--stress-size=", 0) == 0) {
+            stress = true;
+            stressConfig.mapSize = std::atoi(arg.c_str() + 14);
+        } else if (arg.rfind("--stress-elements=", 0) == 0) {
+            stress = true;
+            stressConfig.elements = std::atoi(arg.c_str() + 18);
+        } else if (arg.rfind("--stress-smoke=", 0) == 0) {
+            stress = true;
+            stressConfig.smokePerTick = std::atoi(arg.c_str() + 15);
+        } else if (arg.rfind("--stress-dialogue=", 0) == 0) {
+            stress = true;
+            stressConfig.dialogueLines = std::atoi(arg.c_str() + 18);
+        } else if (arg == "--bot") {
+            bot = true;
+        } else if (arg.rfind("--bot-id=", 0) == 0) {
+            botConfig.id = std::atoi(arg.c_str() + 9);
+        } else if (arg.rfind("--bot-level=", 0) == 0) {
+            botConfig.level = std::atoi(arg.c_str() + 12);
+            fleetConfig.level = botConfig.level;
+        } else if (arg.rfind("--bot-report=", 0) == 0) {
+            botConfig.reportFile = arg.substr(13);
+        } else if (arg.rfind("--bots=", 0) == 0) {
+            fleetBots = std::atoi(arg.c_str() + 7);
+        } else if (arg.rfind("--bot-jobs=", 0) == 0) {
+            fleetConfig.jobs = std::atoi(arg.c_str() + 11);
+        } else if (arg.rfind("--build-pack=", 0) == 0) {
+            packFile = arg.substr(13);
+        }
+    }
+    if (stress) game.SetStressConfig(stressConfig);
+    if (bot) game.SetBotConfig(botConfig);
+
+    if (!packFile.empty()) {
+        bool built = Game::BuildAssetPack(packFile);
+        TRACE_END_SESSION();
+        return built ? 0 : 1;
+    }
+
+    if (fleetBots > 0) {
+        // Supervisor: não abre janela, só lança e espera os processos dos bots
+        fleetConfig.bots = fleetBots;
+        fleetConfig.seed = seed;
+        if (frames > 0) fleetConfig.frames = frames;
+        BotFleet fleet;
+        fleet.Configure(fleetConfig);
+        int failed = fleet.Run(argv[0]);
+        TRACE_END_SESSION();
+        return failed > 0 ? 3 : 0;
+    }
+
     if (!game.Initialize()) {
         std::cerr << "Failed to initialize game\n";
         return 1;
@@ -12,6 +111,7 @@ int main(int argc, char* argv[]) {
 
     game.Run();
     game.Shutdown();
+    TRACE_END_SESSION();
 
-    return 0;
+    return game.ReplayDiverged() ? 2 : 0; // Replay como teste de regressão: falha se o estado divergiu
 }